@@ -38,6 +38,7 @@
 #include "arts_omp.h"
 #include "auto_md.h"
 #include "global_data.h"
+#include "profiler.h"
 
 
 //! Appends methods to an agenda
@@ -195,6 +196,7 @@ void Agenda::execute(Workspace& ws) const
   averbosity.set_main_agenda(is_main_agenda());
   
   ArtsOut1 aout1(averbosity);
+  ProfilerScope agenda_scope(mname, true);
   {
     //    ostringstream os;  // disabled for performance reasons
     //    os << "Executing " << name() << "\n"
@@ -247,6 +249,7 @@ void Agenda::execute(Workspace& ws) const
           }
 
           // Call the getaway function:
+          ProfilerScope method_scope(mdd.Name(), false);
           getaways[mrr.Id()](ws, mrr);
 
         }
@@ -9,7 +9,10 @@
 #ifndef agenda_wrapper_h
 #define agenda_wrapper_h
 
+#include <algorithm>
+#include <functional>
 #include "oem.h"
+#include "xml_io.h"
 
 //! Wrapper class for forward model.
 /*!
@@ -55,9 +58,90 @@ public:
         reuse_jacobian((jacobian_.nrows() != 0) &&
                         (jacobian_.ncols() != 0) &&
                        (yi_.nelem() != 0)),
-        iteration_counter(0)
+        iteration_counter(0),
+        broyden(false), have_previous(false),
+        checkpoint_file(""), history(nullptr), verbosity(nullptr),
+        oem_iteration(-1), cost_history()
         {}
 
+//! Select Broyden updates of the Jacobian.
+/*!
+  If set, the Jacobian is only calculated by the agenda the first time it is
+  requested (or not at all, if a precomputed Jacobian was provided). For
+  later iterations, only the forward model is evaluated and the Jacobian
+  is updated using Broyden's rank-one formula.
+
+  A precomputed Jacobian can stem from a previous scene. Only the Jacobian
+  is then kept, the forward model is always evaluated at the start state.
+
+  \param b Flag to activate Broyden updates.
+*/
+    void set_broyden(bool b) { broyden = b; }
+
+//! Activate checkpoint output.
+/*!
+  After each Jacobian evaluation, the current state, fitted measurement
+  vector, Jacobian and gamma history are written to XML files, with names
+  formed by appending ".x.xml", ".yf.xml", ".jacobian.xml" and
+  ".lm_ga_history.xml" to the given basename. The number of the OEM
+  iteration the state belongs to and the cost of all iterations so far are
+  written to ".iteration.xml" and ".cost_history.xml", see
+  set_checkpoint_cost(). For Levenberg-Marquardt, the present gamma factor
+  is also written, see set_checkpoint_ga().
+
+  \param filename Basename of the checkpoint files. No output if empty.
+  \param history_ Pointer to the gamma history vector of the OEM.
+  \param verbosity_ Pointer to verbosity object used for the file output.
+*/
+    void set_checkpoint(const String & filename,
+                        const Vector * history_,
+                        const Verbosity * verbosity_)
+    {
+        checkpoint_file = filename;
+        history         = history_;
+        verbosity       = verbosity_;
+    }
+
+//! Set source of the gamma factor for checkpoint output.
+/*!
+  The value returned by ga_ is written to the file with ".lm_ga.xml"
+  appended to the checkpoint basename, so that a resumed inversion can
+  continue with the gamma factor of the last completed iteration.
+
+  \param ga_ Function returning the present gamma factor of the LM method.
+*/
+    void set_checkpoint_ga(std::function<Numeric()> ga_)
+    {
+        ga = ga_;
+    }
+
+//! Set cost function for checkpoint output.
+/*!
+  The value returned by cost_ for the state and fitted measurement vector
+  of each Jacobian evaluation is added to the cost history.
+
+  \param cost_ Function returning the cost for given x and yf.
+*/
+    void set_checkpoint_cost(
+        std::function<Numeric(ConstVectorView, ConstVectorView)> cost_)
+    {
+        cost = cost_;
+    }
+
+//! Continue the checkpoint output of an earlier inversion.
+/*!
+  The iteration numbers written to the checkpoint files continue from
+  the given iteration, and the given cost history is extended.
+
+  \param iteration_ The iteration of the state the inversion resumes from.
+  \param cost_history_ Cost history of the earlier inversion.
+*/
+    void set_checkpoint_resume(Index iteration_, const Vector & cost_history_)
+    {
+        oem_iteration = iteration_ - 1;
+        cost_history  = cost_history_;
+    }
+
     AgendaWrapper(const AgendaWrapper &) = delete;
     AgendaWrapper(      AgendaWrapper &&) = delete;
     AgendaWrapper& operator=(const AgendaWrapper &)  = delete;
@@ -79,16 +163,50 @@ public:
     OEMMatrixReference Jacobian(const OEMVector & xi,
                                 OEMVector & yi_)
     {
-        if (!reuse_jacobian)
+        if (reuse_jacobian)
+        {
+            reuse_jacobian = false;
+            if (broyden)
+            {
+                // The Jacobian may be from the previous scene, yi must
+                // match xi for the first step and the first Broyden update.
+                Matrix dummy;
+                inversion_iterate_agendaExecute(
+                    *ws, yi, dummy, xi, 0, iteration_counter,
+                    *inversion_iterate_agenda);
+                iteration_counter += 1;
+            }
+            yi_ = yi;
+        }
+        else if (broyden && have_previous)
         {
+            Matrix dummy;
             inversion_iterate_agendaExecute(
-                *ws, yi, jacobian, xi, 1, 0,
+                *ws, yi, dummy, xi, 0, iteration_counter,
                 *inversion_iterate_agenda);
+            broyden_update(xi);
             yi_ = yi;
             iteration_counter += 1;
-        } else {
-            reuse_jacobian = false;
+        }
+        else
+        {
+            inversion_iterate_agendaExecute(
+                *ws, yi, jacobian, xi, 1, 0,
+                *inversion_iterate_agenda);
             yi_ = yi;
+            iteration_counter += 1;
+        }
+
+        if (broyden)
+        {
+            x_previous    = xi;
+            y_previous    = yi;
+            have_previous = true;
+        }
+        oem_iteration += 1;
+        if (checkpoint_file.nelem())
+        {
+            write_checkpoint(xi);
         }
         return jacobian;
     }
@@ -104,7 +222,7 @@ public:
 */
     OEMVector evaluate(const OEMVector &xi)
     {
-        if (!reuse_jacobian)
+        if (!reuse_jacobian || broyden)
         {
             Matrix dummy;
             inversion_iterate_agendaExecute(
@@ -118,11 +236,94 @@ public:
 
 private:
 
+//! Broyden update of the Jacobian.
+/*!
+  Applies K += (dy - K dx) dx^T / (dx^T dx), where dx and dy are the changes
+  of state and measurement vector since the last Jacobian evaluation.
+
+  \param[in] xi The current state vector, with yi holding the matching
+  forward model output.
+*/
+    void broyden_update(const OEMVector & xi)
+    {
+        Matrix & K = jacobian;
+        const Index nx = xi.nelem();
+
+        Vector dx(nx), dy(yi.nelem());
+        for (Index i = 0; i < nx; i++)
+            dx[i] = xi[i] - x_previous[i];
+        for (Index i = 0; i < dy.nelem(); i++)
+            dy[i] = yi[i] - y_previous[i];
+
+        const Numeric dx2 = dx * dx;
+        if (dx2 == 0)
+            return;
+
+        Vector Kdx(dy.nelem());
+        mult(Kdx, K, dx);
+        dy -= Kdx;
+        dy /= dx2;
+
+        for (Index i = 0; i < K.nrows(); i++)
+            for (Index j = 0; j < nx; j++)
+                K(i,j) += dy[i] * dx[j];
+    }
+
+//! Write checkpoint files.
+/*!
+  \param[in] xi The state vector matching the present Jacobian.
+*/
+    void write_checkpoint(const OEMVector & xi)
+    {
+        const Matrix & K = jacobian;
+        const Vector   x = xi;
+        const Vector   y = yi;
+
+        // The cost history holds one element per iteration up to the
+        // present one. Elements beyond are left from an earlier run that
+        // was resumed from an earlier checkpoint.
+        Vector c(oem_iteration + 1, NAN);
+        for (Index i = 0; i < std::min(oem_iteration, cost_history.nelem()); i++)
+            c[i] = cost_history[i];
+        if (cost)
+            c[oem_iteration] = cost(x, y);
+        cost_history = c;
+
+        xml_write_to_file(checkpoint_file + ".x.xml", x,
+                          FILE_TYPE_BINARY, 0, *verbosity);
+        xml_write_to_file(checkpoint_file + ".yf.xml", y,
+                          FILE_TYPE_BINARY, 0, *verbosity);
+        xml_write_to_file(checkpoint_file + ".jacobian.xml", K,
+                          FILE_TYPE_BINARY, 0, *verbosity);
+        if (history)
+            xml_write_to_file(checkpoint_file + ".lm_ga_history.xml", *history,
+                              FILE_TYPE_BINARY, 0, *verbosity);
+        if (ga)
+            xml_write_to_file(checkpoint_file + ".lm_ga.xml", ga(),
+                              FILE_TYPE_BINARY, 0, *verbosity);
+        xml_write_to_file(checkpoint_file + ".cost_history.xml", cost_history,
+                          FILE_TYPE_BINARY, 0, *verbosity);
+        xml_write_to_file(checkpoint_file + ".iteration.xml", oem_iteration,
+                          FILE_TYPE_BINARY, 0, *verbosity);
+    }
+
     Workspace    * ws;
     const Agenda * inversion_iterate_agenda;
     bool           reuse_jacobian;
     unsigned int   iteration_counter;
 
+    bool           broyden, have_previous;
+    Vector         x_previous, y_previous;
+
+    String         checkpoint_file;
+    const Vector    * history;
+    const Verbosity * verbosity;
+    std::function<Numeric()> ga;
+    std::function<Numeric(ConstVectorView, ConstVectorView)> cost;
+
+    Index          oem_iteration;
+    Vector         cost_history;
+
 };
 
 #endif // agenda_wrappers_h
@@ -1,6 +1,7 @@
 #include "agenda_class.h"
 #include "arts.h"
 #include "arts_api.h"
+#include "arts_server.h"
 #include "auto_md.h"
 #include "auto_version.h"
 #include "global_data.h"
@@ -43,6 +44,36 @@ void copy_output_and_input(ArrayOfIndex &output,
     }
 }
 
+//! Describe a C-contiguous array by a VariableViewStruct.
+void set_contiguous_view(VariableViewStruct &view,
+                         Numeric *data,
+                         long ndim,
+                         const long *shape)
+{
+    view = VariableViewStruct{};
+    view.ptr  = data;
+    view.ndim = ndim;
+    long stride = sizeof(Numeric);
+    for (long i = ndim - 1; i >= 0; --i) {
+        view.shape[i]   = shape[i];
+        view.strides[i] = stride;
+        stride *= shape[i];
+    }
+}
+
+//! Number of dimensions of the matpack groups, 0 for all other groups.
+long matpack_dimensions(const String &group)
+{
+    if (group == "Vector")  return 1;
+    if (group == "Matrix")  return 2;
+    if (group == "Tensor3") return 3;
+    if (group == "Tensor4") return 4;
+    if (group == "Tensor5") return 5;
+    if (group == "Tensor6") return 6;
+    if (group == "Tensor7") return 7;
+    return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // Setup and Finalization.
 ////////////////////////////////////////////////////////////////////////////
@@ -218,6 +249,20 @@ void destroy_workspace(InteractiveWorkspace* workspace)
     delete workspace;
 }
 
+const char * run_server(InteractiveWorkspace *workspace,
+                        const char *socket_path,
+                        long n_workers)
+{
+    try {
+        ArtsServer server(*workspace, socket_path, n_workers);
+        server.run();
+    } catch (const std::runtime_error &e) {
+        string_buffer = e.what();
+        return string_buffer.c_str();
+    }
+    return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // Accessing WSV Group Information
 ////////////////////////////////////////////////////////////////////////////
@@ -550,6 +595,9 @@ const char * set_variable_value(InteractiveWorkspace *workspace,
                                 long group_id,
                                 VariableValueStruct value)
 {
+    // Never copy into a buffer owned by the caller.
+    workspace->release_external_variable(id, false);
+
     // Agenda
     if (wsv_group_names[group_id] == "Agenda") {
         const Agenda *ptr = reinterpret_cast<const Agenda *>(value.ptr);
@@ -663,6 +711,120 @@ const char * set_variable_value(InteractiveWorkspace *workspace,
     return nullptr;
 }
 
+const char * get_variable_view(InteractiveWorkspace *workspace,
+                               long id,
+                               long group_id,
+                               VariableViewStruct *view)
+{
+    const String &group = wsv_group_names[group_id];
+    if (!workspace->is_initialized(id)) {
+        string_buffer = "Variable " + Workspace::wsv_data[id].Name()
+                        + " is uninitialized.";
+        return string_buffer.c_str();
+    }
+
+    void *wsv = workspace->operator[](id);
+
+    // The dimensions are the same as for get_variable_value.
+    VariableValueStruct value = get_variable_value(workspace, id, group_id);
+    const long ndim = matpack_dimensions(group);
+    if (ndim > 0) {
+        Numeric *data = nullptr;
+        switch (ndim) {
+        case 1: data = reinterpret_cast<Vector*>(wsv)->get_c_array(); break;
+        case 2: data = reinterpret_cast<Matrix*>(wsv)->get_c_array(); break;
+        case 3: data = reinterpret_cast<Tensor3*>(wsv)->get_c_array(); break;
+        case 4: data = reinterpret_cast<Tensor4*>(wsv)->get_c_array(); break;
+        case 5: data = reinterpret_cast<Tensor5*>(wsv)->get_c_array(); break;
+        case 6: data = reinterpret_cast<Tensor6*>(wsv)->get_c_array(); break;
+        case 7: data = reinterpret_cast<Tensor7*>(wsv)->get_c_array(); break;
+        }
+        set_contiguous_view(*view, data, ndim, value.dimensions);
+    } else if (group == "Sparse") {
+        Sparse *m = reinterpret_cast<Sparse*>(wsv);
+        // Elements inserted with rw() leave gaps between the rows.
+        m->make_compressed();
+        *view = VariableViewStruct{};
+        view->ptr       = m->get_element_pointer();
+        view->ndim      = 2;
+        view->shape[0]  = m->nrows();
+        view->shape[1]  = m->ncols();
+        view->nnz       = m->nnz();
+        view->inner_ptr = m->get_column_index_pointer();
+        view->outer_ptr = m->get_row_start_pointer();
+    } else {
+        string_buffer = "Variables of group " + group
+                        + " cannot be accessed through views.";
+        return string_buffer.c_str();
+    }
+    return nullptr;
+}
+
+bool variable_view_is_valid(InteractiveWorkspace *workspace,
+                            long id,
+                            long group_id,
+                            const VariableViewStruct *view)
+{
+    if (!workspace->is_initialized(id)) return false;
+
+    VariableViewStruct current;
+    if (get_variable_view(workspace, id, group_id, &current)) return false;
+
+    if (current.ptr != view->ptr || current.ndim != view->ndim
+        || current.nnz != view->nnz || current.inner_ptr != view->inner_ptr
+        || current.outer_ptr != view->outer_ptr) {
+        return false;
+    }
+    for (long i = 0; i < current.ndim; ++i) {
+        if (current.shape[i] != view->shape[i]) return false;
+    }
+    return true;
+}
+
+const char * set_variable_view(InteractiveWorkspace *workspace,
+                               long id,
+                               long group_id,
+                               VariableViewStruct view)
+{
+    const String &group = wsv_group_names[group_id];
+    const long ndim = matpack_dimensions(group);
+
+    if (ndim > 0) {
+        VariableViewStruct contiguous;
+        set_contiguous_view(contiguous, nullptr, ndim, view.shape);
+        if (view.ndim != ndim) {
+            string_buffer = "Number of dimensions does not match group "
+                            + group + ".";
+            return string_buffer.c_str();
+        }
+        for (long i = 0; i < ndim; ++i) {
+            if (view.shape[i] > 1 && view.strides[i] != contiguous.strides[i]) {
+                string_buffer = "Only C-contiguous buffers can be used "
+                                "without copying.";
+                return string_buffer.c_str();
+            }
+        }
+        workspace->set_external_variable(id, group_id, view.shape,
+                                         reinterpret_cast<Numeric*>(view.ptr));
+    } else if (group == "Sparse") {
+        workspace->release_external_variable(id, false);
+        Sparse *m = reinterpret_cast<Sparse*>(workspace->operator[](id));
+        *m = Sparse(view.shape[0], view.shape[1]);
+        m->insert_elements_csr(view.nnz, view.outer_ptr, view.inner_ptr,
+                               reinterpret_cast<const Numeric*>(view.ptr));
+    } else {
+        string_buffer = "Variables of group " + group
+                        + " cannot be set through views.";
+        return string_buffer.c_str();
+    }
+    return nullptr;
+}
+
+void release_variable_view(InteractiveWorkspace *workspace, long id)
+{
+    workspace->release_external_variable(id, true);
+}
+
 long add_variable(InteractiveWorkspace *workspace, long group_id, const char *name)
 {
     return workspace->add_variable(group_id, name);
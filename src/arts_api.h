@@ -92,6 +92,45 @@ extern "C" {
 
     };
 
+    /** @struct VariableViewStruct
+     * This struct is used to exchange the data of Vector, Matrix, Tensor3-7
+     * and Sparse variables without copying it.
+     */
+    struct VariableViewStruct {
+        /** @var VariableViewStruct::ptr
+         * Pointer to the first element of the data. For sparse matrices this
+         * points to the array of non-zero elements.
+         */
+        void        *ptr;
+        /** @var VariableViewStruct::ndim
+         * Number of dimensions of the variable.
+         */
+        long        ndim;
+        /** @var VariableViewStruct::shape
+         * The number of elements along each of the first ndim dimensions.
+         */
+        long        shape[7];
+        /** @var VariableViewStruct::strides
+         * The distance in bytes between consecutive elements along each of
+         * the first ndim dimensions. Not used for sparse matrices.
+         */
+        long        strides[7];
+        /** @var VariableViewStruct::nnz
+         * Number of non-zero elements of a sparse matrix.
+         */
+        long        nnz;
+        /** @var VariableViewStruct::inner_ptr
+         * For sparse matrices the array of the nnz column indices in
+         * compressed sparse row (CSR) format.
+         */
+        int         *inner_ptr;
+        /** @var VariableViewStruct::outer_ptr
+         * For sparse matrices the array of the shape[0] + 1 row start
+         * indices in compressed sparse row (CSR) format.
+         */
+        int         *outer_ptr;
+    };
+
     /** @struct MethodStruct
      * This struct is used to return the a description of a workspace method.
      */
@@ -397,6 +436,28 @@ extern "C" {
     DLL_PUBLIC
     void destroy_workspace(InteractiveWorkspace* workspace);
 
+    //! Serve workspaces over a local socket.
+    /**
+     * Starts a server that keeps the data in the given workspace loaded and
+     * creates workspaces for clients connecting to a Unix domain socket. All
+     * client workspaces share the variables of the given workspace, which
+     * must not be modified while the server is running. The call returns
+     * when a client sends the shutdown command. See arts_server.h for the
+     * protocol.
+     *
+     * \param workspace Pointer to the InteractiveWorkspace holding the shared data.
+     * \param socket_path Path of the socket to create.
+     * \param n_workers Number of controlfiles that are executed concurrently.
+     *        More than one is only safe if the setup in the given workspace
+     *        has already run the calculations once, see arts_server.h.
+     * \return NULL if the server was shut down regularly, otherwise pointer to
+     *         the c_str holding the error message.
+     */
+    DLL_PUBLIC
+    const char * run_server(InteractiveWorkspace *workspace,
+                            const char *socket_path,
+                            long n_workers);
+
     ////////////////////////////////////////////////////////////////////////////
     // Accessing WSV Group Information
     ////////////////////////////////////////////////////////////////////////////
@@ -561,6 +622,79 @@ extern "C" {
                                     long id,
                                     long group_id,
                                     VariableValueStruct value);
+    //! Get view of the data of a WSV.
+    /**
+     * Provides direct access to the data of a Vector, Matrix, Tensor3-7 or
+     * Sparse variable without copying it. The data can be modified through
+     * the view. The view remains valid until the variable is modified by a
+     * workspace method or agenda, set with set_variable_value or
+     * set_variable_view, or erased. Use variable_view_is_valid to check
+     * this.
+     *
+     * \param workspace Pointer to a InteractiveWorkspace object.
+     * \param id Index of the workspace variable.
+     * \param group_id Index of the group the variable belongs to.
+     * \param view Pointer to the VariableViewStruct to fill.
+     * \return NULL on success, otherwise pointer to the c_str holding the
+     *         error message.
+     */
+    DLL_PUBLIC
+    const char * get_variable_view(InteractiveWorkspace *workspace,
+                                   long id,
+                                   long group_id,
+                                   VariableViewStruct *view);
+
+    //! Check if a view of a WSV is still valid.
+    /**
+     * \param workspace Pointer to a InteractiveWorkspace object.
+     * \param id Index of the workspace variable.
+     * \param group_id Index of the group the variable belongs to.
+     * \param view Pointer to a view returned by get_variable_view.
+     * \return true if the view still refers to the data of the variable.
+     */
+    DLL_PUBLIC
+    bool variable_view_is_valid(InteractiveWorkspace *workspace,
+                                long id,
+                                long group_id,
+                                const VariableViewStruct *view);
+
+    //! Set WSV to externally owned data.
+    /**
+     * Lets a Vector, Matrix or Tensor3-7 variable use the given buffer
+     * without copying it. The buffer must be C-contiguous. It remains owned
+     * by the caller and ARTS never writes to it or frees it: The variable is
+     * replaced by a copy before a workspace method or agenda modifies it.
+     * The buffer must stay valid until then, or until
+     * release_variable_view is called or the workspace is destroyed.
+     *
+     * Sparse variables cannot use external memory. They are set from the
+     * CSR arrays given by ptr, inner_ptr and outer_ptr with a single copy.
+     *
+     * \param workspace Pointer to a InteractiveWorkspace object.
+     * \param id Index of the workspace variable.
+     * \param group_id Index of the group the variable belongs to.
+     * \param view VariableViewStruct describing the buffer.
+     * \return NULL on success, otherwise pointer to the c_str holding the
+     *         error message.
+     */
+    DLL_PUBLIC
+    const char * set_variable_view(InteractiveWorkspace *workspace,
+                                   long id,
+                                   long group_id,
+                                   VariableViewStruct view);
+
+    //! Release externally owned data.
+    /**
+     * After this call the variable holds a copy of the data of the buffer
+     * passed to set_variable_view and the buffer can be freed. Does nothing
+     * if the variable does not use an external buffer.
+     *
+     * \param workspace Pointer to a InteractiveWorkspace object.
+     * \param id Index of the workspace variable.
+     */
+    DLL_PUBLIC
+    void release_variable_view(InteractiveWorkspace *workspace, long id);
+
     //! Add variable of given type to workspace.
     /**
      * This adds and initializes a variable in the current workspace and also
@@ -0,0 +1,614 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   arts_benchmark.cc
+
+  \brief  Benchmarks for the performance critical parts of ARTS.
+
+  Most cases are controlfiles in the benchmarks directory. A case
+  controlfile prepares the workspace and sets forloop_agenda to the
+  calculation that shall be timed, e.g. a single call of ppathCalc. The
+  setup is not timed. Cases that can not be expressed as controlfile
+  are implemented directly in this file.
+
+  Each case is first executed once to warm up caches. Then the number of
+  executions per sample is chosen so that a sample takes at least
+  min_sample_time seconds, and the given number of samples is timed.
+  The result is reported as time per execution and as throughput in a
+  case specific unit of work (e.g. line evaluations or path points).
+
+  Cases that need data files that are not available are reported as
+  skipped. The results are written as JSON or CSV, so that they can be
+  compared between revisions.
+
+  Usage: arts_benchmark [-I includepath] [-D datapath] [-c case]
+                        [-n numthreads] [-s samples] [-f json|csv]
+                        [-o outfile] [-l]
+*/
+
+#include "arts.h"
+
+#include <getopt.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "absorption.h"
+#include "agenda_record.h"
+#include "arts_omp.h"
+#include "auto_md.h"
+#include "auto_version.h"
+#include "file.h"
+#include "global_data.h"
+#include "methods.h"
+#include "parameters.h"
+#include "parser.h"
+#include "propagationmatrix.h"
+#include "wsv_aux.h"
+
+extern Parameters parameters;
+extern Verbosity verbosity_at_launch;
+
+//! Minimum duration of one timed sample in seconds.
+static const Numeric min_sample_time = 0.1;
+
+
+//! Timing results of one benchmark case.
+struct BenchmarkResult
+{
+  String name;
+  String status;
+  String message;
+  Numeric setup;
+  Index executions;
+  Numeric min;
+  Numeric median;
+  Numeric mean;
+  Numeric stddev;
+  Numeric work;
+  String unit;
+};
+
+
+//! A benchmark case.
+/*!
+  Controlfile cases have a controlfile, native cases a run function that
+  executes the timed calculation once.
+*/
+struct BenchmarkCase
+{
+  //! Name of the case in the output.
+  String name;
+  //! Controlfile setting up the workspace, searched in the include path.
+  String controlfile;
+  //! Directories with input files, relative to the include path.
+  ArrayOfString searchpaths;
+  //! Files that must exist to run the case.
+  ArrayOfString requires;
+  //! Unit of work, used for the throughput.
+  String unit;
+  //! Amount of work done by a single execution.
+  /*! Computed from the workspace after the setup. Variables set by
+      forloop_agenda are not kept after its execution. */
+  std::function<Numeric(Workspace&)> work;
+  //! Timed calculation of native cases.
+  std::function<void()> run;
+};
+
+
+//! Return a workspace variable by name.
+template <class T>
+static const T& wsv(Workspace& ws, const String& name)
+{
+  return *(const T*)ws[get_wsv_id(name)];
+}
+
+
+//! Wall clock time in seconds.
+static Numeric now()
+{
+  using namespace std::chrono;
+  return duration<Numeric>(steady_clock::now().time_since_epoch()).count();
+}
+
+
+//! Time a calculation.
+/*!
+  \param[in,out] result  Timing results
+  \param[in]     run     Executes the calculation the given number of times
+  \param[in]     nsamples Number of timed samples
+*/
+static void time_calculation(BenchmarkResult& result,
+                             const std::function<void(Index)>& run,
+                             Index nsamples)
+{
+  // Warm-up, also gives a first estimate of the duration:
+  Numeric t0 = now();
+  run(1);
+  Numeric t = now() - t0;
+
+  Index n = 1;
+  if (t < min_sample_time)
+    n = std::min((Index)1000000,
+                 (Index)ceil(min_sample_time / std::max(t, 1e-9)));
+
+  std::vector<Numeric> samples;
+  for (Index i = 0; i < nsamples; i++)
+    {
+      t0 = now();
+      run(n);
+      samples.push_back((now() - t0) / (Numeric)n);
+    }
+
+  std::sort(samples.begin(), samples.end());
+  const size_t ns = samples.size();
+
+  result.executions = n * nsamples;
+  result.min = samples[0];
+  result.median = ns % 2 ? samples[ns / 2]
+                         : 0.5 * (samples[ns / 2 - 1] + samples[ns / 2]);
+  result.mean = 0;
+  for (size_t i = 0; i < ns; i++) result.mean += samples[i];
+  result.mean /= (Numeric)ns;
+  result.stddev = 0;
+  for (size_t i = 0; i < ns; i++)
+    result.stddev += (samples[i] - result.mean) * (samples[i] - result.mean);
+  result.stddev = ns > 1 ? sqrt(result.stddev / (Numeric)(ns - 1)) : 0;
+}
+
+
+//! Run a benchmark case.
+/*!
+  \param bc        The case
+  \param nsamples  Number of timed samples
+  \param verbosity Verbosity
+
+  \return The timing results
+*/
+static BenchmarkResult run_case(const BenchmarkCase& bc,
+                                Index nsamples,
+                                const Verbosity& verbosity)
+{
+  BenchmarkResult result;
+  result.name = bc.name;
+  result.status = "ok";
+  result.setup = 0;
+  result.executions = 0;
+  result.min = result.median = result.mean = result.stddev = 0;
+  result.work = 0;
+  result.unit = bc.unit;
+
+  // Variables created by the controlfile are removed after the case,
+  // so that the next case can create them again.
+  const ArrayOfString includepath = parameters.includepath;
+  const Array<WsvRecord> wsv_data = Workspace::wsv_data;
+  const map<String, Index> wsv_map = Workspace::WsvMap;
+
+  try
+    {
+      // Input files are searched for relative to the include path.
+      for (Index i = 0; i < includepath.nelem(); i++)
+        for (Index j = 0; j < bc.searchpaths.nelem(); j++)
+          parameters.includepath.push_back(includepath[i] + "/"
+                                           + bc.searchpaths[j]);
+
+      for (Index i = 0; i < bc.requires.nelem(); i++)
+        {
+          String filename = bc.requires[i];
+          try
+            {
+              find_xml_file(filename, verbosity);
+            }
+          catch (const std::runtime_error&)
+            {
+              result.status = "skipped";
+              result.message = "Missing input file: " + bc.requires[i];
+              break;
+            }
+        }
+
+      if (result.status != "ok")
+        ;
+      else if (bc.run)
+        {
+          time_calculation(result, [&bc](Index n) {
+              for (Index i = 0; i < n; i++) bc.run();
+            }, nsamples);
+          Workspace ws;
+          result.work = bc.work ? bc.work(ws) : 1;
+        }
+      else
+        {
+          ArrayOfString matches;
+          if (!find_file(matches, bc.controlfile, includepath))
+            {
+              ostringstream os;
+              os << "Cannot find controlfile: " << bc.controlfile << "\n"
+                 << "Search path: " << includepath;
+              throw runtime_error(os.str());
+            }
+
+          Numeric t0 = now();
+
+          Agenda tasklist;
+          Workspace ws;
+          ArtsParser parser(tasklist, matches[0], verbosity);
+          parser.parse_tasklist();
+          tasklist.set_name("Arts");
+          tasklist.set_main_agenda();
+          ws.initialize();
+          Arts2(ws, tasklist, verbosity);
+
+          result.setup = now() - t0;
+
+          const Agenda& body = wsv<Agenda>(ws, "forloop_agenda");
+          Index index = 0;
+          time_calculation(result, [&ws, &body, &index](Index n) {
+              for (Index i = 0; i < n; i++)
+                forloop_agendaExecute(ws, index++, body);
+            }, nsamples);
+
+          result.work = bc.work ? bc.work(ws) : 1;
+        }
+    }
+  catch (const std::runtime_error& x)
+    {
+      result.status = "failed";
+      result.message = x.what();
+    }
+
+  parameters.includepath = includepath;
+  Workspace::wsv_data = wsv_data;
+  Workspace::WsvMap = wsv_map;
+  return result;
+}
+
+
+//! Propagation matrices for the transmission benchmarks.
+/*!
+  \param nf        Number of frequencies
+  \param stokes_dim Stokes dimension
+  \param scale     Scaling of the elements
+*/
+static PropagationMatrix benchmark_propmat(Index nf, Index stokes_dim,
+                                           Numeric scale)
+{
+  PropagationMatrix pm(nf, stokes_dim);
+  Tensor4View data = pm.GetData();
+  for (Index i = 0; i < nf; i++)
+    for (Index j = 0; j < data.ncols(); j++)
+      data(0, 0, i, j) = scale * (1e-5 + 1e-6 * (Numeric)j)
+                         * (1 + sin(1e-2 * (Numeric)i));
+  return pm;
+}
+
+
+//! Define all benchmark cases.
+static std::vector<BenchmarkCase> define_cases()
+{
+  std::vector<BenchmarkCase> cases;
+  BenchmarkCase bc;
+
+  bc = BenchmarkCase();
+  bc.name = "xsec_species2";
+  bc.controlfile = "lbl_xsec.arts";
+  bc.unit = "line evaluations";
+  bc.work = [](Workspace& ws) {
+    const ArrayOfArrayOfLineRecord& lines =
+      wsv<ArrayOfArrayOfLineRecord>(ws, "abs_lines_per_species");
+    Index nlines = 0;
+    for (Index i = 0; i < lines.nelem(); i++) nlines += lines[i].nelem();
+    return (Numeric)(nlines * wsv<Vector>(ws, "f_grid").nelem()
+                     * wsv<Vector>(ws, "abs_p").nelem());
+  };
+  cases.push_back(bc);
+
+  bc = BenchmarkCase();
+  bc.name = "lookup_extract";
+  bc.controlfile = "lookup_extract.arts";
+  bc.unit = "frequencies";
+  bc.work = [](Workspace& ws) {
+    return (Numeric)wsv<Vector>(ws, "f_grid").nelem();
+  };
+  cases.push_back(bc);
+
+  for (Index stokes_dim = 1; stokes_dim <= 4; stokes_dim += 3)
+    {
+      const Index nf = 10000;
+      std::shared_ptr<PropagationMatrix> upper = std::make_shared<
+        PropagationMatrix>(benchmark_propmat(nf, stokes_dim, 1.0));
+      std::shared_ptr<PropagationMatrix> lower = std::make_shared<
+        PropagationMatrix>(benchmark_propmat(nf, stokes_dim, 2.0));
+      std::shared_ptr<Tensor3> T = std::make_shared<Tensor3>(nf, stokes_dim,
+                                                             stokes_dim);
+
+      std::ostringstream os;
+      os << "transmission_matrix_stokes" << stokes_dim;
+      bc = BenchmarkCase();
+      bc.name = os.str();
+      bc.unit = "frequencies";
+      bc.work = [nf](Workspace&) { return (Numeric)nf; };
+      bc.run = [upper, lower, T]() {
+        compute_transmission_matrix(*T, 1e3, *upper, *lower);
+      };
+      cases.push_back(bc);
+    }
+
+  bc = BenchmarkCase();
+  bc.name = "ppath_calc_1d";
+  bc.controlfile = "ppath_calc_1d.arts";
+  bc.unit = "path points";
+  bc.work = [](Workspace& ws) {
+    return (Numeric)wsv<Ppath>(ws, "ppath").np;
+  };
+  cases.push_back(bc);
+
+  bc.name = "ppath_calc_3d";
+  bc.controlfile = "ppath_calc_3d.arts";
+  cases.push_back(bc);
+
+  bc = BenchmarkCase();
+  bc.name = "doit_i_field_monoIterate";
+  bc.controlfile = "doit_mono_iterate.arts";
+  bc.requires.push_back(
+    "testdata/scatData/azi-random_f229-231T214-225r100NP-1ar1_5ice.xml");
+  bc.unit = "frequencies";
+  bc.work = [](Workspace& ws) {
+    return (Numeric)wsv<Vector>(ws, "f_grid").nelem();
+  };
+  cases.push_back(bc);
+
+  bc = BenchmarkCase();
+  bc.name = "MCGeneral";
+  bc.controlfile = "mc_general.arts";
+  bc.searchpaths.push_back("artscomponents/montecarlo");
+  bc.requires.push_back(
+    "testdata/scatData/azi-random_f229-231T214-225r100NP-1ar1_5ice.xml");
+  bc.unit = "photons";
+  bc.work = [](Workspace& ws) {
+    return (Numeric)wsv<Index>(ws, "mc_max_iter");
+  };
+  cases.push_back(bc);
+
+  bc = BenchmarkCase();
+  bc.name = "yCalc_odinsmr";
+  bc.controlfile = "ycalc_odinsmr.arts";
+  bc.searchpaths.push_back("instruments/odinsmr");
+  bc.unit = "channels";
+  bc.work = [](Workspace& ws) {
+    return (Numeric)(wsv<Sparse>(ws, "sensor_response").nrows()
+                     * wsv<Matrix>(ws, "sensor_pos").nrows());
+  };
+  cases.push_back(bc);
+
+  bc = BenchmarkCase();
+  bc.name = "xml_binary_read";
+  bc.controlfile = "xml_binary_read.arts";
+  bc.unit = "MB";
+  bc.work = [](Workspace& ws) {
+    const Tensor4& t = wsv<Tensor4>(ws, "benchmark_tensor");
+    return (Numeric)(t.nbooks() * t.npages() * t.nrows() * t.ncols())
+           * (Numeric)sizeof(Numeric) / 1e6;
+  };
+  cases.push_back(bc);
+
+  return cases;
+}
+
+
+//! Write the results in JSON format.
+static void write_json(ostream& os, const std::vector<BenchmarkResult>& results)
+{
+  os << "{\n  \"version\": \"" << ARTS_FULL_VERSION << "\",\n"
+     << "  \"threads\": " << arts_omp_get_max_threads() << ",\n"
+     << "  \"cases\": [\n";
+  for (size_t i = 0; i < results.size(); i++)
+    {
+      const BenchmarkResult& r = results[i];
+      String message = r.message;
+      for (size_t j = 0; j < message.size(); j++)
+        if (message[j] == '"' || message[j] == '\\' || message[j] == '\n')
+          message[j] = '\'';
+
+      os << "    {\"name\": \"" << r.name << "\", \"status\": \""
+         << r.status << "\"";
+      if (r.status == "ok")
+        os << ", \"setup\": " << r.setup
+           << ", \"executions\": " << r.executions
+           << ", \"min\": " << r.min
+           << ", \"median\": " << r.median
+           << ", \"mean\": " << r.mean
+           << ", \"stddev\": " << r.stddev
+           << ", \"work\": " << r.work
+           << ", \"unit\": \"" << r.unit << "\""
+           << ", \"throughput\": " << r.work / r.median;
+      else
+        os << ", \"message\": \"" << message << "\"";
+      os << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+  os << "  ]\n}\n";
+}
+
+
+//! Write the results in CSV format.
+static void write_csv(ostream& os, const std::vector<BenchmarkResult>& results)
+{
+  os << "name,status,setup,executions,min,median,mean,stddev,"
+     << "work,unit,throughput\n";
+  for (size_t i = 0; i < results.size(); i++)
+    {
+      const BenchmarkResult& r = results[i];
+      os << r.name << "," << r.status << ",";
+      if (r.status == "ok")
+        os << r.setup << "," << r.executions << "," << r.min << ","
+           << r.median << "," << r.mean << "," << r.stddev << ","
+           << r.work << "," << r.unit << "," << r.work / r.median;
+      else
+        os << ",,,,,,,,";
+      os << "\n";
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+  const char* usage =
+    "Usage: arts_benchmark [-I includepath] [-D datapath] [-c case]\n"
+    "                      [-n numthreads] [-s samples] [-f json|csv]\n"
+    "                      [-o outfile] [-l]\n";
+
+  struct option longopts[] =
+  {
+    { "includepath", required_argument, NULL, 'I' },
+    { "datapath",    required_argument, NULL, 'D' },
+    { "case",        required_argument, NULL, 'c' },
+    { "numthreads",  required_argument, NULL, 'n' },
+    { "samples",     required_argument, NULL, 's' },
+    { "format",      required_argument, NULL, 'f' },
+    { "outfile",     required_argument, NULL, 'o' },
+    { "list",        no_argument,       NULL, 'l' },
+    { "help",        no_argument,       NULL, 'h' },
+    { NULL,          no_argument,       NULL, 0   }
+  };
+
+  ArrayOfString selected;
+  Index nsamples = 5;
+  String format = "json";
+  String outfile = "";
+  bool list = false;
+
+  parameters.includepath.push_back(".");
+
+  int optc;
+  while ((optc = getopt_long(argc, argv, "I:D:c:n:s:f:o:lh",
+                             longopts, NULL)) != -1)
+    {
+      switch (optc)
+        {
+        case 'I':
+          parameters.includepath.push_back(optarg);
+          break;
+        case 'D':
+          parameters.datapath.push_back(optarg);
+          break;
+        case 'c':
+          selected.push_back(optarg);
+          break;
+        case 'n':
+#ifdef _OPENMP
+          omp_set_num_threads(atoi(optarg));
+#endif
+          break;
+        case 's':
+          nsamples = std::max(1, atoi(optarg));
+          break;
+        case 'f':
+          format = optarg;
+          break;
+        case 'o':
+          outfile = optarg;
+          break;
+        case 'l':
+          list = true;
+          break;
+        default:
+          cerr << usage;
+          return optc == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+  if (format != "json" && format != "csv")
+    {
+      cerr << "Unknown output format: " << format << "\n" << usage;
+      return EXIT_FAILURE;
+    }
+
+  define_wsv_group_names();
+  Workspace::define_wsv_data();
+  Workspace::define_wsv_map();
+  define_md_data_raw();
+  expand_md_data_raw_to_md_data();
+  define_md_map();
+  define_md_raw_map();
+  define_agenda_data();
+  define_agenda_map();
+  assert(check_agenda_data());
+  define_species_data();
+  define_species_map();
+  define_lineshape_data();
+  define_lineshape_norm_data();
+
+  verbosity_at_launch.set_agenda_verbosity(0);
+  verbosity_at_launch.set_screen_verbosity(0);
+  verbosity_at_launch.set_file_verbosity(0);
+  Verbosity verbosity = verbosity_at_launch;
+  verbosity.set_main_agenda(true);
+
+  const std::vector<BenchmarkCase> cases = define_cases();
+
+  if (list)
+    {
+      for (size_t i = 0; i < cases.size(); i++)
+        cout << cases[i].name << "\n";
+      return EXIT_SUCCESS;
+    }
+
+  std::vector<BenchmarkResult> results;
+  for (size_t i = 0; i < cases.size(); i++)
+    {
+      if (selected.nelem()
+          && std::find(selected.begin(), selected.end(), cases[i].name)
+             == selected.end())
+        continue;
+
+      cerr << cases[i].name << ": " << std::flush;
+      results.push_back(run_case(cases[i], nsamples, verbosity));
+      const BenchmarkResult& r = results.back();
+      if (r.status == "ok")
+        cerr << r.median << " s, " << r.work / r.median << " "
+             << r.unit << "/s\n";
+      else
+        cerr << r.status << "\n" << r.message << "\n";
+    }
+
+  std::ofstream ofs;
+  if (outfile != "")
+    {
+      ofs.open(outfile.c_str());
+      if (!ofs)
+        {
+          cerr << "Cannot open output file: " << outfile << "\n";
+          return EXIT_FAILURE;
+        }
+    }
+  ostream& os = outfile != "" ? ofs : cout;
+  os.precision(6);
+  if (format == "json")
+    write_json(os, results);
+  else
+    write_csv(os, results);
+
+  for (size_t i = 0; i < results.size(); i++)
+    if (results[i].status == "failed") return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,454 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+   USA. */
+
+/*!
+  \file   arts_server.cc
+
+  \brief Implementation of the ArtsServer class.
+*/
+
+#include "arts_server.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "parser.h"
+
+extern Verbosity verbosity_at_launch;
+
+////////////////////////////////////////////////////////////////////////////
+// Internal Helper Functions
+////////////////////////////////////////////////////////////////////////////
+
+//! Wall clock time in seconds.
+static double now()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+//! Holds a ReadWriteLock for the lifetime of the object.
+class ReadWriteLockGuard {
+public:
+    ReadWriteLockGuard(ReadWriteLock &lock, bool exclusive = false)
+        : lock_(lock), exclusive_(exclusive)
+    {
+        if (exclusive_) lock_.lock();
+        else lock_.lock_shared();
+    }
+    ~ReadWriteLockGuard()
+    {
+        if (exclusive_) lock_.unlock();
+        else lock_.unlock_shared();
+    }
+
+private:
+    ReadWriteLock &lock_;
+    bool           exclusive_;
+};
+
+//! Write the whole string to a socket.
+static bool write_all(int fd, const String &s)
+{
+    const char *p = s.c_str();
+    size_t n = s.size();
+    while (n > 0) {
+        ssize_t written = ::send(fd, p, n, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += written;
+        n -= written;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// ReadWriteLock
+////////////////////////////////////////////////////////////////////////////
+
+void ReadWriteLock::lock_shared()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]{ return !writer_; });
+    ++readers_;
+}
+
+void ReadWriteLock::unlock_shared()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--readers_ == 0) cond_.notify_all();
+}
+
+void ReadWriteLock::lock()
+{
+    // Announce the writer first so that no new readers get in.
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]{ return !writer_; });
+    writer_ = true;
+    cond_.wait(lock, [this]{ return readers_ == 0; });
+}
+
+void ReadWriteLock::unlock()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    writer_ = false;
+    cond_.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// ArtsServer
+////////////////////////////////////////////////////////////////////////////
+
+ArtsServer::ArtsServer(const InteractiveWorkspace &base,
+                       const String &socket_path,
+                       Index n_workers)
+    : base_(base), socket_path_(socket_path),
+      n_workers_(n_workers > 0 ? n_workers : 1),
+      listen_fd_(-1), stopping_(false), next_session_(0),
+      n_requests_(0), n_failed_(0), max_queue_length_(0),
+      t_queue_(0), t_parse_(0), t_run_(0)
+{
+}
+
+ArtsServer::~ArtsServer()
+{
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        ::unlink(socket_path_.c_str());
+    }
+}
+
+void ArtsServer::run()
+{
+    sockaddr_un address;
+    if (socket_path_.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + socket_path_);
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path_.c_str());
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socket_path_.c_str());
+    if (listen_fd_ < 0
+        || ::bind(listen_fd_, (sockaddr *) &address, sizeof(address)) < 0
+        || ::listen(listen_fd_, 16) < 0) {
+        std::ostringstream os;
+        os << "Cannot listen on socket " << socket_path_ << ": "
+           << strerror(errno);
+        throw std::runtime_error(os.str());
+    }
+
+    for (Index i = 0; i < n_workers_; ++i) {
+        workers_.push_back(std::thread(&ArtsServer::worker, this));
+    }
+
+    std::vector<std::thread> connections;
+    while (true) {
+        int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            if (stopping_) {
+                ::close(fd);
+                break;
+            }
+            connection_fds_.insert(fd);
+        }
+        connections.push_back(std::thread(&ArtsServer::serve_connection,
+                                          this, fd));
+    }
+
+    {
+        // Disconnect the remaining clients.
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+        for (int fd : connection_fds_) ::shutdown(fd, SHUT_RDWR);
+    }
+    queue_cond_.notify_all();
+
+    for (std::thread &t : connections) t.join();
+    for (std::thread &t : workers_) t.join();
+    workers_.clear();
+
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    sessions_.clear();
+}
+
+void ArtsServer::serve_connection(int fd)
+{
+    String buffer;
+    char chunk[4096];
+    bool shutdown = false;
+    bool closed = false;
+
+    while (!shutdown && !closed) {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        buffer.append(chunk, n);
+
+        size_t pos;
+        while (!shutdown && !closed
+               && (pos = buffer.find('\n')) != std::string::npos) {
+            String line = buffer.substr(0, pos);
+            buffer.erase(0, pos + 1);
+            closed = !write_all(fd, handle_line(line, shutdown));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        connection_fds_.erase(fd);
+    }
+    ::close(fd);
+
+    if (shutdown) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            stopping_ = true;
+        }
+        // Wake up the accept call in run().
+        ::shutdown(listen_fd_, SHUT_RDWR);
+    }
+}
+
+String ArtsServer::handle_line(const String &line, bool &shutdown)
+{
+    std::istringstream is(line);
+    String command;
+    is >> command;
+
+    try {
+        if (command == "create") {
+            std::shared_ptr<Session> session;
+            {
+                // The copy reads the variable table.
+                ReadWriteLockGuard lock(variables_lock_);
+                session = std::make_shared<Session>(base_);
+            }
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            Index id = next_session_++;
+            sessions_[id] = session;
+            std::ostringstream os;
+            os << "OK " << id << "\n";
+            return os.str();
+        }
+
+        if (command == "destroy" || command == "execute") {
+            Index id;
+            if (!(is >> id)) {
+                return error_reply("Missing workspace id.");
+            }
+
+            if (command == "destroy") {
+                std::lock_guard<std::mutex> lock(sessions_mutex_);
+                if (!sessions_.erase(id)) {
+                    return error_reply("Unknown workspace id.");
+                }
+                return "OK\n";
+            }
+
+            String controlfile;
+            std::getline(is >> std::ws, controlfile);
+            if (controlfile.empty()) {
+                return error_reply("Missing controlfile.");
+            }
+            return execute(id, controlfile);
+        }
+
+        if (command == "stats") {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            std::ostringstream os;
+            os << "OK requests=" << n_requests_
+               << " failed=" << n_failed_
+               << " max_queue=" << max_queue_length_
+               << " queue=" << t_queue_
+               << " parse=" << t_parse_
+               << " run=" << t_run_ << "\n";
+            return os.str();
+        }
+
+        if (command == "shutdown") {
+            shutdown = true;
+            return "OK\n";
+        }
+    } catch (const std::exception &e) {
+        return error_reply(e.what());
+    }
+
+    return error_reply("Unknown command: " + command);
+}
+
+String ArtsServer::execute(Index session, const String &controlfile)
+{
+    Request request;
+    request.session = session;
+    request.controlfile = controlfile;
+    request.t_queued = now();
+    request.done = false;
+    request.failed = false;
+
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (stopping_) {
+        return error_reply("Server is shutting down.");
+    }
+    queue_.push_back(&request);
+    {
+        std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+        if ((Index) queue_.size() > max_queue_length_) {
+            max_queue_length_ = queue_.size();
+        }
+    }
+    queue_cond_.notify_one();
+    request.cond.wait(lock, [&request]{ return request.done; });
+    return request.reply;
+}
+
+void ArtsServer::worker()
+{
+    while (true) {
+        Request *request;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cond_.wait(lock, [this]{
+                    return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;
+            request = queue_.front();
+            queue_.pop_front();
+        }
+
+        process(*request);
+
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        request->done = true;
+        request->cond.notify_one();
+    }
+}
+
+void ArtsServer::process(Request &request)
+{
+    const double t_start = now();
+    double t_parsed = t_start;
+    double t_end;
+
+    try {
+        std::shared_ptr<Session> session = get_session(request.session);
+        std::shared_ptr<Agenda> parsed = parse(request.controlfile);
+        t_parsed = now();
+
+        // Agendas are not shared between threads.
+        Agenda a(*parsed);
+
+        std::lock_guard<std::mutex> lock(session->mutex);
+        bool reentrant;
+        {
+            ReadWriteLockGuard variables_lock(variables_lock_);
+            reentrant = session->workspace.is_reentrant(a);
+        }
+
+        // Controlfiles that are not reentrant run one at a time.
+        ReadWriteLockGuard variables_lock(variables_lock_, !reentrant);
+        session->workspace.unshare_outputs(a);
+        session->workspace.execute(a);
+        t_end = now();
+
+        std::ostringstream os;
+        os << "OK queue=" << t_start - request.t_queued
+           << " parse=" << t_parsed - t_start
+           << " run=" << t_end - t_parsed << "\n";
+        request.reply = os.str();
+    } catch (const std::exception &e) {
+        t_end = now();
+        request.failed = true;
+        request.reply = error_reply(e.what());
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++n_requests_;
+    if (request.failed) ++n_failed_;
+    t_queue_ += t_start - request.t_queued;
+    t_parse_ += t_parsed - t_start;
+    t_run_ += t_end - t_parsed;
+}
+
+std::shared_ptr<Agenda> ArtsServer::parse(const String &controlfile)
+{
+    std::lock_guard<std::mutex> lock(parse_mutex_);
+
+    struct stat st;
+    time_t mtime = 0;
+    if (::stat(controlfile.c_str(), &st) == 0) {
+        mtime = st.st_mtime;
+    }
+
+    auto it = parsed_.find(controlfile);
+    if (it != parsed_.end() && it->second.mtime == mtime) {
+        return it->second.agenda;
+    }
+
+    std::shared_ptr<Agenda> a = std::make_shared<Agenda>();
+    {
+        // The parser adds the variables created in the controlfile.
+        variables_lock_.lock();
+        try {
+            ArtsParser parser(*a, controlfile, verbosity_at_launch);
+            parser.parse_tasklist();
+        } catch (...) {
+            variables_lock_.unlock();
+            throw;
+        }
+        variables_lock_.unlock();
+    }
+    a->set_name(controlfile);
+    a->set_main_agenda();
+
+    ParsedControlfile &entry = parsed_[controlfile];
+    entry.mtime = mtime;
+    entry.agenda = a;
+    return a;
+}
+
+std::shared_ptr<ArtsServer::Session> ArtsServer::get_session(Index id)
+{
+    std::lock_guard<std::mutex> lock(sessions_mutex_);
+    auto it = sessions_.find(id);
+    if (it == sessions_.end()) {
+        std::ostringstream os;
+        os << "Unknown workspace id: " << id;
+        throw std::runtime_error(os.str());
+    }
+    return it->second;
+}
+
+String ArtsServer::error_reply(const String &message)
+{
+    std::ostringstream os;
+    os << "ERROR " << message.size() << "\n" << message;
+    return os.str();
+}
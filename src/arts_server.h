@@ -0,0 +1,177 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+   USA. */
+
+////////////////////////////////////////////////////////////////////////////
+//   File description
+////////////////////////////////////////////////////////////////////////////
+/*!
+  \file   arts_server.h
+
+  \brief Declaration of the ArtsServer class, which serves workspaces
+         over a local socket.
+
+  The server keeps a base workspace with read-only data (lookup tables,
+  scattering data, catalogues, ...) in memory and creates client
+  workspaces that share this data. Clients connect to a Unix domain socket
+  and send one request per line:
+
+  \verbatim
+  create                         -> OK <id>
+  destroy <id>                   -> OK
+  execute <id> <controlfile>     -> OK queue=<s> parse=<s> run=<s>
+  stats                          -> OK requests=<n> failed=<n> ...
+  shutdown                       -> OK
+  \endverbatim
+
+  A failed request is answered with "ERROR <n>" followed by a newline and
+  the n bytes of the error message.
+
+  Requests are put into a queue and processed by a fixed number of worker
+  threads. Controlfiles are parsed one at a time, since parsing can create
+  new workspace variables. Controlfiles of different clients are executed
+  concurrently. Variables of the base workspace are only copied into a
+  client workspace when the controlfile modifies them. Methods that can
+  modify any variable, such as ReadWorkspaceSnapshot, are therefore
+  rejected, as is Exit.
+
+  Controlfiles calling file readers are executed one at a time, see
+  InteractiveWorkspace::is_reentrant. Some other parts of ARTS also fill
+  static lookup tables on first use. With more than one worker, the setup
+  of the base workspace should therefore have run the calculations once,
+  e.g. a first yCalc, so that these tables are initialised before clients
+  execute concurrently.
+*/
+
+#ifndef ARTS_SERVER_INCLUDED
+#define ARTS_SERVER_INCLUDED
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "interactive_workspace.h"
+
+//! Lock that can be held by many readers or by a single writer.
+class ReadWriteLock {
+public:
+    ReadWriteLock() : readers_(0), writer_(false) {}
+
+    void lock_shared();
+    void unlock_shared();
+    void lock();
+    void unlock();
+
+private:
+    std::mutex              mutex_;
+    std::condition_variable cond_;
+    Index                   readers_;
+    bool                    writer_;
+};
+
+class ArtsServer {
+public:
+
+    //! Create server.
+    /*!
+    \param base Workspace holding the data shared by all clients.
+    \param socket_path Path of the Unix domain socket.
+    \param n_workers Number of worker threads executing requests. More
+    than one is only safe for setups that are already initialised, see
+    above.
+    */
+    ArtsServer(const InteractiveWorkspace &base,
+               const String &socket_path,
+               Index n_workers);
+
+    ~ArtsServer();
+
+    //! Serve requests until a client sends shutdown.
+    /*!
+    Throws a runtime_error if the socket cannot be created.
+    */
+    void run();
+
+private:
+
+    struct Session {
+        Session(const InteractiveWorkspace &base) : workspace(base) {}
+
+        InteractiveWorkspace workspace;
+        std::mutex           mutex;
+    };
+
+    struct ParsedControlfile {
+        time_t                  mtime;
+        std::shared_ptr<Agenda> agenda;
+    };
+
+    struct Request {
+        Index                   session;
+        String                  controlfile;
+        double                  t_queued;
+        bool                    done;
+        bool                    failed;
+        String                  reply;
+        std::condition_variable cond;
+    };
+
+    void serve_connection(int fd);
+    String handle_line(const String &line, bool &shutdown);
+    String execute(Index session, const String &controlfile);
+    void worker();
+    void process(Request &request);
+    std::shared_ptr<Agenda> parse(const String &controlfile);
+    std::shared_ptr<Session> get_session(Index id);
+
+    static String error_reply(const String &message);
+
+    const InteractiveWorkspace &base_;
+    String                      socket_path_;
+    Index                       n_workers_;
+    int                         listen_fd_;
+    bool                        stopping_;
+
+    ReadWriteLock               variables_lock_;
+
+    std::mutex                  sessions_mutex_;
+    std::map<Index, std::shared_ptr<Session>> sessions_;
+    Index                       next_session_;
+
+    std::mutex                  parse_mutex_;
+    std::map<String, ParsedControlfile> parsed_;
+
+    std::mutex                  queue_mutex_;
+    std::condition_variable     queue_cond_;
+    std::deque<Request*>        queue_;
+    std::set<int>               connection_fds_;
+
+    std::mutex                  stats_mutex_;
+    Index                       n_requests_;
+    Index                       n_failed_;
+    Index                       max_queue_length_;
+    double                      t_queue_;
+    double                      t_parse_;
+    double                      t_run_;
+
+    std::vector<std::thread>    workers_;
+};
+
+#endif // ARTS_SERVER_INCLUDED
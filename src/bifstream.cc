@@ -28,8 +28,10 @@
 
 */
 
+#include <algorithm>
 #include <fstream>
 #include <stdexcept>
+#include <vector>
 #include "bifstream.h"
 
 void bifstream::seek(long spos, Offset offs)
@@ -64,6 +66,74 @@ bifstream::Byte bifstream::getByte()
 }
 
 
+//! Read an array of doubles
+/*!
+  Reads n doubles in one go directly into the given buffer, if the file
+  holds IEEE-754 doubles and the system uses this format as well. The bytes
+  are swapped afterwards if the byte orders differ. Otherwise, the values
+  are read one by one through the binio conversion.
+
+  \param a  Buffer of at least n elements
+  \param n  Number of values to read
+*/
+void bifstream::readDoubleArray(double *a, streamsize n)
+{
+  if (n <= 0) return;
+
+  if (sizeof(double) == 8
+      && getFlag(binio::FloatIEEE) && (system_flags & binio::FloatIEEE))
+    {
+      this->read(reinterpret_cast<char *>(a), n * 8);
+      if (!this->good()) { err |= Eof; return; }
+
+      if (getFlag(binio::BigEndian) != bool(system_flags & binio::BigEndian))
+        {
+          char *c = reinterpret_cast<char *>(a);
+          for (streamsize i = 0; i < n; i++, c += 8)
+            {
+              std::swap(c[0], c[7]);
+              std::swap(c[1], c[6]);
+              std::swap(c[2], c[5]);
+              std::swap(c[3], c[4]);
+            }
+        }
+    }
+  else
+    {
+      for (streamsize i = 0; i < n && this->good(); i++)
+        a[i] = (double)this->readFloat(binio::Double);
+    }
+}
+
+
+//! Read an array of 4-byte integers
+/*!
+  Reads n integers in one go and converts them from the byte order of the
+  file. Gives the same result as reading them one by one with readInt(4).
+
+  \param a  Buffer of at least n elements
+  \param n  Number of values to read
+*/
+void bifstream::readIntArray(long *a, streamsize n)
+{
+  if (n <= 0) return;
+
+  std::vector<unsigned char> buf(n * 4);
+  this->read(reinterpret_cast<char *>(buf.data()), n * 4);
+  if (!this->good()) { err |= Eof; return; }
+
+  const unsigned char *c = buf.data();
+  if (getFlag(binio::BigEndian))
+    for (streamsize i = 0; i < n; i++, c += 4)
+      a[i] = ((long)c[0] << 24) | ((long)c[1] << 16) | ((long)c[2] << 8)
+             | (long)c[3];
+  else
+    for (streamsize i = 0; i < n; i++, c += 4)
+      a[i] = ((long)c[3] << 24) | ((long)c[2] << 16) | ((long)c[1] << 8)
+             | (long)c[0];
+}
+
+
 /* Overloaded input operators */
 bifstream& operator>> (bifstream& bif, double& n)
 { n = (double)bif.readFloat (binio::Double); return (bif); }
@@ -64,6 +64,10 @@ public:
   bifstream::Byte getByte();
   void getRaw (char *c, streamsize n) { this->read (c, n); }
 
+  void readDoubleArray (double *a, streamsize n);
+
+  void readIntArray (long *a, streamsize n);
+
 };
 
 
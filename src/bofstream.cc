@@ -30,6 +30,7 @@
 
 #include <fstream>
 #include <stdexcept>
+#include <vector>
 #include "bofstream.h"
 
 void bofstream::seek(long spos, Offset offs)
@@ -66,6 +67,86 @@ void bofstream::putByte (bofstream::Byte b)
 }
 
 
+//! Write an array of doubles
+/*!
+  Writes n doubles in one go, if the file format (IEEE-754 doubles) matches
+  the system representation including byte order. Otherwise, the values are
+  written one by one through the binio conversion.
+
+  \param a  Buffer holding the values
+  \param n  Number of values to write
+*/
+void bofstream::writeDoubleArray(const double *a, streamsize n)
+{
+  if (n <= 0) return;
+
+  if (sizeof(double) == 8
+      && getFlag(binio::FloatIEEE) && (system_flags & binio::FloatIEEE)
+      && getFlag(binio::BigEndian) == bool(system_flags & binio::BigEndian))
+    {
+      if (!this->good ()) {
+        err |= NotOpen;
+        throw runtime_error ("Cannot open binary file for writing");
+      }
+      this->write(reinterpret_cast<const char *>(a), n * 8);
+      if (this->bad ())
+        {
+          err |= Fatal;
+          throw runtime_error ("Writing to binary file failed");
+        }
+    }
+  else
+    {
+      for (streamsize i = 0; i < n; i++)
+        this->writeFloat(a[i], binio::Double);
+    }
+}
+
+
+//! Write an array of integers as 4-byte integers
+/*!
+  Converts n integers to the byte order of the file and writes them in one
+  go. Gives the same result as writing them one by one with writeInt(a, 4).
+
+  \param a  Buffer holding the values
+  \param n  Number of values to write
+*/
+void bofstream::writeIntArray(const long *a, streamsize n)
+{
+  if (n <= 0) return;
+
+  std::vector<unsigned char> buf(n * 4);
+  unsigned char *c = buf.data();
+  if (getFlag(binio::BigEndian))
+    for (streamsize i = 0; i < n; i++, c += 4)
+      {
+        c[0] = (unsigned char)(a[i] >> 24);
+        c[1] = (unsigned char)(a[i] >> 16);
+        c[2] = (unsigned char)(a[i] >> 8);
+        c[3] = (unsigned char)a[i];
+      }
+  else
+    for (streamsize i = 0; i < n; i++, c += 4)
+      {
+        c[0] = (unsigned char)a[i];
+        c[1] = (unsigned char)(a[i] >> 8);
+        c[2] = (unsigned char)(a[i] >> 16);
+        c[3] = (unsigned char)(a[i] >> 24);
+      }
+
+  if (!this->good ()) {
+    err |= NotOpen;
+    throw runtime_error ("Cannot open binary file for writing");
+  }
+  this->write(reinterpret_cast<const char *>(buf.data()), n * 4);
+  if (this->bad ())
+    {
+      err |= Fatal;
+      throw runtime_error ("Writing to binary file failed");
+    }
+}
+
+
 /* Overloaded output operators */
 bofstream& operator<< (bofstream& bof, double n)
 { bof.writeFloat (n, binio::Double); return (bof); }
@@ -62,6 +62,10 @@ public:
 
   void putByte (bofstream::Byte b);
   void putRaw (const char *c, streamsize n) { this->write (c, n); }
+
+  void writeDoubleArray (const double *a, streamsize n);
+
+  void writeIntArray (const long *a, streamsize n);
 };
 
 
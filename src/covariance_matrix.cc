@@ -24,6 +24,7 @@
   \brief  Implementation of CovarianceMatrix class.
 */
 
+#include <algorithm>
 #include <utility>
 #include <tuple>
 #include <queue>
@@ -423,10 +424,73 @@ void CovarianceMatrix::invert_correlation_block(std::vector<Block> &inverses,
     std::sort(blocks.begin(), blocks.end(), comp);
 
 
-    // Nothing to do if single block which already has inverse.
-    if ((blocks.size() == 1) && has_inverse(blocks[0]->get_indices())) {
+    // Nothing to do if the inverse of this set of blocks has already been
+    // computed (or provided), i.e. there is an inverse block for each pair
+    // of the correlated retrieval quantities. This is the case when
+    // compute_inverse is called repeatedly for the same covariance matrix,
+    // e.g. for each OEM call. Otherwise, an incomplete inverse left from
+    // an earlier call is removed.
+    std::vector<Index> group{};
+    for (const Block *b : blocks) {
+        Index ci, cj;
+        std::tie(ci, cj) = b->get_indices();
+        if (ci == cj) {
+            group.push_back(ci);
+        }
+    }
+    bool all_inverses = true;
+    for (Index bi : group) {
+        for (Index bj : group) {
+            if ((bi <= bj) && !has_inverse(std::make_pair(bi, bj))) {
+                all_inverses = false;
+            }
+        }
+    }
+    if (all_inverses) {
         return;
     }
+    auto in_group = [&group](const Block &b)
+        {
+            Index ci, cj;
+            std::tie(ci, cj) = b.get_indices();
+            return (std::find(group.begin(), group.end(), ci) != group.end())
+                && (std::find(group.begin(), group.end(), cj) != group.end());
+        };
+    inverses.erase(std::remove_if(inverses.begin(), inverses.end(), in_group),
+                   inverses.end());
+
+    // A single sparse block having only diagonal elements is inverted
+    // directly, which avoids forming and inverting a dense matrix.
+    if ((blocks.size() == 1)
+        && (blocks[0]->get_matrix_type() == Block::MatrixType::sparse)) {
+        const Sparse & S = blocks[0]->get_sparse();
+        const Vector   d = S.diagonal();
+        bool is_diagonal = true;
+        Index nnz_diag   = 0;
+        for (Index i = 0; i < d.nelem(); ++i) {
+            if (d[i] == 0.0) {
+                is_diagonal = false;
+            } else {
+                nnz_diag++;
+            }
+        }
+        if (is_diagonal && (nnz_diag == S.nnz())) {
+            Index n = d.nelem();
+            ArrayOfIndex indices(n);
+            Vector d_inv(n);
+            for (Index i = 0; i < n; ++i) {
+                indices[i] = i;
+                d_inv[i]   = 1.0 / d[i];
+            }
+            std::shared_ptr<Sparse> S_inv = std::make_shared<Sparse>(n, n);
+            S_inv->insert_elements(n, indices, indices, d_inv);
+            inverses.push_back(Block(blocks[0]->get_row_range(),
+                                     blocks[0]->get_column_range(),
+                                     blocks[0]->get_indices(),
+                                     S_inv));
+            return;
+        }
+    }
 
     // Otherwise go on to precompute the inverse of a block consisting
     // of correlations between multiple retrieval quantities.
@@ -482,19 +546,29 @@ void CovarianceMatrix::invert_correlation_block(std::vector<Block> &inverses,
             A(j,i) = A(i,j);
         }
     }
-    inv(A, A);
-
-    // // Invert matrix using LAPACK.
-    // char uplo = 'L';
-    // int  ni, info1(0), info2(0);
-    // ni = static_cast<int>(n);
-    // lapack::dpotrf_(&uplo, &ni, A.get_raw_data(), &ni, &info1);
-    // lapack::dpotri_(&uplo, &ni, A.get_raw_data(), &ni, &info2);
-    // if ((info1 != 0) || info2 !=0) {
-    //     throw std::runtime_error("Error inverting block of covariance matrix."
-    //                              "Make sure that it is symmetric, positive definite"
-    //                              "or provide the inverse manually.");
-    // }
+    // Invert matrix using the Cholesky decomposition. As A is symmetric, the
+    // row-major layout of ARTS does not matter, but only one triangle is set
+    // by dpotri and the result must be symmetrised. If A is not positive
+    // definite (e.g. due to rounding), the general inversion is used.
+    Matrix L(A);
+    char uplo = 'L';
+    int  ni, info1(0), info2(0);
+    ni = static_cast<int>(n);
+    lapack::dpotrf_(&uplo, &ni, L.get_raw_data(), &ni, &info1);
+    if (info1 == 0) {
+        lapack::dpotri_(&uplo, &ni, L.get_raw_data(), &ni, &info2);
+    }
+    if ((info1 == 0) && (info2 == 0)) {
+        // Column-major lower triangle is the upper triangle in ARTS.
+        for (Index i = 0; i < n; ++i) {
+            for (Index j = i + 1; j < n; ++j) {
+                L(j,i) = L(i,j);
+            }
+        }
+        A = L;
+    } else {
+        inv(A, A);
+    }
 
     // Now we need to disassemble the matrix inverse bach to the separate block in the
     // covariance matrix. Note, however, that blocks that previously were implicitly
@@ -519,10 +593,52 @@ void CovarianceMatrix::invert_correlation_block(std::vector<Block> &inverses,
 void CovarianceMatrix::add_correlation(Block c)
 {
     correlations_.push_back(c);
+
+    // Inverses of the set of correlated retrieval quantities that the new
+    // block belongs to are no longer valid, whether computed or provided.
+    Index ci, cj;
+    std::tie(ci, cj) = c.get_indices();
+    std::vector<Index> group{ci};
+    if (cj != ci) {
+        group.push_back(cj);
+    }
+    auto in_group = [&group](Index k)
+        {
+            return std::find(group.begin(), group.end(), k) != group.end();
+        };
+
+    bool extended = true;
+    while (extended) {
+        extended = false;
+        for (const Block &b : correlations_) {
+            Index bi, bj;
+            std::tie(bi, bj) = b.get_indices();
+            if (in_group(bi) != in_group(bj)) {
+                group.push_back(in_group(bi) ? bj : bi);
+                extended = true;
+            }
+        }
+    }
+
+    auto is_stale = [&in_group](const Block &b)
+        {
+            Index bi, bj;
+            std::tie(bi, bj) = b.get_indices();
+            return in_group(bi) || in_group(bj);
+        };
+    inverses_.erase(std::remove_if(inverses_.begin(), inverses_.end(), is_stale),
+                    inverses_.end());
 }
 
 void CovarianceMatrix::add_correlation_inverse(Block c)
 {
+    // A provided inverse replaces any earlier inverse of the same block.
+    auto same_block = [&c](const Block &b)
+        {
+            return b.get_indices() == c.get_indices();
+        };
+    inverses_.erase(std::remove_if(inverses_.begin(), inverses_.end(), same_block),
+                    inverses_.end());
     inverses_.push_back(c);
 }
 
@@ -540,6 +656,22 @@ Vector CovarianceMatrix::diagonal() const
     return diag;
 }
 
+Vector CovarianceMatrix::inverse_diagonal() const
+{
+    compute_inverse();
+
+    Vector diag(nrows());
+    for (const Block &b : inverses_) {
+        Index i,j;
+        tie(i,j) = b.get_indices();
+
+        if (i == j) {
+            diag[b.get_row_range()] = b.diagonal();
+        }
+    }
+    return diag;
+}
+
 void mult(MatrixView C, ConstMatrixView A, const CovarianceMatrix &B)
 {
     C = 0.0;
@@ -319,6 +319,10 @@ public:
      * Compute the inverse of this correlation matrix. This function must be executed
      * after all block have been added to the covariance matrix and before any of the
      * mult_inv or add_inv methods is used.
+     *
+     * The inverse is computed separately for each set of correlated blocks, using
+     * the Cholesky decomposition, or directly for diagonal sparse blocks. Inverses
+     * already present are kept, so repeated calls are cheap.
      */
     void compute_inverse() const;
 
@@ -326,7 +330,9 @@ public:
      *
      * This function add a given block to the covariance matrix.
      * If this block is not consistent with other blocks in the matrix
-     * an error will be thrown.
+     * an error will be thrown. Inverse blocks of the retrieval quantities
+     * correlated with the block are removed, and are recomputed by the
+     * next call to compute_inverse().
      *
      * @param c The block to add to the covariance matrix
      */
@@ -336,7 +342,8 @@ public:
      *
      * This function adds the inverse of a given block to a covariance
      * matrix. An error will be thrown if the corresponding non-inverse
-     * block is not already in the covariance matrix.
+     * block is not already in the covariance matrix. An inverse already
+     * present for the same block is replaced.
      *
      * @param c The inverse of a block already in the matrix.
      */
@@ -351,6 +358,15 @@ public:
      */
     Vector diagonal() const;
 
+    /** Diagonal elements of the inverse as vector
+     *
+     * Extracts the diagonal elements of the inverse covariance matrix.
+     * Missing inverse blocks are computed first.
+     *
+     * @return A vector containing the diagonal elements of the inverse.
+     */
+    Vector inverse_diagonal() const;
+
     // Friend declarations.
     friend void mult(MatrixView, ConstMatrixView, const CovarianceMatrix &);
     friend void mult(MatrixView, const CovarianceMatrix &, ConstMatrixView);
@@ -25,12 +25,14 @@
  
 **/
 
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
 #include "agenda_class.h"
 #include "array.h"
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "disort.h"
@@ -2036,14 +2038,17 @@ void run_disort( Workspace& ws,
               const String& pfct_method,
               const Verbosity& verbosity )
 {
+  CREATE_OUT2;
+
   // Input variables for DISORT
   Index nlyr;
   nlyr = p_grid.nelem()-1;
+  const Index nf = f_grid.nelem();
       
   // Optical depth of layers
-  Vector dtauc(nlyr, 0.); 
+  Matrix dtauc(nf, nlyr, 0.); 
   // Single scattering albedo of layers
-  Vector ssalb(nlyr, 0.);
+  Matrix ssalb(nf, nlyr, 0.);
   
   // Phase function
   Vector scat_angle_grid;
@@ -2063,7 +2068,7 @@ void run_disort( Workspace& ws,
   Index Nlegendre=nstreams+1;
   
   // Legendre polynomials of phase function
-  Matrix pmom(nlyr, Nlegendre, 0.); 
+  Tensor3 pmom(nf, nlyr, Nlegendre, 0.); 
 
   // Intensities to be computed for user defined polar (zenith angles)
   Index usrang = TRUE_;
@@ -2169,48 +2174,81 @@ void run_disort( Workspace& ws,
   Index ntau = 0; 
   Vector utau(maxulv,0.);
   
-  // Loop over frequencies
-  for (Index f_index = 0; f_index < f_grid.nelem(); f_index ++)
+  // The optical properties of all frequencies are derived first, in
+  // parallel. DISORT itself is not thread-safe (Fortran SAVE variables),
+  // so the calls to disort_ are kept serial in a second loop below.
+  const auto t_start = std::chrono::steady_clock::now();
+
+  // We have to make a local copy of the Workspace and the agendas because
+  // only non-reference types can be declared firstprivate in OpenMP
+  Workspace l_ws (ws);
+  Agenda l_propmat_clearsky_agenda (propmat_clearsky_agenda);
+
+  String fail_msg;
+  bool failed = false;
+
+#pragma omp parallel for                                    \
+if(!arts_omp_in_parallel() && nf>1)                       \
+firstprivate(l_ws, l_propmat_clearsky_agenda, phase_function)
+  for (Index f_index = 0; f_index < nf; f_index ++)
     {
-      ttemp = COSMIC_BG_TEMP;
-
-//#pragma omp critical(fortran_disort)
-//      {
-      dtauc_ssalbCalc(ws, dtauc, ssalb, scat_data, f_index,
-                      propmat_clearsky_agenda,
-                      pnd_field,
-                      t_field(Range(0,nlyr+1),joker,joker),
-                      z_field(Range(0,nlyr+1),joker,joker),
-                      vmr_field(joker,Range(0,nlyr+1),joker,joker),
-                      p_grid[Range(0,nlyr+1)],
-                      cloudbox_limits, f_grid[Range(f_index,1)], verbosity);
+      if (failed)
+        continue;
 
-      if( pfct_method=="interpolate" )
-      {
-        phase_functionCalc2(phase_function,
-                            scat_data, f_index,
-                            pnd_field, t_field, cloudbox_limits,
-                            pfct_za_grid_size, verbosity);
-        for( Index l=0; l<nlyr; l++ )
-          if( phase_function(l,0)==0. )
-            assert( ssalb[l]==0. );
+      try {
+        dtauc_ssalbCalc(l_ws, dtauc(f_index,joker), ssalb(f_index,joker),
+                        scat_data, f_index,
+                        l_propmat_clearsky_agenda,
+                        pnd_field,
+                        t_field(Range(0,nlyr+1),joker,joker),
+                        z_field(Range(0,nlyr+1),joker,joker),
+                        vmr_field(joker,Range(0,nlyr+1),joker,joker),
+                        p_grid[Range(0,nlyr+1)],
+                        cloudbox_limits, f_grid[Range(f_index,1)], verbosity);
 
-        //cout << "entering pmomCalc for f_index=" << f_index << " (f="
-        //     << f_grid[f_index]*1e-9 << "GHz).\n";
-        pmomCalc2(pmom, phase_function, scat_angle_grid, Nlegendre, verbosity);
+        if( pfct_method=="interpolate" )
+        {
+          phase_functionCalc2(phase_function,
+                              scat_data, f_index,
+                              pnd_field, t_field, cloudbox_limits,
+                              pfct_za_grid_size, verbosity);
+          for( Index l=0; l<nlyr; l++ )
+            if( phase_function(l,0)==0. )
+              assert( ssalb(f_index,l)==0. );
+
+          pmomCalc2(pmom(f_index,joker,joker), phase_function,
+                    scat_angle_grid, Nlegendre, verbosity);
+        }
+        else
+        {
+          phase_functionCalc(phase_function, scat_data, f_index, pnd_field,
+                             cloudbox_limits, pfct_method );
+          for( Index l=0; l<nlyr; l++ )
+            if( phase_function(l,0)==0. )
+              assert( ssalb(f_index,l)==0. );
+
+          pmomCalc(pmom(f_index,joker,joker), phase_function,
+                   scat_angle_grid, Nlegendre, verbosity);
+        }
+      } catch (const std::runtime_error &e) {
+        ostringstream os;
+        os << "Error for f_index = " << f_index
+           << " (" << f_grid[f_index] << " Hz)" << endl
+           << e.what();
+#pragma omp critical (run_disort_fail)
+        { failed = true; fail_msg = os.str(); }
       }
-      else
-      {
-        phase_functionCalc(phase_function, scat_data, f_index, pnd_field,
-                           cloudbox_limits, pfct_method );
-        for( Index l=0; l<nlyr; l++ )
-          if( phase_function(l,0)==0. )
-            assert( ssalb[l]==0. );
+    }
 
-        //cout << "entering pmomCalc for f_index=" << f_index << " (f="
-        //     << f_grid[f_index]*1e-9 << "GHz).\n";
-        pmomCalc(pmom, phase_function, scat_angle_grid, Nlegendre, verbosity);
-      }
+  if (failed)
+    throw runtime_error(fail_msg);
+
+  const auto t_optprop = std::chrono::steady_clock::now();
+
+  // Loop over frequencies
+  for (Index f_index = 0; f_index < nf; f_index ++)
+    {
+      ttemp = COSMIC_BG_TEMP;
 
       // Wavenumber in [1/cm]
       Numeric wvnmlo = f_grid[f_index]/(100*SPEED_OF_LIGHT);
@@ -2237,8 +2275,9 @@ void run_disort( Workspace& ws,
 #pragma omp critical(fortran_disort)
       {
           // Call disort
-          disort_(&nlyr, dtauc.get_c_array(),
-                  ssalb.get_c_array(), pmom.get_c_array(),
+          disort_(&nlyr, dtauc(f_index,joker).get_c_array(),
+                  ssalb(f_index,joker).get_c_array(),
+                  pmom(f_index,joker,joker).get_c_array(),
                   t.get_c_array(), &wvnmlo, &wvnmhi,
                   &usrtau, &ntau, utau.get_c_array(),
                   &nstr, &usrang, &numu,
@@ -2270,6 +2309,16 @@ void run_disort( Workspace& ws,
               uu(0,nlyr-k-cloudbox_limits[0],j) / (100*SPEED_OF_LIGHT);
     }
   delete [] prnt;
+
+  const auto t_end = std::chrono::steady_clock::now();
+  out2 << "  DISORT timing for " << nf << " frequencies:\n"
+       << "    optical properties (" << arts_omp_get_max_threads()
+       << " threads): "
+       << std::chrono::duration<Numeric>( t_optprop - t_start ).count()
+       << " s\n"
+       << "    DISORT (serial):       "
+       << std::chrono::duration<Numeric>( t_end - t_optprop ).count()
+       << " s\n";
 }
 
 //! run_disort2
@@ -2321,6 +2370,8 @@ void run_disort2( Workspace& ws,
               const Index& Npfct,
               const Verbosity& verbosity )
 {
+  CREATE_OUT2;
+
   const Index nf = f_grid.nelem();
   Index nlyr = p_grid.nelem()-1; // don't make this const, else disort_ complains
       
@@ -2436,6 +2487,8 @@ void run_disort2( Workspace& ws,
   // get_dtauc_ssalb.
   Index nf_ssd = scat_data[0][0].f_grid.nelem();
 
+  const auto t_start = std::chrono::steady_clock::now();
+
   Matrix ext_bulk_gas(nf,nlyr+1);
   get_gasoptprop( ws, ext_bulk_gas,
                   propmat_clearsky_agenda,
@@ -2468,6 +2521,8 @@ void run_disort2( Workspace& ws,
   Tensor3 pmom(nf_ssd, nlyr, Nlegendre, 0.); 
   get_pmom( pmom, pfct_bulk_par, pfct_angs, Nlegendre );
 
+  const auto t_optprop = std::chrono::steady_clock::now();
+
   // Loop over frequencies
   bool pf = (nf_ssd!=1);
   Index this_f_index = 0;
@@ -2569,6 +2624,15 @@ void run_disort2( Workspace& ws,
               uu(0,nlyr-k-cloudbox_limits[0],j) / (100*SPEED_OF_LIGHT);
     }
   delete [] prnt;
+
+  const auto t_end = std::chrono::steady_clock::now();
+  out2 << "  DISORT timing for " << nf << " frequencies:\n"
+       << "    optical properties: "
+       << std::chrono::duration<Numeric>( t_optprop - t_start ).count()
+       << " s\n"
+       << "    DISORT (serial):    "
+       << std::chrono::duration<Numeric>( t_end - t_optprop ).count()
+       << " s\n";
 }
 
 
@@ -44,8 +44,9 @@ namespace GZSTREAM_NAMESPACE {
 
 class gzstreambuf : public std::streambuf {
 private:
-    static const int bufferSize = 47+256;    // size of data buff
-    // totals 512 bytes under g++ for igzstream at the end.
+    static const int bufferSize = 4+65536;   // size of data buff
+    // large enough that gzread is not called for every few numbers when
+    // reading ASCII XML data.
 
     gzFile           file;               // file handle for compressed file
     char             buffer[bufferSize]; // data buffer
@@ -1,6 +1,7 @@
 #include "interactive_workspace.h"
 #include "global_data.h"
 #include "auto_workspace.h"
+#include "profiler.h"
 using global_data::md_data;
 
 extern Verbosity verbosity_at_launch;
@@ -12,9 +13,158 @@ Index get_wsv_id(const char*);
 
 size_t InteractiveWorkspace::n_anonymous_variables_ = 0;
 
+//! Check if a method can modify variables that are not among its outputs.
+/*!
+  Such methods take the workspace as argument and write to arbitrary
+  variables. They cannot be used on a workspace sharing data with other
+  workspaces, since it is unknown which variables need to be unshared.
+
+  \param m The method.
+  \return true for methods that modify any variable.
+*/
+static bool modifies_any_variable(const MdRecord &m)
+{
+    return m.Name() == "ReadWorkspaceSnapshot";
+}
+
+//! Throw if a method cannot be used on a shared workspace.
+/*!
+  Besides the methods modifying any variable, Exit is rejected. It
+  terminates the process and thereby all workspaces sharing the data.
+*/
+static void check_shared_method(const MdRecord &m)
+{
+    if (modifies_any_variable(m)) {
+        std::ostringstream os;
+        os << "Method " << m.Name() << " modifies arbitrary workspace "
+           << "variables and can not be used\n"
+           << "in a workspace sharing data with other workspaces.";
+        throw std::runtime_error(os.str());
+    }
+    if (m.Name() == "Exit") {
+        throw std::runtime_error(
+            "Method Exit terminates the process and can not be used\n"
+            "in a workspace sharing data with other workspaces.");
+    }
+}
+
+//! Check if a method can be run concurrently on different workspaces.
+/*!
+  File readers keep lookup tables in function-static variables that are
+  filled on first use, such as the species maps of
+  LineRecord::ReadFrom*Stream. All methods with Read in their name are
+  therefore treated as not reentrant.
+
+  \param m The method.
+  
+eturn false for methods that must not run concurrently.
+*/
+static bool is_reentrant_method(const MdRecord &m)
+{
+    return m.Name().find("Read") == String::npos;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Matpack types using memory owned by the caller of the C API.
+////////////////////////////////////////////////////////////////////////////
+// The memory is never freed or resized by ARTS: Workspace variables
+// holding these objects are replaced by a copy before they are modified,
+// see InteractiveWorkspace::unshare_variable.
+
+class ExternalVector : public Vector {
+public:
+    ExternalVector(Numeric *data, const long *n)
+    {
+        mrange = Range(0, n[0]);
+        mdata = data;
+    }
+    ~ExternalVector() { mdata = nullptr; }
+};
+
+class ExternalMatrix : public Matrix {
+public:
+    ExternalMatrix(Numeric *data, const long *n)
+    {
+        mrr = Range(0, n[0], n[1]);
+        mcr = Range(0, n[1]);
+        mdata = data;
+    }
+    ~ExternalMatrix() { mdata = nullptr; }
+};
+
+class ExternalTensor3 : public Tensor3 {
+public:
+    ExternalTensor3(Numeric *data, const long *n)
+    {
+        mpr = Range(0, n[0], n[1] * n[2]);
+        mrr = Range(0, n[1], n[2]);
+        mcr = Range(0, n[2]);
+        mdata = data;
+    }
+    ~ExternalTensor3() { mdata = nullptr; }
+};
+
+class ExternalTensor4 : public Tensor4 {
+public:
+    ExternalTensor4(Numeric *data, const long *n)
+    {
+        mbr = Range(0, n[0], n[1] * n[2] * n[3]);
+        mpr = Range(0, n[1], n[2] * n[3]);
+        mrr = Range(0, n[2], n[3]);
+        mcr = Range(0, n[3]);
+        mdata = data;
+    }
+    ~ExternalTensor4() { mdata = nullptr; }
+};
+
+class ExternalTensor5 : public Tensor5 {
+public:
+    ExternalTensor5(Numeric *data, const long *n)
+    {
+        msr = Range(0, n[0], n[1] * n[2] * n[3] * n[4]);
+        mbr = Range(0, n[1], n[2] * n[3] * n[4]);
+        mpr = Range(0, n[2], n[3] * n[4]);
+        mrr = Range(0, n[3], n[4]);
+        mcr = Range(0, n[4]);
+        mdata = data;
+    }
+    ~ExternalTensor5() { mdata = nullptr; }
+};
+
+class ExternalTensor6 : public Tensor6 {
+public:
+    ExternalTensor6(Numeric *data, const long *n)
+    {
+        mvr = Range(0, n[0], n[1] * n[2] * n[3] * n[4] * n[5]);
+        msr = Range(0, n[1], n[2] * n[3] * n[4] * n[5]);
+        mbr = Range(0, n[2], n[3] * n[4] * n[5]);
+        mpr = Range(0, n[3], n[4] * n[5]);
+        mrr = Range(0, n[4], n[5]);
+        mcr = Range(0, n[5]);
+        mdata = data;
+    }
+    ~ExternalTensor6() { mdata = nullptr; }
+};
+
+class ExternalTensor7 : public Tensor7 {
+public:
+    ExternalTensor7(Numeric *data, const long *n)
+    {
+        mlr = Range(0, n[0], n[1] * n[2] * n[3] * n[4] * n[5] * n[6]);
+        mvr = Range(0, n[1], n[2] * n[3] * n[4] * n[5] * n[6]);
+        msr = Range(0, n[2], n[3] * n[4] * n[5] * n[6]);
+        mbr = Range(0, n[3], n[4] * n[5] * n[6]);
+        mpr = Range(0, n[4], n[5] * n[6]);
+        mrr = Range(0, n[5], n[6]);
+        mcr = Range(0, n[6]);
+        mdata = data;
+    }
+    ~ExternalTensor7() { mdata = nullptr; }
+};
+
 InteractiveWorkspace::InteractiveWorkspace(const Index verbosity,
                                            const Index agenda_verbosity)
-        : Workspace()
+        : Workspace(), shared_(false)
 {
     Workspace::initialize();
     verbosity_at_launch.set_screen_verbosity(verbosity);
@@ -23,6 +173,14 @@ InteractiveWorkspace::InteractiveWorkspace(const Index verbosity,
     verbosity_at_launch.set_file_verbosity(0);
 }
 
+InteractiveWorkspace::InteractiveWorkspace(const InteractiveWorkspace &base)
+        : Workspace(base), shared_(true)
+{
+    Workspace::initialize();
+    // Agendas and workspace methods modify the verbosity settings.
+    unshare_variable(get_wsv_id("verbosity"));
+}
+
 void InteractiveWorkspace::initialize() {
     define_wsv_group_names();
     Workspace::define_wsv_data();
@@ -45,6 +203,7 @@ const char * InteractiveWorkspace::execute_agenda(const Agenda *a)
 {
     resize();
     try {
+        unshare_outputs(*a);
         a->execute(*this);
     } catch(const std::runtime_error &e) {
         string_buffer = e.what();
@@ -83,13 +242,25 @@ const char * InteractiveWorkspace::execute_workspace_method(long id,
     TokVal t{};
     Agenda a{};
     try {
+        if (shared_) {
+            check_shared_method(m);
+        }
         MRecord mr(id, output, input, t, a);
+        for (Index i : output) {
+            unshare_variable(i);
+        }
+        if (m.Name() == "Delete") {
+            for (Index i : input) {
+                unshare_variable(i);
+            }
+        }
         if (mr.isInternal()) {
             out3 << "- " + m.Name() + "\n";
         }
         else {
             out1 << "- " + m.Name() + "\n";
         }
+        ProfilerScope method_scope(m.Name(), false);
         getaways[id](*this, mr);
     } catch (const std::runtime_error &e) {
         string_buffer = e.what();
@@ -270,6 +441,163 @@ void InteractiveWorkspace::resize()
     std::swap(ws, ws_new);
 }
 
+void InteractiveWorkspace::execute(const Agenda &a)
+{
+    resize();
+    a.execute(*this);
+}
+
+void InteractiveWorkspace::unshare_variable(Index i)
+{
+    if (ws[i].size() && ws[i].top()->auto_allocated
+        && external_variables_.erase(ws[i].top()->wsv)) {
+        WsvStruct *wsvs = ws[i].top();
+        void *external = wsvs->wsv;
+        wsvs->wsv = wsmh.duplicate(wsv_data[i].Group(), external);
+        wsmh.deallocate(wsv_data[i].Group(), external);
+        return;
+    }
+
+    if (ws[i].size() != 1) return;
+
+    // Variables allocated by this workspace are never shared.
+    WsvStruct *wsvs = ws[i].top();
+    if (wsvs->wsv && !wsvs->auto_allocated) {
+        wsvs->wsv = wsmh.duplicate(wsv_data[i].Group(), wsvs->wsv);
+        wsvs->auto_allocated = true;
+    }
+}
+
+void InteractiveWorkspace::unshare_outputs(const Agenda &a)
+{
+    resize();
+    std::set<Index> visited;
+    for_each_method(a, visited, [this](const MRecord &mr) {
+        if (shared_) {
+            check_shared_method(md_data[mr.Id()]);
+        }
+
+        for (Index i : mr.Out()) {
+            unshare_variable(i);
+        }
+
+        // Delete frees the memory of its inputs.
+        if (md_data[mr.Id()].Name() == "Delete") {
+            for (Index i : mr.In()) {
+                unshare_variable(i);
+            }
+        }
+    });
+}
+
+bool InteractiveWorkspace::is_reentrant(const Agenda &a)
+{
+    resize();
+    bool reentrant = true;
+    std::set<Index> visited;
+    for_each_method(a, visited, [&reentrant](const MRecord &mr) {
+        if (!is_reentrant_method(md_data[mr.Id()])) {
+            reentrant = false;
+        }
+    });
+    return reentrant;
+}
+
+void InteractiveWorkspace::for_each_method(
+    const Agenda &a,
+    std::set<Index> &visited,
+    const std::function<void(const MRecord &)> &f)
+{
+    static const Index agenda_group = get_wsv_group_id("Agenda");
+    static const Index array_of_agenda_group =
+        get_wsv_group_id("ArrayOfAgenda");
+
+    for (const MRecord &mr : a.Methods()) {
+        f(mr);
+
+        for_each_method(mr.Tasks(), visited, f);
+
+        // Agendas passed to a method are executed on this workspace, too.
+        ArrayOfIndex args(mr.Out());
+        args.insert(args.end(), mr.In().begin(), mr.In().end());
+        for (Index i : args) {
+            const Index group = wsv_data[i].Group();
+            if ((group != agenda_group && group != array_of_agenda_group)
+                || !is_initialized(i) || !visited.insert(i).second) {
+                continue;
+            }
+            if (group == agenda_group) {
+                for_each_method(*reinterpret_cast<Agenda*>(operator[](i)),
+                                visited, f);
+            } else {
+                for (const Agenda &aa :
+                     *reinterpret_cast<ArrayOfAgenda*>(operator[](i))) {
+                    for_each_method(aa, visited, f);
+                }
+            }
+        }
+    }
+}
+
+bool InteractiveWorkspace::set_external_variable(Index id,
+                                                 Index group_id,
+                                                 const long *dimensions,
+                                                 Numeric *data)
+{
+    void *external;
+    const String &group = global_data::wsv_group_names[group_id];
+    if (group == "Vector") {
+        external = new ExternalVector(data, dimensions);
+    } else if (group == "Matrix") {
+        external = new ExternalMatrix(data, dimensions);
+    } else if (group == "Tensor3") {
+        external = new ExternalTensor3(data, dimensions);
+    } else if (group == "Tensor4") {
+        external = new ExternalTensor4(data, dimensions);
+    } else if (group == "Tensor5") {
+        external = new ExternalTensor5(data, dimensions);
+    } else if (group == "Tensor6") {
+        external = new ExternalTensor6(data, dimensions);
+    } else if (group == "Tensor7") {
+        external = new ExternalTensor7(data, dimensions);
+    } else {
+        return false;
+    }
+
+    resize();
+    if (ws[id].size() == 0) {
+        push(id, nullptr);
+    }
+
+    WsvStruct *wsvs = ws[id].top();
+    if (wsvs->auto_allocated && wsvs->wsv) {
+        external_variables_.erase(wsvs->wsv);
+        wsmh.deallocate(group_id, wsvs->wsv);
+    }
+    wsvs->wsv = external;
+    wsvs->auto_allocated = true;
+    wsvs->initialized = true;
+    external_variables_.insert(external);
+    return true;
+}
+
+void InteractiveWorkspace::release_external_variable(Index id, bool keep_value)
+{
+    if (id >= ws.nelem() || !ws[id].size()
+        || !external_variables_.count(ws[id].top()->wsv)) {
+        return;
+    }
+
+    if (keep_value) {
+        unshare_variable(id);
+    } else {
+        WsvStruct *wsvs = ws[id].top();
+        external_variables_.erase(wsvs->wsv);
+        wsmh.deallocate(wsv_data[id].Group(), wsvs->wsv);
+        wsvs->wsv = wsmh.allocate(wsv_data[id].Group());
+    }
+}
+
 Index InteractiveWorkspace::add_variable(Index group_id, const char *name)
 {
     if (wsv_data.size() != ws.size()) {
@@ -307,6 +635,7 @@ void InteractiveWorkspace::erase_variable(Index i, Index group_id)
         wsvs = ws[i].top();
         if (wsvs->auto_allocated && wsvs->wsv)
         {
+            external_variables_.erase(wsvs->wsv);
             wsmh.deallocate (group_id, wsvs->wsv);
         }
         delete (wsvs);
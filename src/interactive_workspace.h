@@ -30,6 +30,7 @@
 #ifndef INTERACTIVE_WORKSPACE_INCLUDED
 #define INTERACTIVE_WORKSPACE_INCLUDED
 
+#include <functional>
 #include "workspace_ng.h"
 #include "agenda_class.h"
 
@@ -39,6 +40,17 @@ public:
     InteractiveWorkspace(const Index verbosity= 1,
                          const Index agenda_verbosity = 0);
 
+    //! Create a workspace sharing the variables of another workspace.
+    /*!
+    The new workspace refers to the values of all variables initialized in
+    base without copying them. A shared variable is copied only when it is
+    about to be modified, see unshare_outputs. The base workspace must not
+    be modified or destroyed while workspaces sharing its data exist.
+
+    \param base The workspace holding the shared data.
+    */
+    InteractiveWorkspace(const InteractiveWorkspace &base);
+
     using Workspace::is_initialized;
     using Workspace::operator[];
 
@@ -74,6 +86,77 @@ public:
                              const int *outer_ptr);
     void resize();
 
+    //! Execute an agenda and throw on errors.
+    /*!
+    Unlike execute_agenda, this does not use the global error buffer and
+    can therefore be called from several threads on different workspaces.
+
+    \param a The agenda to execute.
+    */
+    void execute(const Agenda &a);
+
+    //! Give the workspace its own copy of a shared variable.
+    /*!
+    \param i Index of the variable.
+    */
+    void unshare_variable(Index i);
+
+    //! Unshare all variables an agenda can modify.
+    /*!
+    Unshares the outputs of all methods in the agenda, including the
+    methods of agendas that are passed to them and the variables freed by
+    Delete. Must be called before executing an agenda on a workspace
+    created from a shared base.
+
+    Throws a runtime_error if the workspace shares data and the agenda
+    contains a method that can modify any variable, such as
+    ReadWorkspaceSnapshot, or Exit.
+
+    \param a The agenda to be executed.
+    */
+    void unshare_outputs(const Agenda &a);
+
+    //! Check if an agenda can run concurrently with agendas of other workspaces.
+    /*!
+    An agenda is not reentrant if it, or an agenda passed to one of its
+    methods, calls a file reader. These keep lookup tables in static
+    variables that are filled on first use.
+
+    \param a The agenda to be executed.
+    \return false if the agenda must not run concurrently.
+    */
+    bool is_reentrant(const Agenda &a);
+
+    //! Let a variable use memory owned by the caller.
+    /*!
+    Sets the variable to a Vector, Matrix or Tensor3-7 whose data is the
+    given C-contiguous buffer. The buffer is not copied. ARTS never writes
+    to, resizes or frees the buffer: Before the variable is modified by a
+    workspace method or agenda, it is replaced by a copy. The buffer must
+    stay valid until then, or until release_external_variable is called
+    or the workspace is destroyed.
+
+    \param id Index of the variable.
+    \param group_id Index of the group of the variable.
+    \param dimensions Size of the buffer in each dimension.
+    \param data Pointer to the first element of the buffer.
+    \return false if variables of this group cannot use external memory.
+    */
+    bool set_external_variable(Index id,
+                               Index group_id,
+                               const long *dimensions,
+                               Numeric *data);
+
+    //! Stop using memory owned by the caller for a variable.
+    /*!
+    Does nothing if the variable does not use external memory.
+
+    \param id Index of the variable.
+    \param keep_value If true, the variable keeps a copy of the data,
+           otherwise it is reset to an empty object.
+    */
+    void release_external_variable(Index id, bool keep_value);
+
     //! Push a stack for a new variable to the workspace.
     /*!
     Registers a new variable with and adds a new stack to the given workspace.
@@ -106,7 +189,22 @@ public:
 
 private:
 
+    //! Call f for every method an agenda executes.
+    /*!
+    Includes the methods of agendas passed to its methods. Agenda variables
+    are only visited once.
+    */
+    void for_each_method(const Agenda &a,
+                         std::set<Index> &visited,
+                         const std::function<void(const MRecord &)> &f);
+
     static size_t     n_anonymous_variables_;
+
+    //! True if the workspace was created from a shared base.
+    bool shared_;
+
+    //! Variable objects that use memory owned by the caller.
+    std::set<const void *> external_variables_;
 };
 
 #endif // INTERACTIVE_WORKSPACE_INCLUDED
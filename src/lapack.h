@@ -104,6 +104,43 @@ extern "C" void zgetri_( int* n,
                          int* lwork,
                          int* info );
 
+//! Cholesky decomposition.
+/*!
+  Computes the Cholesky factorization of a real symmetric positive definite
+  matrix. See LAPACK reference.
+
+  \param[in] uplo 'U': Upper triangle of A is stored, 'L': Lower triangle.
+  \param[in] n The order of the matrix A.
+  \param[in,out] A On input the matrix A, on output the Cholesky factor.
+  \param[in] lda The leading dimension of the matrix A.
+  \param[out] info Integer indicating if operation was successful: 0 if success,
+  otherwise failure.
+*/
+extern "C" void dpotrf_( char *uplo,
+                         int *n,
+                         double *A,
+                         int *lda,
+                         int *info );
+
+//! Matrix inversion using Cholesky decomposition.
+/*!
+  Computes the inverse of a real symmetric positive definite matrix from its
+  Cholesky factorization computed by dpotrf_. Only the triangle given by uplo
+  is set on output. See LAPACK reference.
+
+  \param[in] uplo 'U': Upper triangle of A is stored, 'L': Lower triangle.
+  \param[in] n The order of the matrix A.
+  \param[in,out] A On input the Cholesky factor, on output the inverse of A.
+  \param[in] lda The leading dimension of the matrix A.
+  \param[out] info Integer indicating if operation was successful: 0 if success,
+  otherwise failure.
+*/
+extern "C" void dpotri_( char *uplo,
+                         int *n,
+                         double *A,
+                         int *lda,
+                         int *info );
+
 //! Optimal parameters for computation.
 /*!
   This function returns problem-dependent parameters for the computing
@@ -2525,3 +2525,108 @@ Numeric lsf(VectorView x, ConstMatrixView A, ConstVectorView y)
   return r*r;
 }
 
+
+
+/*!
+ *    Greedy selection of columns for a fit with non-negative weights
+ *    (orthogonal matching pursuit).
+ *
+ *    In each step, the column best correlated with the remaining residual
+ *    is added, and the weights of all selected columns are refitted by
+ *    least squares. Columns ending up with a non-positive weight are
+ *    dropped for good. Columns are only evaluated on demand, the matrix
+ *    holding all candidates is never formed.
+ *
+ *    \param  sel        Out: Indexes of the selected columns.
+ *    \param  w          Out: Weights of the selected columns.
+ *    \param  res        Out: Residual, b minus the fitted vector.
+ *    \param  b          In: Vector to fit.
+ *    \param  ncols      In: Number of candidate columns.
+ *    \param  nmax       In: Maximum number of columns to select.
+ *    \param  column     In: Fills a vector of length b.nelem() with the
+ *                       given column.
+ *    \param  converged  In: Returns true when the residual is small enough.
+ *                       At least one column is selected in any case.
+ */
+void nonneg_omp(
+        ArrayOfIndex&  sel,
+        Vector&        w,
+        Vector&        res,
+  ConstVectorView      b,
+  const Index&         ncols,
+  const Index&         nmax,
+  const std::function<void(VectorView, Index)>& column,
+  const std::function<bool(ConstVectorView)>&   converged )
+{
+  const Index M = b.nelem();
+
+  Vector a(M), anorm(ncols);
+  for( Index i=0; i<ncols; i++ )
+    {
+      column( a, i );
+      anorm[i] = sqrt( a * a );
+    }
+
+  ArrayOfIndex state( ncols, 0 );  // 0: free, 1: selected, 2: excluded
+  Matrix A;
+  sel.resize( 0 );
+  w.resize( 0 );
+  res = b;
+
+  while( sel.nelem() < nmax  &&  ( sel.nelem() == 0  ||  !converged( res ) ) )
+    {
+      Index   best = -1;
+      Numeric best_score = 0;
+      for( Index i=0; i<ncols; i++ )
+        {
+          if( state[i]  ||  anorm[i] == 0 )
+            continue;
+          column( a, i );
+          const Numeric score = ( a * res ) / anorm[i];
+          if( score > best_score )
+            {
+              best_score = score;
+              best       = i;
+            }
+        }
+      if( best < 0 )
+        break;
+
+      sel.push_back( best );
+      state[best] = 1;
+
+      while( sel.nelem() )
+        {
+          const Index K = sel.nelem();
+          A.resize( M, K );
+          for( Index k=0; k<K; k++ )
+            column( A(joker,k), sel[k] );
+          Matrix AtA( K, K );
+          Vector Atb( K );
+          mult( AtA, transpose(A), A );
+          mult( Atb, transpose(A), b );
+          w.resize( K );
+          solve( w, AtA, Atb );
+
+          Index kneg = -1;
+          for( Index k=0; k<K; k++ )
+            if( w[k] <= 0  &&  ( kneg < 0  ||  w[k] < w[kneg] ) )
+              kneg = k;
+          if( kneg < 0 )
+            break;
+
+          state[sel[kneg]] = 2;
+          sel.erase( sel.begin() + kneg );
+        }
+
+      res = b;
+      if( sel.nelem() )
+        {
+          Vector Aw( M );
+          mult( Aw, A, w );
+          res -= Aw;
+        }
+      else
+        w.resize( 0 );
+    }
+}
@@ -29,8 +29,10 @@
 #ifndef linalg_h
 #define linalg_h
 
+#include <functional>
 #include "matpackIII.h"
 #include "complex.h"
+#include "array.h"
 
 // LU decomposition
 void
@@ -167,4 +169,14 @@ void linreg(
 
 Numeric lsf(VectorView x, ConstMatrixView A, ConstVectorView y);
 
+void nonneg_omp(
+        ArrayOfIndex&  sel,
+        Vector&        w,
+        Vector&        res,
+  ConstVectorView      b,
+  const Index&         ncols,
+  const Index&         nmax,
+  const std::function<void(VectorView, Index)>& column,
+  const std::function<bool(ConstVectorView)>&   converged );
+
 #endif    // linalg_h
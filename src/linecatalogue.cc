@@ -0,0 +1,451 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   linecatalogue.cc
+
+  \brief  Indexed binary line catalogue.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "linecatalogue.h"
+#include "bifstream.h"
+#include "bofstream.h"
+#include "global_data.h"
+#include "arts_omp.h"
+
+
+static const char LCAT_MAGIC[] = "ARTSLCAT";
+static const Index LCAT_FORMAT_VERSION = 1;
+
+
+//! Write an Index as 8 byte integer
+static void lcat_put_index(bofstream& bof, const Index x)
+{
+  bof.writeInt(x, 8);
+}
+
+
+//! Read an Index written by lcat_put_index
+static Index lcat_get_index(bifstream& bif)
+{
+  return (Index)bif.readInt(8);
+}
+
+
+//! Throw if a read from the catalogue failed
+static void lcat_check_stream(bifstream& bif, const String& filename)
+{
+  if (bif.fail() || bif.error())
+    {
+      ostringstream os;
+      os << "Error reading indexed line catalogue " << filename << ".\n"
+         << "The file is truncated or corrupt.";
+      throw runtime_error(os.str());
+    }
+}
+
+
+//! Write an indexed line catalogue
+/*!
+  All lines must have the same ARTSCAT version.
+
+  \param filename   Name of the catalogue file
+  \param lines      Lines to store
+  \param verbosity  Verbosity
+*/
+void write_indexed_line_catalogue(const String& filename,
+                                  const ArrayOfLineRecord& lines,
+                                  const Verbosity& verbosity)
+{
+  CREATE_OUT2;
+  using global_data::species_data;
+
+  const Index nlines = lines.nelem();
+  const Index catalog_version = nlines ? lines[0].Version()
+                                       : LineRecord().Version();
+
+  for (Index i = 0; i < nlines; i++)
+    if (lines[i].Version() != catalog_version)
+      {
+        ostringstream os;
+        os << "The lines contain a mixture of ARTS catalog versions (ARTSCAT-"
+           << catalog_version << " and ARTSCAT-" << lines[i].Version()
+           << ").\nConvert them to the same version first.";
+        throw runtime_error(os.str());
+      }
+
+  // Sort by species, then by frequency
+  ArrayOfIndex order(nlines);
+  for (Index i = 0; i < nlines; i++) order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+                   [&lines](const Index a, const Index b) {
+                     if (lines[a].Species() != lines[b].Species())
+                       return lines[a].Species() < lines[b].Species();
+                     return lines[a].F() < lines[b].F();
+                   });
+
+  // Species directory
+  ArrayOfIndex dir_species, dir_first, dir_count;
+  for (Index i = 0; i < nlines; i++)
+    {
+      const Index s = lines[order[i]].Species();
+      if (!dir_species.nelem() || dir_species[dir_species.nelem()-1] != s)
+        {
+          dir_species.push_back(s);
+          dir_first.push_back(i);
+          dir_count.push_back(0);
+        }
+      dir_count[dir_count.nelem()-1]++;
+    }
+
+  // Records in ARTSCAT text form
+  String records;
+  ArrayOfIndex offsets(nlines + 1);
+  for (Index i = 0; i < nlines; i++)
+    {
+      ostringstream os;
+      os << lines[order[i]] << '\n';
+      offsets[i] = (Index)records.length();
+      records += os.str();
+    }
+  offsets[nlines] = (Index)records.length();
+
+  bofstream bof(filename.c_str());
+  if (!bof.good())
+    {
+      ostringstream os;
+      os << "Cannot open indexed line catalogue " << filename
+         << " for writing.";
+      throw runtime_error(os.str());
+    }
+
+  bof.putRaw(LCAT_MAGIC, 8);
+  lcat_put_index(bof, LCAT_FORMAT_VERSION);
+  lcat_put_index(bof, catalog_version);
+  lcat_put_index(bof, nlines);
+
+  lcat_put_index(bof, dir_species.nelem());
+  for (Index s = 0; s < dir_species.nelem(); s++)
+    {
+      const String& name = species_data[dir_species[s]].Name();
+      lcat_put_index(bof, name.nelem());
+      bof.putRaw(name.data(), name.nelem());
+      lcat_put_index(bof, dir_first[s]);
+      lcat_put_index(bof, dir_count[s]);
+    }
+
+  for (Index i = 0; i < nlines; i++)
+    bof << lines[order[i]].F();
+  for (Index i = 0; i <= nlines; i++)
+    lcat_put_index(bof, offsets[i]);
+
+  bof.putRaw(records.data(), (streamsize)records.length());
+
+  out2 << "  Wrote " << nlines << " lines of " << dir_species.nelem()
+       << " species to " << filename << ".\n";
+}
+
+
+//! Read lines from an indexed line catalogue
+/*!
+  Only the index entries of the requested species are read. For each of
+  them, the records inside the frequency range are located by binary
+  search in the frequency index and read as one block.
+
+  \param lines      Returned lines
+  \param filename   Name of the catalogue file
+  \param species    Species indices to read. Empty to read all species.
+  \param fmin       Lowest frequency
+  \param fmax       Highest frequency
+  \param verbosity  Verbosity
+*/
+void read_indexed_line_catalogue(ArrayOfLineRecord& lines,
+                                 const String& filename,
+                                 const ArrayOfIndex& species,
+                                 const Numeric fmin,
+                                 const Numeric fmax,
+                                 const Verbosity& verbosity)
+{
+  CREATE_OUT2;
+  using global_data::species_data;
+
+  bifstream bif(filename.c_str());
+  if (!bif.good())
+    {
+      ostringstream os;
+      os << "Cannot open indexed line catalogue " << filename << ".";
+      throw runtime_error(os.str());
+    }
+
+  char magic[8];
+  bif.getRaw(magic, 8);
+  if (!bif.good() || strncmp(magic, LCAT_MAGIC, 8))
+    {
+      ostringstream os;
+      os << filename << " is not an indexed line catalogue.";
+      throw runtime_error(os.str());
+    }
+
+  const Index format_version = lcat_get_index(bif);
+  if (format_version != LCAT_FORMAT_VERSION)
+    {
+      ostringstream os;
+      os << "Unsupported indexed line catalogue version " << format_version
+         << " in " << filename << ".";
+      throw runtime_error(os.str());
+    }
+
+  const Index catalog_version = lcat_get_index(bif);
+  const Index nlines = lcat_get_index(bif);
+  const Index nspecies = lcat_get_index(bif);
+  lcat_check_stream(bif, filename);
+
+  if (catalog_version < 3 || catalog_version > 5 || nlines < 0
+      || nspecies < 0)
+    {
+      ostringstream os;
+      os << "Corrupt header in indexed line catalogue " << filename << ".";
+      throw runtime_error(os.str());
+    }
+
+  ArrayOfString dir_name(nspecies);
+  ArrayOfIndex dir_first(nspecies), dir_count(nspecies);
+  for (Index s = 0; s < nspecies; s++)
+    {
+      const Index len = lcat_get_index(bif);
+      lcat_check_stream(bif, filename);
+      if (len < 0 || len > 1024)
+        {
+          ostringstream os;
+          os << "Corrupt species directory in indexed line catalogue "
+             << filename << ".";
+          throw runtime_error(os.str());
+        }
+      String name(len);
+      bif.getRaw(&name[0], len);
+      dir_name[s] = name;
+      dir_first[s] = lcat_get_index(bif);
+      dir_count[s] = lcat_get_index(bif);
+    }
+  lcat_check_stream(bif, filename);
+
+  const streampos freq_pos = bif.tellg();
+  const streampos offset_pos = freq_pos + (streamoff)(8 * nlines);
+  const streampos record_pos = offset_pos + (streamoff)(8 * (nlines + 1));
+
+  // Select the directory entries to read
+  ArrayOfIndex selected;
+  for (Index s = 0; s < nspecies; s++)
+    {
+      bool wanted = !species.nelem();
+      for (Index i = 0; !wanted && i < species.nelem(); i++)
+        wanted = (species_data[species[i]].Name() == dir_name[s]);
+      if (wanted) selected.push_back(s);
+    }
+
+  lines.resize(0);
+
+  for (Index k = 0; k < selected.nelem(); k++)
+    {
+      const Index s = selected[k];
+      if (!dir_count[s]) continue;
+
+      Vector f(dir_count[s]);
+      bif.seekg(freq_pos + (streamoff)(8 * dir_first[s]));
+      bif.readDoubleArray(f.get_c_array(), dir_count[s]);
+      lcat_check_stream(bif, filename);
+
+      const Numeric* fb = f.get_c_array();
+      const Index i0 = std::lower_bound(fb, fb + dir_count[s], fmin) - fb;
+      const Index i1 = std::upper_bound(fb, fb + dir_count[s], fmax) - fb;
+      if (i1 <= i0) continue;
+
+      bif.seekg(offset_pos + (streamoff)(8 * (dir_first[s] + i0)));
+      const Index off0 = lcat_get_index(bif);
+      bif.seekg(offset_pos + (streamoff)(8 * (dir_first[s] + i1)));
+      const Index off1 = lcat_get_index(bif);
+      lcat_check_stream(bif, filename);
+
+      String records(off1 - off0);
+      bif.seekg(record_pos + (streamoff)off0);
+      bif.getRaw(&records[0], off1 - off0);
+      lcat_check_stream(bif, filename);
+
+      istringstream is(records);
+      for (Index i = i0; i < i1; i++)
+        {
+          LineRecord lr;
+          bool failed = true;
+          switch (catalog_version)
+            {
+            case 3:
+              failed = lr.ReadFromArtscat3Stream(is, verbosity);
+              break;
+            case 4:
+              failed = lr.ReadFromArtscat4Stream(is, verbosity);
+              break;
+            case 5:
+              failed = lr.ReadFromArtscat5Stream(is, verbosity);
+              break;
+            }
+          if (failed)
+            {
+              ostringstream os;
+              os << "Error reading line " << dir_first[s] + i << " of species "
+                 << dir_name[s] << " from indexed line catalogue "
+                 << filename << ".";
+              throw runtime_error(os.str());
+            }
+          lines.push_back(std::move(lr));
+        }
+    }
+
+  out2 << "  Read " << lines.nelem() << " out of " << nlines
+       << " lines from " << filename << ".\n";
+}
+
+
+//! Parse the records of a text catalogue in parallel
+/*!
+  The stream is read in blocks of whole lines. Each block is split at line
+  boundaries into one chunk per thread, the chunks are parsed in parallel
+  into separate arrays, and these are appended to the result in file
+  order. Thus, the result is identical to reading the records one by one.
+
+  The record readers initialise static lookup tables (species and
+  isotopologue indices) on their first call. To keep this out of the
+  parallel region, the reader is called once on an empty stream before.
+
+  \param lines        Returned lines with fmin <= F <= fmax
+  \param nrecords     Returned number of records parsed, including the ones
+                      outside the frequency range
+  \param is           Input stream
+  \param read_record  Reader for a single record
+  \param fmin         Lowest frequency
+  \param fmax         Highest frequency
+  \param sorted       If true, the records are sorted by frequency and
+                      reading stops after the first record above fmax
+  \param xml_content  If true, reading stops at a line starting with '<'
+                      (the closing XML tag), which is left in the stream
+*/
+void read_line_records_parallel(ArrayOfLineRecord& lines,
+                                Index& nrecords,
+                                istream& is,
+                                const LineRecordReader& read_record,
+                                const Numeric fmin,
+                                const Numeric fmax,
+                                const bool sorted,
+                                const bool xml_content)
+{
+  // Size of a text block, and smallest number of lines per thread
+  const size_t block_size = 1 << 24;
+  const Index min_chunk_lines = 1000;
+
+  {
+    istringstream empty;
+    LineRecord lr;
+    read_record(lr, empty);
+  }
+
+  lines.resize(0);
+  nrecords = 0;
+
+  bool done = false;
+  String block;
+  String line;
+  ArrayOfIndex line_start;
+
+  while (!done)
+    {
+      block.clear();
+      line_start.resize(0);
+      while (block.length() < block_size)
+        {
+          if (xml_content)
+            {
+              int c;
+              while ((c = is.peek()) == ' ' || c == '\t') is.get();
+              if (c == '<') { done = true; break; }
+            }
+          if (!getline(is, line)) { done = true; break; }
+          line_start.push_back((Index)block.length());
+          block += line;
+          block += '\n';
+        }
+
+      const Index nblock_lines = line_start.nelem();
+      if (!nblock_lines) break;
+
+      Index nchunks = min((Index)arts_omp_get_max_threads(),
+                          nblock_lines / min_chunk_lines + 1);
+      if (arts_omp_in_parallel()) nchunks = 1;
+
+      ArrayOfIndex chunk_start(nchunks + 1);
+      for (Index c = 0; c < nchunks; c++)
+        chunk_start[c] = line_start[nblock_lines * c / nchunks];
+      chunk_start[nchunks] = (Index)block.length();
+
+      Array<ArrayOfLineRecord> chunk_lines(nchunks);
+      ArrayOfIndex chunk_nrecords(nchunks, 0);
+      ArrayOfString chunk_error(nchunks);
+      Vector chunk_last_f(nchunks, -1.);
+
+#pragma omp parallel for if (nchunks > 1)
+      for (Index c = 0; c < nchunks; c++)
+        {
+          try
+            {
+              istringstream ics(block.substr(chunk_start[c],
+                                             chunk_start[c+1]
+                                             - chunk_start[c]));
+              while (true)
+                {
+                  LineRecord lr;
+                  if (read_record(lr, ics)) break;
+                  chunk_nrecords[c]++;
+                  if (lr.F() >= 0) chunk_last_f[c] = lr.F();
+                  if (fmin <= lr.F() && lr.F() <= fmax)
+                    chunk_lines[c].push_back(std::move(lr));
+                }
+            }
+          catch (const std::runtime_error& e)
+            {
+              chunk_error[c] = e.what();
+            }
+        }
+
+      for (Index c = 0; c < nchunks; c++)
+        {
+          if (chunk_error[c].nelem())
+            {
+              ostringstream os;
+              os << chunk_error[c] << "\n"
+                 << "Error parsing record " << nrecords + chunk_nrecords[c] + 1
+                 << " of the catalogue.";
+              throw runtime_error(os.str());
+            }
+          nrecords += chunk_nrecords[c];
+          lines.insert(lines.end(),
+                       std::make_move_iterator(chunk_lines[c].begin()),
+                       std::make_move_iterator(chunk_lines[c].end()));
+          if (sorted && chunk_last_f[c] > fmax) done = true;
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   linecatalogue.h
+
+  \brief  Indexed binary line catalogue.
+
+  The catalogue stores the lines of an ArrayOfLineRecord sorted by species
+  and frequency, together with an index that allows to load the lines of a
+  species inside a frequency range with a seek and a single read, without
+  parsing the rest of the catalogue.
+
+  File layout (all integers 8 bytes, all floats IEEE-754 doubles, little
+  endian):
+
+  - Magic string "ARTSLCAT" and format version
+  - ARTSCAT version of the records and total number of lines
+  - Species directory: number of species, then for each species its name,
+    the index of its first line and its number of lines
+  - Line frequencies, sorted by frequency within each species
+  - Byte offsets of the line records in the record block (nlines+1)
+  - Record block with the lines in ARTSCAT text form
+
+  Keeping the records in their ARTSCAT representation guarantees that a
+  round trip through the catalogue is lossless for all line data that
+  ARTS knows about.
+
+  This file also provides read_line_records_parallel, which parses text
+  catalogues (HITRAN, ARTSCAT) in parallel.
+*/
+
+#ifndef linecatalogue_h
+#define linecatalogue_h
+
+#include <functional>
+#include "absorption.h"
+#include "messages.h"
+
+
+/** Reads a single record from a text catalogue stream.
+
+    Must return true if the end of the stream was reached without reading
+    a record, like the LineRecord::ReadFrom...Stream functions. */
+typedef std::function<bool(LineRecord&, istream&)> LineRecordReader;
+
+
+void write_indexed_line_catalogue(const String& filename,
+                                  const ArrayOfLineRecord& lines,
+                                  const Verbosity& verbosity);
+
+void read_indexed_line_catalogue(ArrayOfLineRecord& lines,
+                                 const String& filename,
+                                 const ArrayOfIndex& species,
+                                 const Numeric fmin,
+                                 const Numeric fmax,
+                                 const Verbosity& verbosity);
+
+void read_line_records_parallel(ArrayOfLineRecord& lines,
+                                Index& nrecords,
+                                istream& is,
+                                const LineRecordReader& read_record,
+                                const Numeric fmin,
+                                const Numeric fmax,
+                                const bool sorted,
+                                const bool xml_content);
+
+#endif /* linecatalogue_h */
@@ -1352,7 +1352,8 @@ bool LineRecord::ReadFromHitran2004Stream(istream& is, const Verbosity& verbosit
           else
             {
               // See if this is already in warned_missing, use
-              // std::count for that:
+              // std::count for that. Lines can be parsed in parallel.
+#pragma omp critical (LineRecord_ReadFromHitran2004Stream_warned_missing)
               if ( 0 == std::count(warned_missing.begin(),
                                    warned_missing.end(),
                                    mo) )
@@ -51,6 +51,7 @@
 #include "rte.h"
 #include "xml_io.h"
 #include "jacobian.h"
+#include "linecatalogue.h"
 
 #ifdef ENABLE_NETCDF
 #include <netcdf.h>
@@ -325,39 +326,19 @@ void abs_linesReadFromHitran(// WS Output:
 
     out2 << "  Reading file: " << filename << "\n";
     open_input_file(is, filename);
-    
-    bool go_on = true;
-    Index linenr = 0;
-    while ( go_on )
-    {
-        linenr++;
-        try {
-            LineRecord lr;
-            if ( lr.ReadFromHitran2004Stream(is, verbosity, fmin) )
-            {
-                // If we are here the read function has reached eof and has
-                // returned no data.
-                go_on = false;
-            }
-            else
-            {
-                if ( fmin <= lr.F() )
-                {
-                    if ( lr.F() <= fmax )
-                        abs_lines.push_back(std::move(lr));
-                    else
-                        go_on = false;
-                }
-            }
-        }
-        catch (const std::runtime_error &e)
-        {
-            ostringstream os;
-            os << e.what() << "\n";
-            os << "Error parsing line " << linenr << " from catalog.\n";
-            throw runtime_error(os.str());
-        }
-    }
+
+    // The catalogue is sorted by frequency, so parsing stops after the
+    // first line above fmax. Lines below fmin are flagged by the reader
+    // with a negative frequency and dropped.
+    Index nrecords;
+    read_line_records_parallel(abs_lines, nrecords, is,
+                               [&verbosity, fmin](LineRecord& lr, istream& s)
+                               {
+                                 return lr.ReadFromHitran2004Stream(s, verbosity,
+                                                                    fmin);
+                               },
+                               fmin, fmax, true, false);
+
     out2 << "  Read " << abs_lines.nelem() << " lines.\n";
 }
 
@@ -545,6 +526,53 @@ void abs_linesReadFromSplitArtscat(// WS Output:
 }
 
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void abs_linesWriteIndexedCatalogue(// WS Input:
+                                    const ArrayOfLineRecord& abs_lines,
+                                    // Control Parameters:
+                                    const String& filename,
+                                    const Verbosity& verbosity)
+{
+  write_indexed_line_catalogue(filename, abs_lines, verbosity);
+}
+
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void abs_linesReadFromIndexedCatalogue(// WS Output:
+                                       ArrayOfLineRecord& abs_lines,
+                                       const ArrayOfArrayOfSpeciesTag& abs_species,
+                                       // Control Parameters:
+                                       const String& filename,
+                                       const Numeric& fmin,
+                                       const Numeric& fmax,
+                                       const Verbosity& verbosity)
+{
+  // Build a set of species indices. Duplicates are ignored.
+  set<Index> unique_species;
+  for (ArrayOfArrayOfSpeciesTag::const_iterator asp = abs_species.begin();
+       asp != abs_species.end(); asp++)
+    for (ArrayOfSpeciesTag::const_iterator sp = asp->begin();
+         sp != asp->end(); sp++)
+    {
+      if (sp->Type()==SpeciesTag::TYPE_PLAIN ||
+          sp->Type()==SpeciesTag::TYPE_ZEEMAN) {
+          unique_species.insert(sp->Species());
+      }
+    }
+
+  abs_lines.resize(0);
+  if (!unique_species.size())
+    return;
+
+  ArrayOfIndex species;
+  for (set<Index>::const_iterator it = unique_species.begin();
+       it != unique_species.end(); it++)
+    species.push_back(*it);
+  read_indexed_line_catalogue(abs_lines, filename, species, fmin, fmax,
+                              verbosity);
+}
+
+
 //! Obsolete old ARTS catalogue reading function
 /*!
   This function is for the old ARTS catalogue format without XML
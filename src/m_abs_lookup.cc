@@ -39,6 +39,7 @@
 #include "math_funcs.h"
 #include "arts_omp.h"
 #include "interpolation_poly.h"
+#include "profiler.h"
 #include "rng.h"
 #include "absorption.h"
 #include "global_data.h"
@@ -398,6 +399,7 @@ void abs_lookupCalc(// Workspace reference:
           // function. Anyway, shared is the correct setting for
           // abs_lookup, so there is no problem.
 
+          ProfilerParallel profiler_parallel;
 #pragma omp parallel for                                      \
   if (!arts_omp_in_parallel()                                 \
       && these_t_pert_nelem >= arts_omp_get_max_threads())    \
@@ -405,6 +407,8 @@ void abs_lookupCalc(// Workspace reference:
   firstprivate(l_ws, l_abs_xsec_agenda)
           for ( Index j=0; j<these_t_pert_nelem; ++j )
             {
+              ProfilerWorker profiler_worker(profiler_parallel);
+
               // Skip remaining iterations if an error occurred
               if (failed) continue;
 
@@ -48,6 +48,7 @@ using namespace std;
 #include "auto_md.h"
 #include "math_funcs.h"
 #include "physics_funcs.h"
+#include "profiler.h"
 #include "rte.h"
 #include "xml_io.h"
 
@@ -135,6 +136,7 @@ void ybatchCalc(Workspace&      ws,
 
     // Go through the batch:
 
+    ProfilerParallel profiler_parallel;
     if (ybatch_n)
 #pragma omp parallel for       \
   schedule(dynamic)            \
@@ -145,6 +147,8 @@ void ybatchCalc(Workspace&      ws,
         ybatch_index<ybatch_n;
         ybatch_index++ )
     {
+        ProfilerWorker profiler_worker(profiler_parallel);
+
         Index l_job_counter;      // Thread-local copy of job counter.
 
         if (do_abort) continue;
@@ -923,11 +923,21 @@ void ScatSpeciesScatAndMetaRead (//WS Output:
                                  ArrayOfArrayOfScatteringMetaData& scat_meta,
                                  // Keywords:
                                  const ArrayOfString& scat_data_files,
+                                 const Numeric& fmin,
+                                 const Numeric& fmax,
                                  const Verbosity& verbosity)
 {
   CREATE_OUT2;
   CREATE_OUT3;
 
+  if( fmin > fmax )
+    {
+      ostringstream os;
+      os << "*fmin* (" << fmin << ") must not be larger than *fmax* ("
+         << fmax << ").";
+      throw runtime_error( os.str() );
+    }
+
   //--- Reading the data ---------------------------------------------------
   ArrayOfSingleScatteringData arr_ssd;
   ArrayOfScatteringMetaData arr_smd;
@@ -940,7 +950,9 @@ void ScatSpeciesScatAndMetaRead (//WS Output:
   for ( Index i = 0; i < 1 && i < scat_data_files.nelem(); i++ )
     {
       out3 << "  Read single scattering data file " << scat_data_files[i] << "\n";
-      xml_read_from_file ( scat_data_files[i], arr_ssd[i], verbosity );
+      xml_read_single_scattering_data_from_file ( scat_data_files[i],
+                                                  arr_ssd[i], fmin, fmax,
+                                                  verbosity );
 
       // make meta data name from scat data name
       ArrayOfString strarr;
@@ -1013,7 +1025,10 @@ shared(out3, scat_data_files, arr_ssd, arr_smd)
 
       try {
         out3 << "  Read single scattering data file " << scat_data_files[i] << "\n";
-        xml_read_from_file ( scat_data_files[i], ssd, verbosity );
+        // Frequencies not needed are skipped while reading, the complete
+        // data of an element are never held in memory
+        xml_read_single_scattering_data_from_file ( scat_data_files[i], ssd,
+                                                    fmin, fmax, verbosity );
 
         scat_data_files[i].split ( strarr, ".xml" );
         scat_meta_file = strarr[0]+".meta.xml";
@@ -55,6 +55,7 @@
 #include "m_general.h"
 #include "physics_funcs.h"
 #include "ppath.h"
+#include "profiler.h"
 #include "rte.h"
 #include "special_interp.h"
 #include "wsv_aux.h"
@@ -2848,11 +2849,14 @@ void DoitCalc(
       String fail_msg;
       bool failed = false;
 
+      ProfilerParallel profiler_parallel;
 #pragma omp parallel for                                    \
 if(!arts_omp_in_parallel() && nf>1)                       \
 firstprivate(l_ws, l_doit_mono_agenda)
       for (Index f_index = 0; f_index < nf; f_index ++)
       {
+          ProfilerWorker profiler_worker(profiler_parallel);
+
           if (failed)
           {
               doit_i_field(f_index, joker, joker, joker, joker, joker, joker) = NAN;
@@ -29,6 +29,7 @@
 #include "legendre.h"
 #include "math_funcs.h"
 #include "sorting.h"
+#include "lin_alg.h"
 
 /*!
   \file   M_fluxes.cc
@@ -46,6 +47,47 @@ extern const Numeric PI;
 extern const Numeric DEG2RAD;
 
 
+/*===========================================================================
+  === Help functions
+  ===========================================================================*/
+
+//! irradiance_signature
+/*!
+  Collects the broadband-relevant part of the irradiance field of a single
+  frequency into a vector. The vector holds the irradiance in both
+  directions at all positions, followed by the net flux differences between
+  adjacent pressure levels (these determine the heating rates). The two
+  blocks are scaled with the given factors.
+
+  \param a                  Output vector. Must have the correct size.
+  \param irradiance         Irradiance field of one frequency.
+  \param scale_flux         Scaling factor for the irradiance block.
+  \param scale_dnet         Scaling factor for the net flux difference block.
+*/
+void irradiance_signature(
+        VectorView a,
+        ConstTensor4View irradiance,
+        const Numeric &scale_flux,
+        const Numeric &scale_dnet)
+{
+    Index m = 0;
+
+    for (Index b = 0; b < irradiance.nbooks(); b++)
+        for (Index p = 0; p < irradiance.npages(); p++)
+            for (Index r = 0; r < irradiance.nrows(); r++)
+                for (Index c = 0; c < irradiance.ncols(); c++)
+                    a[m++] = scale_flux * irradiance(b, p, r, c);
+
+    for (Index b = 0; b < irradiance.nbooks() - 1; b++)
+        for (Index p = 0; p < irradiance.npages(); p++)
+            for (Index r = 0; r < irradiance.nrows(); r++)
+                a[m++] = scale_dnet * (irradiance(b + 1, p, r, 0) + irradiance(b + 1, p, r, 1) -
+                                       irradiance(b, p, r, 0) - irradiance(b, p, r, 1));
+
+    assert(m == a.nelem());
+}
+
+
 /*===========================================================================
   === The functions
   ===========================================================================*/
@@ -564,4 +606,247 @@ void heating_ratesFromIrradiance(
 
         }
     }
-}
\ No newline at end of file
+}
+
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void f_gridRepresentativeFromIrradiance(
+        Vector &f_grid,
+        Vector &f_weights,
+        const Vector &p_grid,
+        const Tensor5 &spectral_irradiance_field,
+        const Tensor3 &specific_heat_capacity,
+        const Numeric &g0,
+        const Index &nf_reduced,
+        const Numeric &rel_tol,
+        const Verbosity &verbosity)
+{
+    CREATE_OUT1;
+
+    const Index nf = f_grid.nelem();
+    const Index np = spectral_irradiance_field.nbooks();
+    const Index nlat = spectral_irradiance_field.npages();
+    const Index nlon = spectral_irradiance_field.nrows();
+
+    if (nf != spectral_irradiance_field.nshelves())
+    {
+        throw runtime_error("The length of f_grid does not match with\n"
+                            " the first dimension of the spectral_irradiance_field");
+    }
+    if (nf < 2)
+    {
+        throw runtime_error("The reference f_grid must have at least two points.");
+    }
+    if (spectral_irradiance_field.ncols() != 2)
+    {
+        throw runtime_error("The last dimension of spectral_irradiance_field must\n"
+                            "have size 2 (downward and upward irradiance).");
+    }
+    if (np < 3 || p_grid.nelem() != np)
+    {
+        throw runtime_error("The pressure dimension of spectral_irradiance_field must\n"
+                            "match *p_grid* and have at least three levels.");
+    }
+    if (specific_heat_capacity.npages() != np ||
+        specific_heat_capacity.nrows() != nlat ||
+        specific_heat_capacity.ncols() != nlon)
+    {
+        throw runtime_error("The size of *specific_heat_capacity* does not match\n"
+                            "with the spatial dimensions of spectral_irradiance_field.");
+    }
+    if (nf_reduced < 1)
+    {
+        throw runtime_error("*nf_reduced* must be > 0.");
+    }
+
+    // Trapezoidal weights of the reference calculation, matching
+    // RadiationFieldSpectralIntegrate.
+    Vector wq(nf, 0.);
+    for (Index i = 0; i < nf - 1; i++)
+    {
+        const Numeric df = f_grid[i + 1] - f_grid[i];
+        wq[i] += df / 2;
+        wq[i + 1] += df / 2;
+    }
+
+    // Broadband target (unscaled)
+    const Index nflux = np * nlat * nlon * 2;
+    const Index M = nflux + (np - 1) * nlat * nlon;
+    Vector a(M), b(M, 0.);
+    for (Index i = 0; i < nf; i++)
+    {
+        irradiance_signature(a, spectral_irradiance_field(i, joker, joker, joker, joker), 1., 1.);
+        for (Index m = 0; m < M; m++)
+            b[m] += wq[i] * a[m];
+    }
+
+    // Scale the irradiance and net flux difference blocks to unit RMS, so
+    // both have the same importance in the fit.
+    Numeric scale_flux = sqrt(b[Range(0, nflux)] * b[Range(0, nflux)] / Numeric(nflux));
+    Numeric scale_dnet = sqrt(b[Range(nflux, M - nflux)] * b[Range(nflux, M - nflux)] /
+                              Numeric(M - nflux));
+    scale_flux = scale_flux > 0 ? 1. / scale_flux : 1.;
+    scale_dnet = scale_dnet > 0 ? 1. / scale_dnet : 1.;
+    b[Range(0, nflux)] *= scale_flux;
+    b[Range(nflux, M - nflux)] *= scale_dnet;
+
+    // Greedy selection, see nonneg_omp. Stops when the residual is below
+    // rel_tol of the target.
+    const Numeric bnorm = sqrt(b * b);
+    ArrayOfIndex sel;
+    Vector w, res;
+    nonneg_omp(sel, w, res, b, nf, min(nf_reduced, nf),
+               [&](VectorView col, Index i) {
+                   irradiance_signature(col,
+                                        spectral_irradiance_field(i, joker, joker, joker, joker),
+                                        scale_flux, scale_dnet);
+               },
+               [&](ConstVectorView r) { return sqrt(r * r) <= rel_tol * bnorm; });
+
+    if (!sel.nelem())
+    {
+        throw runtime_error("No representative frequencies could be selected.\n"
+                            "Is spectral_irradiance_field all zero?");
+    }
+
+    // Output, sorted by frequency
+    const Index K = sel.nelem();
+    ArrayOfIndex order;
+    get_sorted_indexes(order, sel);
+    Vector f_grid_full = f_grid;
+    f_grid.resize(K);
+    f_weights.resize(K);
+    for (Index k = 0; k < K; k++)
+    {
+        f_grid[k] = f_grid_full[sel[order[k]]];
+        f_weights[k] = w[order[k]];
+    }
+
+    // Error report against the full (reference) calculation
+    Tensor4 irr_full(np, nlat, nlon, 2, 0.);
+    Tensor4 irr_red(np, nlat, nlon, 2, 0.);
+    for (Index i = 0; i < nf; i++)
+    {
+        Tensor4 irr_i = spectral_irradiance_field(i, joker, joker, joker, joker);
+        irr_i *= wq[i];
+        irr_full += irr_i;
+    }
+    for (Index k = 0; k < K; k++)
+    {
+        Tensor4 irr_k = spectral_irradiance_field(sel[order[k]], joker, joker, joker, joker);
+        irr_k *= f_weights[k];
+        irr_red += irr_k;
+    }
+
+    Tensor3 hr_full, hr_red;
+    heating_ratesFromIrradiance(hr_full, p_grid, irr_full, specific_heat_capacity, g0, verbosity);
+    heating_ratesFromIrradiance(hr_red, p_grid, irr_red, specific_heat_capacity, g0, verbosity);
+
+    Numeric irr_max = 0, irr_err = 0, hr_max = 0, hr_err = 0;
+    for (Index l = 0; l < np; l++)
+        for (Index p = 0; p < nlat; p++)
+            for (Index r = 0; r < nlon; r++)
+            {
+                for (Index c = 0; c < 2; c++)
+                {
+                    irr_max = max(irr_max, abs(irr_full(l, p, r, c)));
+                    irr_err = max(irr_err, abs(irr_red(l, p, r, c) - irr_full(l, p, r, c)));
+                }
+                hr_max = max(hr_max, abs(hr_full(l, p, r)));
+                hr_err = max(hr_err, abs(hr_red(l, p, r) - hr_full(l, p, r)));
+            }
+
+    out1 << "  Selected " << K << " representative frequencies out of " << nf
+         << " (reduction factor " << Numeric(nf) / Numeric(K) << ").\n"
+         << "  Errors against the reference calculation:\n"
+         << "    max irradiance error:   " << irr_err << " W/m2 ("
+         << (irr_max > 0 ? 1e2 * irr_err / irr_max : 0) << "% of max irradiance)\n"
+         << "    max heating rate error: " << hr_err * 86400 << " K/day ("
+         << "max heating rate " << hr_max * 86400 << " K/day)\n"
+         << "    relative fit residual:  " << sqrt(res * res) / bnorm << "\n";
+}
+
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void RadiationFieldSpectralWeightedSum(
+        Tensor4 &radiation_field,
+        const Vector &f_grid,
+        const Tensor5 &spectral_radiation_field,
+        const Vector &f_weights,
+        const Verbosity &)
+{
+    if (f_grid.nelem() != spectral_radiation_field.nshelves() ||
+        f_weights.nelem() != f_grid.nelem())
+    {
+        throw runtime_error("The length of f_grid and f_weights must match with\n"
+                            " the first dimension of the spectral_radiation_field");
+    }
+
+    //allocate
+    radiation_field.resize(spectral_radiation_field.nbooks(), spectral_radiation_field.npages(),
+                           spectral_radiation_field.nrows(), spectral_radiation_field.ncols());
+    radiation_field = 0;
+
+    // frequency summation
+    for (Index i = 0; i < spectral_radiation_field.nshelves(); i++)
+    {
+        for (Index b = 0; b < radiation_field.nbooks(); b++)
+        {
+            for (Index p = 0; p < radiation_field.npages(); p++)
+            {
+                for (Index r = 0; r < radiation_field.nrows(); r++)
+                {
+                    for (Index c = 0; c < radiation_field.ncols(); c++)
+                    {
+                        radiation_field(b, p, r, c) += f_weights[i] * spectral_radiation_field(i, b, p, r, c);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void RadiationFieldSpectralWeightedSum(
+        Tensor5 &radiation_field,
+        const Vector &f_grid,
+        const Tensor7 &spectral_radiation_field,
+        const Vector &f_weights,
+        const Verbosity &)
+{
+    if (f_grid.nelem() != spectral_radiation_field.nlibraries() ||
+        f_weights.nelem() != f_grid.nelem())
+    {
+        throw runtime_error("The length of f_grid and f_weights must match with\n"
+                            " the first dimension of the spectral_radiation_field");
+    }
+
+    //allocate
+    radiation_field.resize(spectral_radiation_field.nvitrines(), spectral_radiation_field.nshelves(),
+                           spectral_radiation_field.nbooks(), spectral_radiation_field.npages(),
+                           spectral_radiation_field.nrows());
+    radiation_field = 0;
+
+    // frequency summation
+    for (Index i = 0; i < spectral_radiation_field.nlibraries(); i++)
+    {
+        for (Index s = 0; s < radiation_field.nshelves(); s++)
+        {
+            for (Index b = 0; b < radiation_field.nbooks(); b++)
+            {
+                for (Index p = 0; p < radiation_field.npages(); p++)
+                {
+                    for (Index r = 0; r < radiation_field.nrows(); r++)
+                    {
+                        for (Index c = 0; c < radiation_field.ncols(); c++)
+                        {
+                            radiation_field(s, b, p, r, c) +=
+                                    f_weights[i] * spectral_radiation_field(i, s, b, p, r, c, 0);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
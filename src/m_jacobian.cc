@@ -42,6 +42,7 @@
 #include <string>
 #include "absorption.h"
 #include "arts.h"
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "cloudbox.h"
@@ -50,6 +51,7 @@
 #include "interpolation_poly.h"
 #include "jacobian.h"
 #include "physics_funcs.h"
+#include "profiler.h"
 #include "rte.h"
 #include "m_xml.h"
 
@@ -545,111 +547,143 @@ void jacobianCalcAbsSpeciesPerturbations(
 
   // Loop through the retrieval grid and calculate perturbation effect
   //
+  // The perturbations are independent and are done in parallel. Each thread
+  // works on its own copy of the workspace and of the perturbed field (i.e.
+  // memory use grows with the number of threads, not with the number of
+  // perturbations), while the unperturbed fields and *yb* are shared.
+  //
   const Index    n1y = sensor_response.nrows();
-        Vector   dy( n1y ); 
   const Range    rowind = get_rowindex_for_mblock( sensor_response, mblock_index ); 
+  const Index    npert = j_lon * j_lat * j_p;
   //
-  for( Index lon_it=0; lon_it<j_lon; lon_it++ )
+  // We have to make a local copy of the Workspace and the agendas because
+  // only non-reference types can be declared firstprivate in OpenMP
+  Workspace l_ws (ws);
+  Agenda l_iy_main_agenda (iy_main_agenda);
+  Agenda l_geo_pos_agenda (geo_pos_agenda);
+  Tensor4 vmr_p (vmr_field);
+
+  String fail_msg;
+  bool failed = false;
+
+  ProfilerParallel profiler_parallel;
+#pragma omp parallel for                                    \
+if(!arts_omp_in_parallel() && npert>1)                    \
+firstprivate(l_ws, l_iy_main_agenda, l_geo_pos_agenda, vmr_p)
+  for( Index ipert=0; ipert<npert; ipert++ )
     {
-      for( Index lat_it=0; lat_it<j_lat; lat_it++ )
+      ProfilerWorker profiler_worker(profiler_parallel);
+
+      // Skip remaining iterations if an error occurred
+      if (failed) continue;
+
+      // Same order as looping lon, lat and p (innermost)
+      const Index lon_it = ipert / ( j_lat * j_p );
+      const Index lat_it = ( ipert / j_p ) % j_lat;
+      const Index p_it   = ipert % j_p;
+
+      try
         {
-          for (Index p_it=0; p_it<j_p; p_it++)
-            {
-              // Here we calculate the ranges of the perturbation. We want the
-              // perturbation to continue outside the atmospheric grids for the
-              // edge values.
-              Range p_range   = Range(0,0);
-              Range lat_range = Range(0,0);
-              Range lon_range = Range(0,0);
+          // Here we calculate the ranges of the perturbation. We want the
+          // perturbation to continue outside the atmospheric grids for the
+          // edge values.
+          Range p_range   = Range(0,0);
+          Range lat_range = Range(0,0);
+          Range lon_range = Range(0,0);
 
-              get_perturbation_range( p_range, p_it, j_p );
+          get_perturbation_range( p_range, p_it, j_p );
 
-              if( atmosphere_dim>=2 )
+          if( atmosphere_dim>=2 )
+            {
+              get_perturbation_range( lat_range, lat_it, j_lat );
+              if( atmosphere_dim == 3 )
                 {
-                  get_perturbation_range( lat_range, lat_it, j_lat );
-                  if( atmosphere_dim == 3 )
-                    {
-                      get_perturbation_range( lon_range, lon_it, j_lon );
-                    }
+                  get_perturbation_range( lon_range, lon_it, j_lon );
                 }
+            }
 
-              // Create VMR field to perturb
-              Tensor4 vmr_p = vmr_field;
+          // Create VMR field to perturb
+          vmr_p = vmr_field;
                               
-              // If perturbation given in ND convert the vmr-field to ND before
-              // the perturbation is added          
-              if( rq.Mode() == "nd" )
-                vmr_p(si,joker,joker,joker) *= nd_field;
+          // If perturbation given in ND convert the vmr-field to ND before
+          // the perturbation is added          
+          if( rq.Mode() == "nd" )
+            vmr_p(si,joker,joker,joker) *= nd_field;
         
-              // Calculate the perturbed field according to atmosphere_dim, 
-              // the number of perturbations is the length of the retrieval 
-              // grid +2 (for the end points)
-              switch (atmosphere_dim)
-                {
-                case 1:
-                  {
-                    // Here we perturb a vector
-                    perturbation_field_1d( vmr_p(si,joker,lat_it,lon_it), 
-                                           p_gp, jg[0].nelem()+2, p_range, 
-                                           rq.Perturbation(), pertmode );
-                    break;
-                  }
-                case 2:
-                  {
-                    // Here we perturb a matrix
-                    perturbation_field_2d( vmr_p(si,joker,joker,lon_it),
-                                           p_gp, lat_gp, jg[0].nelem()+2, 
-                                           jg[1].nelem()+2, p_range, lat_range, 
-                                           rq.Perturbation(), pertmode );
-                    break;
-                  }    
-                case 3:
-                  {  
-                    // Here we need to perturb a tensor3
-                    perturbation_field_3d( vmr_p(si,joker,joker,joker), 
-                                           p_gp, lat_gp, lon_gp, 
-                                           jg[0].nelem()+2,
-                                           jg[1].nelem()+2, jg[2].nelem()+2, 
-                                           p_range, lat_range, lon_range, 
-                                           rq.Perturbation(), pertmode );
-                    break;
-                  }
-                }
+          // Calculate the perturbed field according to atmosphere_dim, 
+          // the number of perturbations is the length of the retrieval 
+          // grid +2 (for the end points)
+          switch (atmosphere_dim)
+            {
+            case 1:
+              {
+                // Here we perturb a vector
+                perturbation_field_1d( vmr_p(si,joker,lat_it,lon_it), 
+                                       p_gp, jg[0].nelem()+2, p_range, 
+                                       rq.Perturbation(), pertmode );
+                break;
+              }
+            case 2:
+              {
+                // Here we perturb a matrix
+                perturbation_field_2d( vmr_p(si,joker,joker,lon_it),
+                                       p_gp, lat_gp, jg[0].nelem()+2, 
+                                       jg[1].nelem()+2, p_range, lat_range, 
+                                       rq.Perturbation(), pertmode );
+                break;
+              }    
+            case 3:
+              {  
+                // Here we need to perturb a tensor3
+                perturbation_field_3d( vmr_p(si,joker,joker,joker), 
+                                       p_gp, lat_gp, lon_gp, 
+                                       jg[0].nelem()+2,
+                                       jg[1].nelem()+2, jg[2].nelem()+2, 
+                                       p_range, lat_range, lon_range, 
+                                       rq.Perturbation(), pertmode );
+                break;
+              }
+            }
 
-              // If perturbation given in ND convert back to VMR          
-              if (rq.Mode()=="nd")
-                vmr_p(si,joker,joker,joker) /= nd_field;
+          // If perturbation given in ND convert back to VMR          
+          if (rq.Mode()=="nd")
+            vmr_p(si,joker,joker,joker) /= nd_field;
         
-              // Calculate the perturbed spectrum  
-              //
-              Vector        iybp;
-              ArrayOfVector dummy3;      
-              ArrayOfMatrix dummy4;
-              Matrix        dummy5;
-              //
-              iyb_calc( ws, iybp, dummy3, dummy4, dummy5, mblock_index, 
-                        atmosphere_dim, t_field, z_field,
-                        vmr_p, nlte_field, cloudbox_on, 
-                        stokes_dim, f_grid, sensor_pos, sensor_los, 
-                        transmitter_pos, mblock_dlos_grid, 
-                        iy_unit, iy_main_agenda, geo_pos_agenda,
-                        0, ArrayOfRetrievalQuantity(), 
-                        ArrayOfArrayOfIndex(), ArrayOfString(), verbosity );
-              //
-              mult( dy, sensor_response, iybp );
-
-              // Difference spectrum
-              for( Index i=0; i<n1y; i++ )
-                { dy[i] = ( dy[i]- yb[i] ) / rq.Perturbation(); }
-
-              // Put into jacobian
-              jacobian(rowind,it) = dy;     
-
-              // Result from next loop shall go into next column of J
-              it++;
-            }
+          // Calculate the perturbed spectrum  
+          //
+          Vector        iybp;
+          ArrayOfVector dummy3;      
+          ArrayOfMatrix dummy4;
+          Matrix        dummy5;
+          //
+          iyb_calc( l_ws, iybp, dummy3, dummy4, dummy5, mblock_index, 
+                    atmosphere_dim, t_field, z_field,
+                    vmr_p, nlte_field, cloudbox_on, 
+                    stokes_dim, f_grid, sensor_pos, sensor_los, 
+                    transmitter_pos, mblock_dlos_grid, 
+                    iy_unit, l_iy_main_agenda, l_geo_pos_agenda,
+                    0, ArrayOfRetrievalQuantity(), 
+                    ArrayOfArrayOfIndex(), ArrayOfString(), verbosity );
+          //
+          Vector dy( n1y ); 
+          mult( dy, sensor_response, iybp );
+
+          // Difference spectrum
+          for( Index i=0; i<n1y; i++ )
+            { dy[i] = ( dy[i]- yb[i] ) / rq.Perturbation(); }
+
+          // Put into jacobian. Each perturbation has its own column of J.
+          jacobian(rowind,it+ipert) = dy;     
+        }
+      catch (const std::runtime_error &e)
+        {
+#pragma omp critical (jacobianCalcAbsSpeciesPerturbations_fail)
+          { fail_msg = e.what(); failed = true; }
         }
     }
+
+  if( failed )
+    throw runtime_error( fail_msg );
 }
 
 
@@ -2191,113 +2225,145 @@ void jacobianCalcTemperaturePerturbations(
         }
     }
 
-  // Local copy of z_field. 
-  Tensor3 z = z_field;
-
   // Loop through the retrieval grid and calculate perturbation effect
   //
+  // Done in parallel, see jacobianCalcAbsSpeciesPerturbations. Each thread
+  // has its own perturbed temperature field and, for HSE, altitude field.
+  //
   const Index    n1y = sensor_response.nrows();
-        Vector   dy( n1y ); 
   const Range    rowind = get_rowindex_for_mblock( sensor_response, mblock_index ); 
+  const Index    npert = j_lon * j_lat * j_p;
   //
-  for( Index lon_it=0; lon_it<j_lon; lon_it++ )
+  // We have to make a local copy of the Workspace and the agendas because
+  // only non-reference types can be declared firstprivate in OpenMP
+  Workspace l_ws (ws);
+  Agenda l_iy_main_agenda (iy_main_agenda);
+  Agenda l_geo_pos_agenda (geo_pos_agenda);
+  Agenda l_g0_agenda (g0_agenda);
+  Tensor3 t_p (t_field);
+  Tensor3 z (z_field);
+
+  String fail_msg;
+  bool failed = false;
+
+  ProfilerParallel profiler_parallel;
+#pragma omp parallel for                                    \
+if(!arts_omp_in_parallel() && npert>1)                    \
+firstprivate(l_ws, l_iy_main_agenda, l_geo_pos_agenda, l_g0_agenda, t_p, z)
+  for( Index ipert=0; ipert<npert; ipert++ )
     {
-      for( Index lat_it=0; lat_it<j_lat; lat_it++ )
+      ProfilerWorker profiler_worker(profiler_parallel);
+
+      // Skip remaining iterations if an error occurred
+      if (failed) continue;
+
+      // Same order as looping lon, lat and p (innermost)
+      const Index lon_it = ipert / ( j_lat * j_p );
+      const Index lat_it = ( ipert / j_p ) % j_lat;
+      const Index p_it   = ipert % j_p;
+
+      try
         {
-          for( Index p_it=0; p_it<j_p; p_it++ )
+          // Perturbed temperature field
+          t_p = t_field;
+
+          // Here we calculate the ranges of the perturbation. We want the
+          // perturbation to continue outside the atmospheric grids for the
+          // edge values.
+          Range p_range   = Range(0,0);
+          Range lat_range = Range(0,0);
+          Range lon_range = Range(0,0);
+          get_perturbation_range( p_range, p_it, j_p );
+          if( atmosphere_dim >= 2 )
             {
-              // Perturbed temperature field
-              Tensor3 t_p = t_field;
-
-              // Here we calculate the ranges of the perturbation. We want the
-              // perturbation to continue outside the atmospheric grids for the
-              // edge values.
-              Range p_range   = Range(0,0);
-              Range lat_range = Range(0,0);
-              Range lon_range = Range(0,0);
-              get_perturbation_range( p_range, p_it, j_p );
-              if( atmosphere_dim >= 2 )
+              get_perturbation_range( lat_range, lat_it, j_lat );
+              if( atmosphere_dim == 3 )
                 {
-                  get_perturbation_range( lat_range, lat_it, j_lat );
-                  if( atmosphere_dim == 3 )
-                    {
-                      get_perturbation_range( lon_range, lon_it, j_lon );
-                    }
+                  get_perturbation_range( lon_range, lon_it, j_lon );
                 }
+            }
                            
-              // Calculate the perturbed field according to atmosphere_dim, 
-              // the number of perturbations is the length of the retrieval 
-              // grid +2 (for the end points)
-              switch (atmosphere_dim)
-                {
-                case 1:
-                  {
-                    // Here we perturb a vector
-                    perturbation_field_1d( t_p(joker,lat_it,lon_it), 
-                                           p_gp, jg[0].nelem()+2, p_range, 
-                                           rq.Perturbation(), pertmode );
-                    break;
-                  }
-                case 2:
-                  {
-                    // Here we perturb a matrix
-                    perturbation_field_2d( t_p(joker,joker,lon_it), 
-                                           p_gp, lat_gp, jg[0].nelem()+2, 
-                                           jg[1].nelem()+2, p_range, lat_range, 
-                                           rq.Perturbation(), pertmode );
-                    break;
-                  }    
-                case 3:
-                  {  
-                    // Here we need to perturb a tensor3
-                    perturbation_field_3d( t_p(joker,joker,joker), p_gp, 
-                                           lat_gp, lon_gp, jg[0].nelem()+2,
-                                           jg[1].nelem()+2, jg[2].nelem()+2, 
-                                           p_range, lat_range, lon_range, 
-                                           rq.Perturbation(), pertmode );
-                    break;
-                  }
-                }
+          // Calculate the perturbed field according to atmosphere_dim, 
+          // the number of perturbations is the length of the retrieval 
+          // grid +2 (for the end points)
+          switch (atmosphere_dim)
+            {
+            case 1:
+              {
+                // Here we perturb a vector
+                perturbation_field_1d( t_p(joker,lat_it,lon_it), 
+                                       p_gp, jg[0].nelem()+2, p_range, 
+                                       rq.Perturbation(), pertmode );
+                break;
+              }
+            case 2:
+              {
+                // Here we perturb a matrix
+                perturbation_field_2d( t_p(joker,joker,lon_it), 
+                                       p_gp, lat_gp, jg[0].nelem()+2, 
+                                       jg[1].nelem()+2, p_range, lat_range, 
+                                       rq.Perturbation(), pertmode );
+                break;
+              }    
+            case 3:
+              {  
+                // Here we need to perturb a tensor3
+                perturbation_field_3d( t_p(joker,joker,joker), p_gp, 
+                                       lat_gp, lon_gp, jg[0].nelem()+2,
+                                       jg[1].nelem()+2, jg[2].nelem()+2, 
+                                       p_range, lat_range, lon_range, 
+                                       rq.Perturbation(), pertmode );
+                break;
+              }
+            }
 
-              // Apply HSE, if selected
-              if( rq.Subtag() == "HSE on" )
-                {
-                  z_fieldFromHSE( ws,z, atmosphere_dim, p_grid, lat_grid, 
-                                  lon_grid, lat_true, lon_true, abs_species, 
-                                  t_p, vmr_field, refellipsoid, z_surface, 1,
-                                  g0_agenda, molarmass_dry_air, 
-                                  p_hse, z_hse_accuracy, verbosity );
-                }
-       
-              // Calculate the perturbed spectrum  
-              Vector        iybp;
-              ArrayOfVector dummy3;      
-              ArrayOfMatrix dummy4;
-              Matrix        dummy5;
-              //
-              iyb_calc( ws, iybp, dummy3, dummy4, dummy5, mblock_index, 
-                        atmosphere_dim, t_p, z,
-                        vmr_field, nlte_field, cloudbox_on, 
-                        stokes_dim, f_grid, sensor_pos, sensor_los, 
-                        transmitter_pos, mblock_dlos_grid, 
-                        iy_unit, iy_main_agenda, geo_pos_agenda,
-                        0, ArrayOfRetrievalQuantity(), 
-                        ArrayOfArrayOfIndex(), ArrayOfString(), verbosity );
-              //
-              mult( dy, sensor_response, iybp );
-
-              // Difference spectrum
-              for( Index i=0; i<n1y; i++ )
-                { dy[i] = ( dy[i]- yb[i] ) / rq.Perturbation(); }
-
-              // Put into jacobian
-              jacobian(rowind,it) = dy;     
-
-              // Result from next loop shall go into next column of J
-              it++;
+          // Apply HSE, if selected. Always start from the unperturbed
+          // altitudes, to make the result independent of the order of the
+          // perturbations.
+          if( rq.Subtag() == "HSE on" )
+            {
+              z = z_field;
+              z_fieldFromHSE( l_ws, z, atmosphere_dim, p_grid, lat_grid, 
+                              lon_grid, lat_true, lon_true, abs_species, 
+                              t_p, vmr_field, refellipsoid, z_surface, 1,
+                              l_g0_agenda, molarmass_dry_air, 
+                              p_hse, z_hse_accuracy, verbosity );
             }
+       
+          // Calculate the perturbed spectrum  
+          Vector        iybp;
+          ArrayOfVector dummy3;      
+          ArrayOfMatrix dummy4;
+          Matrix        dummy5;
+          //
+          iyb_calc( l_ws, iybp, dummy3, dummy4, dummy5, mblock_index, 
+                    atmosphere_dim, t_p, z,
+                    vmr_field, nlte_field, cloudbox_on, 
+                    stokes_dim, f_grid, sensor_pos, sensor_los, 
+                    transmitter_pos, mblock_dlos_grid, 
+                    iy_unit, l_iy_main_agenda, l_geo_pos_agenda,
+                    0, ArrayOfRetrievalQuantity(), 
+                    ArrayOfArrayOfIndex(), ArrayOfString(), verbosity );
+          //
+          Vector dy( n1y ); 
+          mult( dy, sensor_response, iybp );
+
+          // Difference spectrum
+          for( Index i=0; i<n1y; i++ )
+            { dy[i] = ( dy[i]- yb[i] ) / rq.Perturbation(); }
+
+          // Put into jacobian. Each perturbation has its own column of J.
+          jacobian(rowind,it+ipert) = dy;     
+        }
+      catch (const std::runtime_error &e)
+        {
+#pragma omp critical (jacobianCalcTemperaturePerturbations_fail)
+          { fail_msg = e.what(); failed = true; }
         }
     }
+
+  if( failed )
+    throw runtime_error( fail_msg );
 }
 
 
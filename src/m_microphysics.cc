@@ -896,6 +896,411 @@ void pnd_fieldCalcFromParticleBulkProps(
    
                            
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void pnd_fieldCalcFromBulkTable(
+         Tensor4&                     pnd_field,
+         ArrayOfTensor4&              dpnd_field_dx,
+   const Index&                       atmosphere_dim,
+   const Vector&                      p_grid,
+   const Vector&                      lat_grid,
+   const Vector&                      lon_grid,
+   const Index&                       cloudbox_on,
+   const ArrayOfIndex&                cloudbox_limits,
+   const ArrayOfString&               scat_species,
+   const ArrayOfArrayOfSingleScatteringData& scat_data,
+   const Tensor4&                     particle_bulkprop_field,
+   const ArrayOfString&               particle_bulkprop_names,
+   const ArrayOfArrayOfString&        pnd_agenda_array_input_names,
+   const Index&                       jacobian_do,
+   const ArrayOfRetrievalQuantity&    jacobian_quantities,
+   const Vector&                      bulk_grid,
+   const Verbosity& )
+{
+  // Do nothing if cloudbox is inactive
+  if( !cloudbox_on )
+    { return; }
+
+  if( particle_bulkprop_field.empty() )
+      throw runtime_error( "*particle_bulkprop_field* is empty." );
+
+  chk_if_in_range( "atmosphere_dim", atmosphere_dim, 1, 3 );
+  chk_atm_grids( atmosphere_dim, p_grid, lat_grid, lon_grid );
+  chk_atm_field( "particle_bulkprop_field", particle_bulkprop_field,
+                 atmosphere_dim, particle_bulkprop_names.nelem(),
+                 p_grid, lat_grid, lon_grid );
+  if( cloudbox_limits.nelem() != 2*atmosphere_dim )
+    throw runtime_error( "Length of *cloudbox_limits* incorrect with respect "
+                         "to *atmosphere_dim*." );
+
+  const Index nss = scat_data.nelem();
+  const Index nb  = bulk_grid.nelem();
+
+  if( nss < 1 )
+    throw runtime_error( "*scat_data* is empty!." );
+  if( scat_species.nelem() != nss )
+    throw runtime_error( "*scat_data* and *scat_species* are inconsistent in size." );
+  if( pnd_agenda_array_input_names.nelem() != nss )
+    throw runtime_error( "*scat_data* and *pnd_agenda_array_input_names* are "
+                         "inconsistent in size." );
+  if( nb < 1 )
+    throw runtime_error( "*bulk_grid* must contain at least one value." );
+  if( bulk_grid[0] <= 0  ||  !is_increasing( bulk_grid ) )
+    throw runtime_error( "*bulk_grid* must be positive and strictly "
+                         "increasing." );
+
+  // Effective lengths of cloudbox
+  const Index np = cloudbox_limits[1] - cloudbox_limits[0] + 1;
+  const Index ip_offset = cloudbox_limits[0];
+  Index nlat = 1;
+  Index ilat_offset = 0;
+  if( atmosphere_dim > 1 )
+    {
+      nlat = cloudbox_limits[3] - cloudbox_limits[2] + 1;
+      ilat_offset = cloudbox_limits[2];
+    }
+  Index nlon = 1;
+  Index ilon_offset = 0;
+  if( atmosphere_dim > 2 )
+    {
+      nlon = cloudbox_limits[5] - cloudbox_limits[4] + 1;
+      ilon_offset = cloudbox_limits[4];
+    }
+
+  // Bulk property of each species
+  ArrayOfIndex i_pbulkprop(nss);
+  for( Index is=0; is<nss; is++ )
+    {
+      if( scat_data[is].nelem() != nb )
+        {
+          ostringstream os;
+          os << "Scattering species " << is << " has " << scat_data[is].nelem()
+             << " elements, but *bulk_grid* has " << nb << " values.\n"
+             << "Has *ScatSpeciesBulkTableCalc* been applied with the "
+             << "same *bulk_grid*?";
+          throw runtime_error( os.str() );
+        }
+      if( pnd_agenda_array_input_names[is].nelem() != 1 )
+        throw runtime_error( "Bulk property tables require exactly one "
+                             "input to each pnd-agenda." );
+      i_pbulkprop[is] = find_first( particle_bulkprop_names,
+                                    pnd_agenda_array_input_names[is][0] );
+      if( i_pbulkprop[is] < 0 )
+        {
+          ostringstream os;
+          os << "Pnd-agenda with index " << is << " is set to require \""
+             << pnd_agenda_array_input_names[is][0] << "\",\nbut this quantity "
+             << "could not found in *particle_bulkprop_names*.";
+          throw runtime_error(os.str());
+        }
+    }
+
+  // Allocate output variables
+  pnd_field.resize( nss*nb, np, nlat, nlon );
+  pnd_field = 0.0;
+  //
+  ArrayOfIndex jq_to_scatspecies;
+  if( !jacobian_do )
+    { dpnd_field_dx.resize(0); }
+  else
+    {
+      const Index nq = jacobian_quantities.nelem();
+      dpnd_field_dx.resize( nq );
+      jq_to_scatspecies.resize( nq );
+      for( Index iq=0; iq<nq; iq++ )
+        {
+          jq_to_scatspecies[iq] = -1;
+          if( jacobian_quantities[iq].MainTag() == SCATSPECIES_MAINTAG  )
+            {
+              const Index ihit = find_first( scat_species,
+                                             jacobian_quantities[iq].Subtag() );
+              if( ihit < 0 )
+                {
+                  ostringstream os;
+                  os << "Jacobian quantity with index " << iq << " refers to\n"
+                     << "  " << jacobian_quantities[iq].Subtag()
+                     << "\nbut this species could not be found in *scat_species*.";
+                  throw runtime_error(os.str());
+                }
+              if( jacobian_quantities[iq].SubSubtag() !=
+                  pnd_agenda_array_input_names[ihit][0] )
+                {
+                  ostringstream os;
+                  os << "Jacobian quantity with index " << iq << " refers to\n"
+                     << "  " << jacobian_quantities[iq].SubSubtag()
+                     << "\nbut only derivatives with respect to the table "
+                     << "parameter (" << pnd_agenda_array_input_names[ihit][0]
+                     << ") are possible.";
+                  throw runtime_error(os.str());
+                }
+              jq_to_scatspecies[iq] = ihit;
+              dpnd_field_dx[iq].resize( nss*nb, np, nlat, nlon );
+              dpnd_field_dx[iq] = 0.0;
+            }
+        }
+    }
+
+  // The bulk properties are interpolated linearly in log(x) between the
+  // table nodes after normalisation by the node values, i.e. the pnd of
+  // node k is x*w_k/x_k. Below the first node, properties are scaled
+  // linearly with x.
+  Matrix pnd_b( nss, nb ), dpnd_b( nss, nb );
+  for( Index ilon=0; ilon<nlon; ilon++ )
+    for( Index ilat=0; ilat<nlat; ilat++ )
+      for( Index ip=0; ip<np; ip++ )
+        {
+          pnd_b  = 0.0;
+          dpnd_b = 0.0;
+          for( Index is=0; is<nss; is++ )
+            {
+              const Numeric x = particle_bulkprop_field( i_pbulkprop[is],
+                                                         ip_offset   + ip,
+                                                         ilat_offset + ilat,
+                                                         ilon_offset + ilon );
+              if( x < 0 )
+                {
+                  ostringstream os;
+                  os << "Negative value of \""
+                     << pnd_agenda_array_input_names[is][0]
+                     << "\" found, which can not be mapped to the bulk "
+                     << "property table.";
+                  throw runtime_error( os.str() );
+                }
+              if( x > bulk_grid[nb-1] )
+                {
+                  ostringstream os;
+                  os << "Value of \"" << pnd_agenda_array_input_names[is][0]
+                     << "\" (" << x << ") is above the end of *bulk_grid* ("
+                     << bulk_grid[nb-1] << ").";
+                  throw runtime_error( os.str() );
+                }
+
+              if( x <= bulk_grid[0] )
+                {
+                  pnd_b(is,0)  = x / bulk_grid[0];
+                  dpnd_b(is,0) = 1 / bulk_grid[0];
+                }
+              else
+                {
+                  Index k = 0;
+                  while( bulk_grid[k+1] < x )
+                    { k++; }
+                  const Numeric l  = log( bulk_grid[k+1] / bulk_grid[k] );
+                  const Numeric w1 = log( x / bulk_grid[k] ) / l;
+                  const Numeric w0 = 1 - w1;
+                  pnd_b(is,k)    = x * w0 / bulk_grid[k];
+                  pnd_b(is,k+1)  = x * w1 / bulk_grid[k+1];
+                  dpnd_b(is,k)   = ( w0 - 1 / l ) / bulk_grid[k];
+                  dpnd_b(is,k+1) = ( w1 + 1 / l ) / bulk_grid[k+1];
+                }
+
+              pnd_field(Range(is*nb,nb),ip,ilat,ilon) = pnd_b(is,joker);
+            }
+
+          for( Index iq=0; iq<jq_to_scatspecies.nelem(); iq++ )
+            {
+              const Index is = jq_to_scatspecies[iq];
+              if( is >= 0 )
+                { dpnd_field_dx[iq](Range(is*nb,nb),ip,ilat,ilon) =
+                                                        dpnd_b(is,joker); }
+            }
+        }
+}
+
+
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void ScatSpeciesBulkTableCalc(
+         Workspace&                   ws,
+         ArrayOfArrayOfSingleScatteringData& scat_data,
+         ArrayOfArrayOfScatteringMetaData&   scat_meta,
+   const ArrayOfAgenda&               pnd_agenda_array,
+   const ArrayOfArrayOfString&        pnd_agenda_array_input_names,
+   const Vector&                      bulk_grid,
+   const Vector&                      T_grid,
+   const Verbosity&                   verbosity )
+{
+  CREATE_OUT2;
+
+  const Index nss = scat_data.nelem();
+  const Index nb  = bulk_grid.nelem();
+  const Index nt  = T_grid.nelem();
+
+  if( nss < 1 )
+    throw runtime_error( "*scat_data* is empty!." );
+  if( scat_meta.nelem() != nss )
+    throw runtime_error( "*scat_data* and *scat_meta* are inconsistent in size." );
+  if( pnd_agenda_array.nelem() != nss )
+    throw runtime_error( "*scat_data* and *pnd_agenda_array* are inconsistent "
+                         "in size." );
+  if( pnd_agenda_array_input_names.nelem() != nss )
+    throw runtime_error( "*scat_data* and *pnd_agenda_array_input_names* are "
+                         "inconsistent in size." );
+  if( nb < 1  ||  bulk_grid[0] <= 0  ||  !is_increasing( bulk_grid ) )
+    throw runtime_error( "*bulk_grid* must be non-empty, positive and "
+                         "strictly increasing." );
+  if( nt < 1  ||  !is_increasing( T_grid ) )
+    throw runtime_error( "*T_grid* must be non-empty and strictly "
+                         "increasing." );
+
+  ArrayOfArrayOfSingleScatteringData scat_data_table( nss );
+  ArrayOfArrayOfScatteringMetaData   scat_meta_table( nss );
+
+  for( Index is=0; is<nss; is++ )
+    {
+      if( pnd_agenda_array_input_names[is].nelem() != 1 )
+        {
+          ostringstream os;
+          os << "Pnd-agenda with index " << is << " has "
+             << pnd_agenda_array_input_names[is].nelem() << " inputs, but "
+             << "bulk property tables can only be derived for a single "
+             << "input (beside temperature).";
+          throw runtime_error( os.str() );
+        }
+
+      const Index nse = scat_data[is].nelem();
+      if( nse < 1 )
+        throw runtime_error( "A scattering species without elements found." );
+
+      // All elements must share ptype and grids (besides T_grid)
+      const SingleScatteringData& first = scat_data[is][0];
+      for( Index ie=1; ie<nse; ie++ )
+        {
+          const SingleScatteringData& ssd = scat_data[is][ie];
+          bool ok = ssd.ptype == first.ptype  &&
+                    ssd.f_grid.nelem()  == first.f_grid.nelem()  &&
+                    ssd.za_grid.nelem() == first.za_grid.nelem() &&
+                    ssd.aa_grid.nelem() == first.aa_grid.nelem() &&
+                    ssd.pha_mat_data.ncols() == first.pha_mat_data.ncols() &&
+                    ssd.ext_mat_data.ncols() == first.ext_mat_data.ncols() &&
+                    ssd.abs_vec_data.ncols() == first.abs_vec_data.ncols();
+          for( Index i=0; ok && i<ssd.f_grid.nelem(); i++ )
+            ok = ssd.f_grid[i] == first.f_grid[i];
+          for( Index i=0; ok && i<ssd.za_grid.nelem(); i++ )
+            ok = ssd.za_grid[i] == first.za_grid[i];
+          for( Index i=0; ok && i<ssd.aa_grid.nelem(); i++ )
+            ok = ssd.aa_grid[i] == first.aa_grid[i];
+          if( !ok )
+            {
+              ostringstream os;
+              os << "Scattering element " << ie << " of species " << is
+                 << " differs from the first element in ptype, f_grid,\n"
+                 << "za_grid or aa_grid. All elements of a species must "
+                 << "share these to create a bulk property table.";
+              throw runtime_error( os.str() );
+            }
+        }
+
+      const Index nf = first.f_grid.nelem();
+      scat_data_table[is].resize( nb );
+      scat_meta_table[is].resize( nb );
+
+      Matrix pnd_agenda_input( nt, 1 );
+      Matrix pnd_data;
+      Tensor3 dpnd_data_dx;
+      ScatDataInterpolator sdi;
+      Tensor5 pha_mat_int( first.pha_mat_data.nshelves(),
+                           first.pha_mat_data.nbooks(),
+                           first.pha_mat_data.npages(),
+                           first.pha_mat_data.nrows(),
+                           first.pha_mat_data.ncols() );
+      Tensor3 ext_mat_int( first.ext_mat_data.npages(),
+                           first.ext_mat_data.nrows(),
+                           first.ext_mat_data.ncols() );
+      Tensor3 abs_vec_int( first.abs_vec_data.npages(),
+                           first.abs_vec_data.nrows(),
+                           first.abs_vec_data.ncols() );
+
+      for( Index ib=0; ib<nb; ib++ )
+        {
+          // PSD for this table node at all table temperatures
+          pnd_agenda_input = bulk_grid[ib];
+          pnd_agenda_arrayExecute( ws, pnd_data, dpnd_data_dx, is,
+                                   T_grid, pnd_agenda_input,
+                                   pnd_agenda_array_input_names[is],
+                                   ArrayOfString(0), pnd_agenda_array );
+          assert( pnd_data.nrows() == nt  &&  pnd_data.ncols() == nse );
+
+          SingleScatteringData& node = scat_data_table[is][ib];
+          node.ptype   = first.ptype;
+          ostringstream os;
+          os << "Bulk properties of species " << is << " for "
+             << pnd_agenda_array_input_names[is][0] << " = " << bulk_grid[ib];
+          node.description = os.str();
+          node.f_grid  = first.f_grid;
+          node.T_grid  = T_grid;
+          node.za_grid = first.za_grid;
+          node.aa_grid = first.aa_grid;
+          node.pha_mat_data.resize( nf, nt, pha_mat_int.nshelves(),
+                                    pha_mat_int.nbooks(), pha_mat_int.npages(),
+                                    pha_mat_int.nrows(), pha_mat_int.ncols() );
+          node.ext_mat_data.resize( nf, nt, ext_mat_int.npages(),
+                                    ext_mat_int.nrows(), ext_mat_int.ncols() );
+          node.abs_vec_data.resize( nf, nt, abs_vec_int.npages(),
+                                    abs_vec_int.nrows(), abs_vec_int.ncols() );
+          node.pha_mat_data = 0.0;
+          node.ext_mat_data = 0.0;
+          node.abs_vec_data = 0.0;
+
+          for( Index ie=0; ie<nse; ie++ )
+            {
+              const SingleScatteringData& ssd = scat_data[is][ie];
+              const Index ntd = ssd.T_grid.nelem();
+              for( Index it=0; it<nt; it++ )
+                {
+                  const Numeric pnd = pnd_data(it,ie);
+                  if( pnd == 0 )
+                    { continue; }
+
+                  // Table temperatures outside the data are mapped to the
+                  // closest end of the T_grid of the element
+                  if( ntd == 1 )
+                    { sdi.set_T_index( 0 ); }
+                  else
+                    { sdi.set_T( ssd.T_grid,
+                                 min( max( T_grid[it], ssd.T_grid[0] ),
+                                      ssd.T_grid[ntd-1] ),
+                                 "ScatSpeciesBulkTableCalc" ); }
+
+                  for( Index iv=0; iv<nf; iv++ )
+                    {
+                      sdi.set_f_index( iv );
+                      sdi.interp( pha_mat_int, ssd.pha_mat_data );
+                      sdi.interp( ext_mat_int, ssd.ext_mat_data );
+                      sdi.interp( abs_vec_int, ssd.abs_vec_data );
+                      pha_mat_int *= pnd;
+                      ext_mat_int *= pnd;
+                      abs_vec_int *= pnd;
+                      node.pha_mat_data(iv,it,joker,joker,joker,joker,joker)
+                                                              += pha_mat_int;
+                      node.ext_mat_data(iv,it,joker,joker,joker)
+                                                              += ext_mat_int;
+                      node.abs_vec_data(iv,it,joker,joker,joker)
+                                                              += abs_vec_int;
+                    }
+                }
+            }
+
+          ScatteringMetaData& meta = scat_meta_table[is][ib];
+          meta.description = node.description;
+          meta.source      = "ARTS internal";
+          meta.refr_index  = "Unknown";
+          meta.mass        = -1.;
+          meta.diameter_max = -1.;
+          meta.diameter_volume_equ = -1.;
+          meta.diameter_area_equ_aerodynamical = -1.;
+        }
+
+      out2 << "  Scattering species " << is << ": " << nse
+           << " scattering elements replaced by " << nb
+           << " bulk property table nodes.\n";
+    }
+
+  scat_data = std::move( scat_data_table );
+  scat_meta = std::move( scat_meta_table );
+}
+
+
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void dNdD_F07 (//WS Output:
                 Vector& dNdD,
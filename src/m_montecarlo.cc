@@ -52,6 +52,7 @@ by Monte Carlo methods.  All of these functions refer to 3D calculations
 #include "xml_io.h"
 #include "montecarlo.h"
 #include "rng.h"
+#include <chrono>
 #include <ctime>
 #include <fstream>
 #include "mc_interp.h"
@@ -598,10 +599,13 @@ void MCRadar(// Workspace reference:
              const Numeric& ze_tref,
              const Numeric& k2,
              const Index& t_interp_order,
+             const Numeric& ism_fraction,
+             const Numeric& ism_cone,
              // Verbosity object:
              const Verbosity& verbosity)
 {
   CREATE_OUT0;
+  CREATE_OUT1;
 
   // Important constants
   const Index nbins = range_bins.nelem() - 1;
@@ -675,6 +679,11 @@ void MCRadar(// Workspace reference:
                            "Gaussian antenna patterns." );
     }
 
+  if( ism_fraction < 0  ||  ism_fraction >= 1 )
+    throw runtime_error( "*ism_fraction* must be >= 0 and < 1." );
+  if( ism_cone <= 0  ||  ism_cone > 180 )
+    throw runtime_error( "*ism_cone* must be > 0 and <= 180." );
+
   Ppath  ppath_step;
   Rng    rng;                      //Random Number generator
   Index  N_se = pnd_field.nbooks();//Number of scattering elements
@@ -689,8 +698,9 @@ void MCRadar(// Workspace reference:
   Numeric antenna_wgt;
   Matrix evol_op(stokes_dim,stokes_dim), ext_mat_mono(stokes_dim,stokes_dim);
   Matrix trans_mat(stokes_dim,stokes_dim);
-  Matrix Z(stokes_dim,stokes_dim);
+  Matrix Z(stokes_dim,stokes_dim), P(stokes_dim,stokes_dim);
   Matrix R_ant2enu(3,3), R_enu2ant(3,3), R_stokes(stokes_dim, stokes_dim);
+  Matrix R_tx(3,3), R_rx(3,3);
   Vector abs_vec_mono(stokes_dim), I_i(stokes_dim), I_i_rot(stokes_dim);
   Vector Isum(nbins*stokes_dim), Isquaredsum(nbins*stokes_dim);
   Index termination_flag = 0;
@@ -747,6 +757,9 @@ void MCRadar(// Workspace reference:
   Vector  local_rte_pos(3);
   Vector  local_rte_los(2);
   Vector  new_rte_los(2);
+  Vector  rte_los_geom(2), rte_los_antenna(2);
+  Ppath   ppath;
+  Numeric los_pdf;
   Vector Ipath(stokes_dim), Ihold(stokes_dim), Ipath_norm(stokes_dim);
   Isum=0.0;
   Isquaredsum=0.0;
@@ -777,6 +790,9 @@ void MCRadar(// Workspace reference:
   rotmat_enu(R_ant2enu, sensor_los(0,joker));
   R_enu2ant = transpose(R_ant2enu);
 
+  // Wall time for efficiency report
+  const auto start_time = std::chrono::steady_clock::now();
+
   //Begin Main Loop
   bool keepgoing, firstpass, integrity;
   while( mc_iter < mc_max_iter )
@@ -790,7 +806,6 @@ void MCRadar(// Workspace reference:
       firstpass = true;    // ensure backscatter is properly calculated
 
       //Sample a FOV direction
-      Matrix R_tx(3,3);
       mc_antenna.draw_los( local_rte_los, R_tx, rng, 
                            R_ant2enu, sensor_los(0,joker) );
       rotmat_stokes( R_stokes, stokes_dim, tx_dir, tx_dir, R_ant2enu, R_tx );
@@ -858,8 +873,6 @@ void MCRadar(// Workspace reference:
                   break; // Best way to control logic?
                 }
 
-              Vector rte_los_geom(2);
-
               // Compute reflectivity contribution based on local-to-sensor 
               // geometry, path attenuation
               // Get los angles at atmospheric locale to determine 
@@ -888,8 +901,6 @@ void MCRadar(// Workspace reference:
               // weighting of return signal and ppath to determine 
               // propagation path back to sensor
               // Replace with ppath_agendaExecute??
-              Ppath  ppath;
-              Vector rte_los_antenna(2);
               ppath_lraytrace_var = ppath_lraytrace;
               Numeric za_accuracy = 2e-5;
               Numeric pplrt_factor = 5;
@@ -944,7 +955,6 @@ void MCRadar(// Workspace reference:
                                       scat_data, verbosity );
 
                   // Obtain scattering matrix given incident and scattered angles
-                  Matrix P(stokes_dim,stokes_dim);
                   //pha_mat_singleCalc( P, rte_los_geom[0], rte_los_geom[1], 
                   //                    local_rte_los[0], local_rte_los[1], 
                   //                    this_scat_data_mono, stokes_dim, 
@@ -992,7 +1002,6 @@ void MCRadar(// Workspace reference:
                       ibin -= 1;
 
                       // Calculate rx antenna weight and polarization rotation
-                      Matrix R_rx(3,3);
                       rotmat_enu( R_rx, rte_los_antenna );
                       mc_antenna.return_los( antenna_wgt, R_rx, R_enu2ant );
                       rotmat_stokes( R_stokes, stokes_dim, rx_dir, 
@@ -1019,7 +1028,12 @@ void MCRadar(// Workspace reference:
                   //                    this_scat_data_mono, stokes_dim, 
                   //                    pnd_vec, temperature, verbosity );
 
-                  Sample_los_uniform(  new_rte_los, rng );
+                  // Importance sampling: part of the new directions are
+                  // taken in a cone around the direction towards the
+                  // receiver, to increase the number of photons that
+                  // contribute at higher scattering orders
+                  Sample_los_mixture( new_rte_los, los_pdf, rng,
+                                      rte_los_geom, ism_fraction, ism_cone );
                   pdir_array(0,joker) = new_rte_los;
                   // alt:
                   // Sample_los_uniform( pdir_array(0,joker), rng );
@@ -1033,8 +1047,7 @@ void MCRadar(// Workspace reference:
                                 pha_mat_ssbulk, ptype_ssbulk );
                   Z = pha_mat_bulk(0,0,0,0,joker,joker);
 
-                  Z *= 4 * PI;
-                  Z /= Csca;
+                  Z /= Csca * los_pdf;
                   mult( Ipath, Z, Ihold );
                   Ihold = Ipath;
                   local_rte_los = new_rte_los;                  
@@ -1079,6 +1092,22 @@ void MCRadar(// Workspace reference:
 
   y *= fac;
   mc_error *= fac;
+
+  // Efficiency report
+  const Numeric wall_time = std::chrono::duration<Numeric>(
+                  std::chrono::steady_clock::now() - start_time ).count();
+  out1 << "  MCRadar: " << mc_iter << " photons in " << wall_time << " s ("
+       << ( wall_time > 0 ? (Numeric)mc_iter / wall_time : 0 )
+       << " photons/s)\n";
+  out1 << "  Effective sample size per range bin (I component):\n";
+  for( Index ibin = 0; ibin<nbins; ibin++ )
+    {
+      const Index ibiny = ibin * stokes_dim;
+      const Numeric ess = Isquaredsum[ibiny] > 0 ?
+                          Isum[ibiny] * Isum[ibiny] / Isquaredsum[ibiny] : 0;
+      out1 << "    bin " << ibin << ": " << range_bin_count[ibin]
+           << " contributions, ESS = " << ess << "\n";
+    }
 } // end MCRadar
 
 
@@ -52,14 +52,30 @@ ReadNetCDF (// WS Generic Input:
   nca_read_from_file (f, v, verbosity);
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+template<typename T> void
+ReadNetCDFSlab (// WS Generic Output:
+                T&                  v,
+                // WS Generic Input:
+                const String&       f,
+                const ArrayOfIndex& start,
+                const ArrayOfIndex& count,
+                const Verbosity&    verbosity)
+
+{
+  nca_read_slab_from_file (f, v, start, count, verbosity);
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 template<typename T> void
 WriteNetCDF (// WS Generic Input:
              const T&      v,
              const String& f,
+             const String& format,
              // WS Generic Input Names:
              const String& v_name,
              const String& f_name _U_,
+             const String& format_name _U_,
              const Verbosity& verbosity)
 
 {
@@ -68,7 +84,16 @@ WriteNetCDF (// WS Generic Input:
   // Create default filename if empty
   nca_filename (filename, v_name);
 
-  nca_write_to_file (filename, v, verbosity);
+  bool netcdf4;
+  if (format == "netcdf4")
+    netcdf4 = true;
+  else if (format == "classic")
+    netcdf4 = false;
+  else
+    throw runtime_error("Unknown NetCDF format \"" + format + "\".\n"
+                        "Valid formats are \"netcdf4\" and \"classic\".");
+
+  nca_write_to_file (filename, v, netcdf4, verbosity);
 }
 
 /* Workspace method: Doxygen documentation will be auto-generated */
@@ -78,9 +103,11 @@ WriteNetCDFIndexed (//WS Input:
              // WS Generic Input:
              const T&      v,
              const String& f,
+             const String& format,
              // WS Generic Input Names:
              const String& v_name,
              const String& f_name,
+             const String& format_name,
              const Verbosity& verbosity)
 
 {
@@ -89,7 +116,7 @@ WriteNetCDFIndexed (//WS Input:
     // Create default filename if empty
     nca_filename_with_index (filename, file_index, v_name);
 
-    WriteNetCDF(v, filename, v_name, f_name, verbosity);
+    WriteNetCDF(v, filename, format, v_name, f_name, format_name, verbosity);
 }
 
 #else // NetCDF not enabled
@@ -108,14 +135,30 @@ ReadNetCDF (// WS Generic Input:
   throw runtime_error("This version of ARTS was compiled without NetCDF support.");
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+template<typename T> void
+ReadNetCDFSlab (// WS Generic Output:
+                T&,
+                // WS Generic Input:
+                const String&,
+                const ArrayOfIndex&,
+                const ArrayOfIndex&,
+                const Verbosity&)
+
+{
+  throw runtime_error("This version of ARTS was compiled without NetCDF support.");
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 template<typename T> void
 WriteNetCDF (// WS Generic Input:
              const T&,
              const String&,
+             const String&,
              // WS Generic Input Names:
              const String&,
              const String&,
+             const String&,
              const Verbosity&)
 
 {
@@ -129,9 +172,11 @@ WriteNetCDFIndexed (//WS Input:
              // WS Generic Input:
              const T&,
              const String&,
+             const String&,
              // WS Generic Input Names:
              const String&,
              const String&,
+             const String&,
              const Verbosity&)
 
 {
@@ -161,12 +206,14 @@ WriteNetCDF (Workspace& ws _U_,
              // WS Generic Input:
              const Agenda& v,
              const String& f,
+             const String& format,
              // WS Generic Input Names:
              const String& v_name,
              const String& f_name,
+             const String& format_name,
              const Verbosity& verbosity)
 {
-  WriteNetCDF (v, f, v_name, f_name, verbosity);
+  WriteNetCDF (v, f, format, v_name, f_name, format_name, verbosity);
 }
 
 #endif // m_nc_h
@@ -47,6 +47,7 @@
 #include "arts_omp.h"
 #include "array.h"
 #include "auto_md.h"
+#include "file.h"
 #include "math_funcs.h"
 #include "physics_funcs.h"
 #include "jacobian.h"
@@ -1280,7 +1281,9 @@ void OEM_checks(
          method == "ml"      || method == "lm"      ||
          method == "li_cg"   || method == "gn_cg"   ||
          method == "li_cg_m" || method == "gn_cg_m" ||
-         method == "lm_cg"   || method == "ml_cg" ) )
+         method == "lm_cg"   || method == "ml_cg"   ||
+         method == "li_pcg"  || method == "gn_pcg"  ||
+         method == "lm_pcg"  || method == "ml_pcg" ) )
   {
     throw runtime_error( "Valid options for *method* are \"nl\", \"gn\" and "
                          "\"ml\" or \"lm\"." );
@@ -1307,7 +1310,8 @@ void OEM_checks(
     throw runtime_error( "The argument *stop_dx* must be > 0." );
   }
 
-  if( (method == "ml") || (method == "lm") || (method == "lm_cg") || (method == "ml_cg") )
+  if( (method == "ml") || (method == "lm") || (method == "lm_cg") || (method == "ml_cg")
+      || (method == "lm_pcg") || (method == "ml_pcg") )
   {
       if( lm_ga_settings.nelem() != 6 )
       {
@@ -1338,6 +1342,92 @@ void OEM_checks(
   }
 }
 
+//
+// Gamma factor to start a Levenberg-Marquardt inversion with. If the
+// checkpoint files of an earlier run belong to the start state x, the
+// inversion is resumed with the gamma factor of its last completed iteration.
+//
+Numeric OEM_start_ga(
+    const String&     checkpoint_file,
+    ConstVectorView   x,
+    const Numeric&    ga_default,
+    const Verbosity&  verbosity )
+{
+    if( !checkpoint_file.nelem() )
+        return ga_default;
+
+    const String xfile  = checkpoint_file + ".x.xml";
+    const String gafile = checkpoint_file + ".lm_ga.xml";
+    if( !file_exists( xfile )  ||  !file_exists( gafile ) )
+        return ga_default;
+
+    Vector xc;
+    xml_read_from_file( xfile, xc, verbosity );
+    if( xc.nelem() != x.nelem() )
+        return ga_default;
+    for( Index i = 0; i < x.nelem(); i++ )
+        if( xc[i] != x[i] )
+            return ga_default;
+
+    Numeric ga;
+    xml_read_from_file( gafile, ga, verbosity );
+    return ga;
+}
+
+//
+// Value of the cost function, normalised with the length of y as in
+// *oem_diagnostics*.
+//
+Numeric OEM_cost(
+    ConstVectorView          x,
+    ConstVectorView          yf,
+    ConstVectorView          xa,
+    const CovarianceMatrix&  covmat_sx,
+    ConstVectorView          y,
+    const CovarianceMatrix&  covmat_se )
+{
+    Vector dy  = y; dy -= yf;
+    Vector sdy = y; solve(sdy, covmat_se, dy);
+    Vector dx  = x; dx -= xa;
+    Vector sdx = x; solve(sdx, covmat_sx, dx);
+    return ( dx * sdx + dy * sdy ) / static_cast<Numeric>(y.nelem());
+}
+
+//
+// Reads the checkpoint files of an interrupted inversion. The state vector,
+// yf and jacobian are set to the last saved values. The number of
+// iterations already done, and the cost and gamma history of these, are
+// returned as well. Returns false, and leaves all arguments untouched, if
+// there are no checkpoint files.
+//
+bool OEM_read_checkpoint(
+    Vector&           x,
+    Vector&           yf,
+    Matrix&           jacobian,
+    Index&            iteration,
+    Vector&           cost_history,
+    Vector&           ga_history,
+    const String&     checkpoint_file,
+    const Verbosity&  verbosity )
+{
+    const String xfile = checkpoint_file + ".x.xml";
+    if( !file_exists( xfile ) )
+        return false;
+
+    xml_read_from_file( xfile, x, verbosity );
+    xml_read_from_file( checkpoint_file + ".yf.xml", yf, verbosity );
+    xml_read_from_file( checkpoint_file + ".jacobian.xml", jacobian,
+                        verbosity );
+    xml_read_from_file( checkpoint_file + ".iteration.xml", iteration,
+                        verbosity );
+    xml_read_from_file( checkpoint_file + ".cost_history.xml", cost_history,
+                        verbosity );
+    xml_read_from_file( checkpoint_file + ".lm_ga_history.xml", ga_history,
+                        verbosity );
+    return true;
+}
+
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void OEM(
          Workspace&                  ws,
@@ -1363,12 +1453,38 @@ void OEM(
    const Vector&                     lm_ga_settings,
    const Index&                      clear_matrices,
    const Index&                      display_progress,
-   const Verbosity& )
+   const String&                     checkpoint_file,
+   const String&                     jacobian_update,
+   const Index&                      checkpoint_resume,
+   const Verbosity&                  verbosity )
 {
     // Main sizes
     const Index n = covmat_sx.nrows();
     const Index m = y.nelem();
 
+    if( !( jacobian_update == "full"  ||  jacobian_update == "broyden" ) )
+    {
+        throw runtime_error( "Valid options for *jacobian_update* are \"full\" "
+                             "and \"broyden\"." );
+    }
+    if( checkpoint_resume < 0  ||  checkpoint_resume > 1 )
+        throw runtime_error( "Valid options for *checkpoint_resume* are 0 and 1." );
+    if( checkpoint_resume  &&  !checkpoint_file.nelem() )
+        throw runtime_error( "*checkpoint_resume* requires that "
+                             "*checkpoint_file* is set." );
+
+    // Resume from checkpoint files, if requested and existing
+    Index  iteration_start = 0;
+    Vector cost_history_start, ga_history_start;
+    if( checkpoint_resume )
+    {
+        OEM_read_checkpoint( x, yf, jacobian, iteration_start,
+                             cost_history_start, ga_history_start,
+                             checkpoint_file, verbosity );
+    }
+    // Iterations already done count towards max_iter
+    const Index max_iter_left = std::max( max_iter - iteration_start, Index(0) );
+
     // Checks
     covmat_sx.compute_inverse();
     covmat_se.compute_inverse();
@@ -1384,10 +1500,13 @@ void OEM(
     oem_diagnostics = NAN;
     //
     if( method == "ml" || method == "lm"
-        || method == "ml_cg" || method == "lm_cg" )
+        || method == "ml_cg" || method == "lm_cg"
+        || method == "ml_pcg" || method == "lm_pcg" )
     {
         lm_ga_history.resize(max_iter + 1);
         lm_ga_history = NAN;
+        for( Index i=0; i<std::min(iteration_start, ga_history_start.nelem()); i++ )
+            lm_ga_history[i] = ga_history_start[i];
     }
     else
     {
@@ -1413,13 +1532,10 @@ void OEM(
     Numeric cost_start = NAN;
     if( method == "ml" || method == "lm" || display_progress || max_start_cost > 0 )
     {
-        Vector dy  = y; dy -= yf;
-        Vector sdy = y; mult(sdy, covmat_se, dy);
-        Vector dx  = x; dx -= xa;
-        Vector sdx = x; mult(sdx, covmat_sx, dx);
-        cost_start = dx * sdx + dy * sdy;
-        cost_start /= static_cast<Numeric>(m);
+        cost_start = OEM_cost( x, yf, xa, covmat_sx, y, covmat_se );
     }
+    if( iteration_start > 0  &&  cost_history_start.nelem() > 0 )
+        cost_start = cost_history_start[0];
     oem_diagnostics[1] = cost_start;
 
     // Handle cases with too large start cost
@@ -1453,6 +1569,11 @@ void OEM(
         OEMVector xa_oem(xa), y_oem(y), x_oem(x);
         AgendaWrapper aw(&ws, (unsigned int) m, (unsigned int) n,
                          jacobian, yf, &inversion_iterate_agenda);
+        aw.set_broyden( jacobian_update == "broyden" );
+        aw.set_checkpoint( checkpoint_file, &lm_ga_history, &verbosity );
+        aw.set_checkpoint_cost( [&]( ConstVectorView xi, ConstVectorView yi )
+            { return OEM_cost( xi, yi, xa, covmat_sx, y, covmat_se ); } );
+        aw.set_checkpoint_resume( iteration_start, cost_history_start );
         OEM_STANDARD<AgendaWrapper> oem(aw, xa_oem, Sa, Se);
         OEM_MFORM<AgendaWrapper> oem_m(aw, xa_oem, Sa, Se);
         int oem_verbosity = static_cast<int>(display_progress);
@@ -1497,40 +1618,60 @@ void OEM(
                     lm_ga_history, true);
                 oem_diagnostics[0] = static_cast<Index>(return_code);
             }
+            else if (method == "li_pcg")
+            {
+                Normed<PCG> pcg(T, apply_norm, &jacobian, &covmat_se,
+                                &covmat_sx, &x_norm, nullptr, 1e-10, 0);
+                GN_PCG gn(stop_dx, 1, pcg); // Linear case, only one step.
+                return_code = oem.compute<GN_PCG, ArtsLog>(
+                    x_oem, y_oem, gn, oem_verbosity,
+                    lm_ga_history, true);
+                oem_diagnostics[0] = static_cast<Index>(return_code);
+            }
             else if (method == "gn")
             {
                 Normed<> s(T, apply_norm);
-                GN gn(stop_dx, (unsigned int) max_iter, s);
+                GN gn(stop_dx, (unsigned int) max_iter_left, s);
                     return_code = oem.compute<GN, ArtsLog>(
                         x_oem, y_oem, gn, oem_verbosity,
-                        lm_ga_history);
+                        lm_ga_history, false, iteration_start);
                 oem_diagnostics[0] = static_cast<Index>(return_code);
             }
             else if (method == "gn_m")
             {
                 Normed<> s(T, apply_norm);
-                GN gn(stop_dx, (unsigned int) max_iter, s);
+                GN gn(stop_dx, (unsigned int) max_iter_left, s);
                 return_code = oem_m.compute<GN, ArtsLog>(
                     x_oem, y_oem, gn, oem_verbosity,
-                    lm_ga_history);
+                    lm_ga_history, false, iteration_start);
                 oem_diagnostics[0] = static_cast<Index>(return_code);
             }
             else if (method == "gn_cg")
             {
                 Normed<CG> cg(T, apply_norm, 1e-10, 0);
-                GN_CG gn(stop_dx, (unsigned int) max_iter, cg);
+                GN_CG gn(stop_dx, (unsigned int) max_iter_left, cg);
                 return_code = oem.compute<GN_CG, ArtsLog>(
                     x_oem, y_oem, gn, oem_verbosity,
-                    lm_ga_history);
+                    lm_ga_history, false, iteration_start);
                 oem_diagnostics[0] = static_cast<Index>(return_code);
             }
             else if (method == "gn_cg_m")
             {
                 Normed<CG> cg(T, apply_norm, 1e-10, 0);
-                GN_CG gn(stop_dx, (unsigned int) max_iter, cg);
+                GN_CG gn(stop_dx, (unsigned int) max_iter_left, cg);
                 return_code = oem_m.compute<GN_CG, ArtsLog>(
                     x_oem, y_oem, gn, oem_verbosity,
-                    lm_ga_history);
+                    lm_ga_history, false, iteration_start);
+                oem_diagnostics[0] = static_cast<Index>(return_code);
+            }
+            else if (method == "gn_pcg")
+            {
+                Normed<PCG> pcg(T, apply_norm, &jacobian, &covmat_se,
+                                &covmat_sx, &x_norm, nullptr, 1e-10, 0);
+                GN_PCG gn(stop_dx, (unsigned int) max_iter_left, pcg);
+                return_code = oem.compute<GN_PCG, ArtsLog>(
+                    x_oem, y_oem, gn, oem_verbosity,
+                    lm_ga_history, false, iteration_start);
                 oem_diagnostics[0] = static_cast<Index>(return_code);
             }
             else if ( (method == "lm") || (method == "ml") )
@@ -1540,8 +1681,10 @@ void OEM(
                 LM_S lm(SaInv, s);
 
                 lm.set_tolerance(stop_dx);
-                lm.set_maximum_iterations((unsigned int) max_iter);
-                lm.set_lambda(lm_ga_settings[0]);
+                lm.set_maximum_iterations((unsigned int) max_iter_left);
+                lm.set_lambda(OEM_start_ga(checkpoint_file, x,
+                                           lm_ga_settings[0], verbosity));
+                aw.set_checkpoint_ga([&lm]() { return lm.get_lambda(); });
                 lm.set_lambda_decrease(lm_ga_settings[1]);
                 lm.set_lambda_increase(lm_ga_settings[2]);
                 lm.set_lambda_maximum(lm_ga_settings[3]);
@@ -1550,7 +1693,7 @@ void OEM(
 
                 return_code = oem.compute<LM_S&, ArtsLog>(
                     x_oem, y_oem, lm, oem_verbosity,
-                    lm_ga_history);
+                    lm_ga_history, false, iteration_start);
                 oem_diagnostics[0] = static_cast<Index>(return_code);
                 if (lm.get_lambda() > lm.get_lambda_maximum()) {
                     oem_diagnostics[0] = 2;
@@ -1562,16 +1705,52 @@ void OEM(
                 Normed<CG> cg(T, apply_norm, 1e-10, 0);
                 LM_CG_S lm(SaInv, cg);
 
-                lm.set_maximum_iterations((unsigned int) max_iter);
-                lm.set_lambda(lm_ga_settings[0]);
+                lm.set_tolerance(stop_dx);
+                lm.set_maximum_iterations((unsigned int) max_iter_left);
+                lm.set_lambda(OEM_start_ga(checkpoint_file, x,
+                                           lm_ga_settings[0], verbosity));
+                aw.set_checkpoint_ga([&lm]() { return lm.get_lambda(); });
                 lm.set_lambda_decrease(lm_ga_settings[1]);
                 lm.set_lambda_increase(lm_ga_settings[2]);
-                lm.set_lambda_threshold(lm_ga_settings[3]);
-                lm.set_lambda_maximum(lm_ga_settings[4]);
+                lm.set_lambda_maximum(lm_ga_settings[3]);
+                lm.set_lambda_threshold(lm_ga_settings[4]);
+                lm.set_lambda_constraint(lm_ga_settings[5]);
 
                 return_code = oem.compute<LM_CG_S&, ArtsLog>(
                     x_oem, y_oem, lm, oem_verbosity,
-                    lm_ga_history);
+                    lm_ga_history, false, iteration_start);
+                oem_diagnostics[0] = static_cast<Index>(return_code);
+                if (lm.get_lambda() > lm.get_lambda_maximum()) {
+                    oem_diagnostics[0] = 2;
+                }
+            }
+            else if ( (method == "lm_pcg") || (method == "ml_pcg") )
+            {
+                // The preconditioner follows the damping of the LM object,
+                // which is created after the solver.
+                const LM_PCG_S *lm_ptr = nullptr;
+                Normed<PCG> pcg(T, apply_norm, &jacobian, &covmat_se,
+                                &covmat_sx, &x_norm,
+                                [&lm_ptr]() { return lm_ptr->get_lambda(); },
+                                1e-10, 0);
+                OEMCovarianceMatrix SaInv = inv(Sa);
+                LM_PCG_S lm(SaInv, pcg);
+                lm_ptr = &lm;
+
+                lm.set_tolerance(stop_dx);
+                lm.set_maximum_iterations((unsigned int) max_iter_left);
+                lm.set_lambda(OEM_start_ga(checkpoint_file, x,
+                                           lm_ga_settings[0], verbosity));
+                aw.set_checkpoint_ga([&lm]() { return lm.get_lambda(); });
+                lm.set_lambda_decrease(lm_ga_settings[1]);
+                lm.set_lambda_increase(lm_ga_settings[2]);
+                lm.set_lambda_maximum(lm_ga_settings[3]);
+                lm.set_lambda_threshold(lm_ga_settings[4]);
+                lm.set_lambda_constraint(lm_ga_settings[5]);
+
+                return_code = oem.compute<LM_PCG_S&, ArtsLog>(
+                    x_oem, y_oem, lm, oem_verbosity,
+                    lm_ga_history, false, iteration_start);
                 oem_diagnostics[0] = static_cast<Index>(return_code);
                 if (lm.get_lambda() > lm.get_lambda_maximum()) {
                     oem_diagnostics[0] = 2;
@@ -1580,14 +1759,14 @@ void OEM(
 
             oem_diagnostics[2] = oem.cost / static_cast<Numeric>(m);
             oem_diagnostics[3] = oem.cost_y / static_cast<Numeric>(m);
-            oem_diagnostics[4] = static_cast<Numeric>(oem.iterations);
+            oem_diagnostics[4] = static_cast<Numeric>(iteration_start + oem.iterations);
         }
         catch (const std::exception & e)
         {
             oem_diagnostics[0] = 9;
             oem_diagnostics[2] = oem.cost;
             oem_diagnostics[3] = oem.cost_y;
-            oem_diagnostics[4] = static_cast<Numeric>(oem.iterations);
+            oem_diagnostics[4] = static_cast<Numeric>(iteration_start + oem.iterations);
             x_oem *= NAN;
             std::vector<std::string> sv = handle_nested_exception(e);
             for (auto & s : sv)
@@ -1755,6 +1934,9 @@ void OEM(Workspace&,
          const Vector&,
          const Index&,
          const Index&,
+         const String&,
+         const String&,
+         const Index&,
          const Verbosity&)
 {
   throw runtime_error("WSM is not available because ARTS was compiled without "
@@ -132,6 +132,8 @@ void pha_mat_sptFromData( // Output:
   // [frequency, za_inc, aa_inc, stokes_dim, stokes_dim]
   Tensor5 pha_mat_data_int;
 
+  // Frequency and temperature interpolation stencils
+  ScatDataInterpolator sdi;
 
   Index i_se_flat = 0;
   // Loop over scattering species
@@ -162,93 +164,38 @@ void pha_mat_sptFromData( // Output:
                                       PHA_MAT_DATA.nrows(),
                                       PHA_MAT_DATA.ncols());
 
-
-              // Gridpositions:
-              GridPos freq_gp;
-              gridpos(freq_gp, F_DATAGRID, f_grid[f_index]);
-              GridPos t_gp;
-              Vector itw;
-
-              Index ti=-1;
+              // Interpolation stencils (only recalculated if grids differ
+              // from the ones of the previous scattering element)
+              sdi.set_f( F_DATAGRID, f_grid[f_index] );
 
               if( PHA_MAT_DATA.nvitrines() == 1 ) // just 1 T_grid element
               {
-                  ti=0;
+                  sdi.set_T_index( 0 );
               }
               else if( rtp_temperature < 0. ) // coding for 'not interpolate, but
                                               // pick one temperature'
               {
                 if( rtp_temperature > -10. )      // lowest T-point
                 {
-                  ti = 0;
+                  sdi.set_T_index( 0 );
                 }
                 else if( rtp_temperature > -20. ) // highest T-point
                 {
-                  ti = T_DATAGRID.nelem()-1;
+                  sdi.set_T_index( T_DATAGRID.nelem()-1 );
                 }
                 else                              // median T-point
                 {
-                  ti = T_DATAGRID.nelem()/2;
+                  sdi.set_T_index( T_DATAGRID.nelem()/2 );
                 }
               }
-
-              if( ti<0 ) // temperature interpolation
-              {
-                  ostringstream os;
-                  os << "In pha_mat_sptFromData.\n"
-                     << "The temperature grid of the scattering data does not\n"
-                     << "cover the atmospheric temperature at cloud location.\n"
-                     << "The data should include the value T = "
-                     << rtp_temperature << " K.";
-                  chk_interpolation_grids( os.str(), T_DATAGRID, 
-                                           rtp_temperature );
-
-                  gridpos(t_gp, T_DATAGRID, rtp_temperature);
-
-                  // Interpolation weights:
-                  itw.resize(4);
-                  interpweights(itw, freq_gp, t_gp);
-
-                  for (Index i_za_sca = 0;
-                       i_za_sca < PHA_MAT_DATA.nshelves(); i_za_sca++)
-                    for (Index i_aa_sca = 0;
-                         i_aa_sca < PHA_MAT_DATA.nbooks(); i_aa_sca++)
-                      for (Index i_za_inc = 0;
-                           i_za_inc < PHA_MAT_DATA.npages(); i_za_inc++)
-                        for (Index i_aa_inc = 0;
-                             i_aa_inc < PHA_MAT_DATA.nrows(); i_aa_inc++)
-                          for (Index i = 0; i < PHA_MAT_DATA.ncols(); i++)
-                            // Interpolation of phase matrix:
-                            pha_mat_data_int(i_za_sca, i_aa_sca,
-                                             i_za_inc, i_aa_inc, i) =
-                              interp(itw,
-                                     PHA_MAT_DATA(joker, joker,
-                                     i_za_sca, i_aa_sca, i_za_inc, i_aa_inc, i),
-                                     freq_gp, t_gp);
-              }
-              else
+              else // temperature interpolation
               {
-                  // Interpolation weights:
-                  itw.resize(2);
-                  interpweights(itw, freq_gp);
-                  for (Index i_za_sca = 0;
-                       i_za_sca < PHA_MAT_DATA.nshelves(); i_za_sca++)
-                    for (Index i_aa_sca = 0;
-                         i_aa_sca < PHA_MAT_DATA.nbooks(); i_aa_sca++)
-                      for (Index i_za_inc = 0;
-                           i_za_inc < PHA_MAT_DATA.npages(); i_za_inc++)
-                        for (Index i_aa_inc = 0;
-                             i_aa_inc < PHA_MAT_DATA.nrows(); i_aa_inc++)
-                          for (Index i = 0; i < PHA_MAT_DATA.ncols(); i++)
-                            // Interpolation of phase matrix:
-                            pha_mat_data_int(i_za_sca, i_aa_sca,
-                                             i_za_inc, i_aa_inc, i) =
-                              interp(itw,
-                                     PHA_MAT_DATA(joker, ti,
-                                     i_za_sca, i_aa_sca, i_za_inc, i_aa_inc, i),
-                                     freq_gp);
+                  sdi.set_T( T_DATAGRID, rtp_temperature,
+                             "pha_mat_sptFromData" );
               }
 
+              sdi.interp( pha_mat_data_int, PHA_MAT_DATA );
+
               // Do the transformation into the laboratory coordinate system.
               for (Index za_inc_idx = 0; za_inc_idx < scat_za_grid.nelem();
                    za_inc_idx ++)
@@ -523,6 +470,9 @@ void opt_prop_sptFromData(// Output and Input:
   // [frequency, za_inc, aa_inc, stokes_dim, stokes_dim]
   Tensor3 ext_mat_data_int;
   Tensor3 abs_vec_data_int;
+
+  // Frequency and temperature interpolation stencils
+  ScatDataInterpolator sdi;
   
   // Initialisation
   ext_mat_spt = 0.;
@@ -549,10 +499,8 @@ void opt_prop_sptFromData(// Output and Input:
               // used in the database (depending on the kind of ptype) to the
               // laboratory coordinate system.
 
-              // Frequency interpolation:
+              // Frequency and temperature interpolation:
 
-              // The data is interpolated on one frequency.
-              //
               // Resize the variables for the interpolated data:
               //
               ext_mat_data_int.resize(EXT_MAT_DATA.npages(),
@@ -563,113 +511,22 @@ void opt_prop_sptFromData(// Output and Input:
                                       ABS_VEC_DATA.nrows(),
                                       ABS_VEC_DATA.ncols());
 
-
-              // Gridpositions:
-              GridPos freq_gp;
-              gridpos(freq_gp, F_DATAGRID, f_grid[f_index]);
-              GridPos t_gp;
-              Vector itw;
-
+              // Interpolation stencils (only recalculated if grids differ
+              // from the ones of the previous scattering element)
+              sdi.set_f( F_DATAGRID, f_grid[f_index] );
               if ( T_DATAGRID.nelem() > 1)
               {
-                  ostringstream os;
-                  os << "In opt_prop_sptFromData.\n"
-                     << "The temperature grid of the scattering data does not\n"
-                     << "cover the atmospheric temperature at cloud location.\n"
-                     << "The data should include the value T = "
-                     << rtp_temperature << " K.";
-                  chk_interpolation_grids( os.str(), T_DATAGRID, 
-                                           rtp_temperature );
-
-                  gridpos(t_gp, T_DATAGRID, rtp_temperature);
-
-                  // Interpolation weights:
-                  itw.resize(4);
-                  interpweights(itw, freq_gp, t_gp);
-
-                  for (Index i_za_sca = 0; i_za_sca < EXT_MAT_DATA.npages();
-                       i_za_sca++)
-                  {
-                      for(Index i_aa_sca = 0; i_aa_sca < EXT_MAT_DATA.nrows();
-                          i_aa_sca++)
-                      {
-                          //
-                          // Interpolation of extinction matrix:
-                          //
-                          for (Index i = 0; i < EXT_MAT_DATA.ncols(); i++)
-                          {
-                              ext_mat_data_int(i_za_sca, i_aa_sca, i) =
-                              interp(itw, EXT_MAT_DATA(joker, joker,
-                                                           i_za_sca, i_aa_sca, i),
-                                     freq_gp, t_gp);
-                          }
-                      }
-                  }
-
-                  for (Index i_za_sca = 0; i_za_sca < ABS_VEC_DATA.npages();
-                       i_za_sca++)
-                  {
-                      for(Index i_aa_sca = 0; i_aa_sca < ABS_VEC_DATA.nrows();
-                          i_aa_sca++)
-                      {
-                          //
-                          // Interpolation of absorption vector:
-                          //
-                          for (Index i = 0; i < ABS_VEC_DATA.ncols(); i++)
-                          {
-                              abs_vec_data_int(i_za_sca, i_aa_sca, i) =
-                              interp(itw, ABS_VEC_DATA(joker, joker, i_za_sca,
-                                                           i_aa_sca, i),
-                                     freq_gp, t_gp);
-                          }
-                      }
-                  }
+                  sdi.set_T( T_DATAGRID, rtp_temperature,
+                             "opt_prop_sptFromData" );
               }
               else
               {
-                  // Interpolation weights:
-                  itw.resize(2);
-                  interpweights(itw, freq_gp);
-
-                  for (Index i_za_sca = 0; i_za_sca < EXT_MAT_DATA.npages();
-                       i_za_sca++)
-                  {
-                      for(Index i_aa_sca = 0; i_aa_sca < EXT_MAT_DATA.nrows();
-                          i_aa_sca++)
-                      {
-                          //
-                          // Interpolation of extinction matrix:
-                          //
-                          for (Index i = 0; i < EXT_MAT_DATA.ncols(); i++)
-                          {
-                              ext_mat_data_int(i_za_sca, i_aa_sca, i) =
-                              interp(itw, EXT_MAT_DATA(joker, 0,
-                                                           i_za_sca, i_aa_sca, i),
-                                     freq_gp);
-                          }
-                      }
-                  }
-
-                  for (Index i_za_sca = 0; i_za_sca < ABS_VEC_DATA.npages();
-                       i_za_sca++)
-                  {
-                      for(Index i_aa_sca = 0; i_aa_sca < ABS_VEC_DATA.nrows();
-                          i_aa_sca++)
-                      {
-                          //
-                          // Interpolation of absorption vector:
-                          //
-                          for (Index i = 0; i < ABS_VEC_DATA.ncols(); i++)
-                          {
-                              abs_vec_data_int(i_za_sca, i_aa_sca, i) =
-                              interp(itw, ABS_VEC_DATA(joker, 0, i_za_sca,
-                                                           i_aa_sca, i),
-                                     freq_gp);
-                          }
-                      }
-                  }
+                  sdi.set_T_index( 0 );
               }
 
+              sdi.interp( ext_mat_data_int, EXT_MAT_DATA );
+              sdi.interp( abs_vec_data_int, ABS_VEC_DATA );
+
 
               //
               // Do the transformation into the laboratory coordinate system.
@@ -2755,7 +2612,8 @@ void pha_mat_sptFromScat_data( // Output:
   // [frequency, za_inc, aa_inc, stokes_dim, stokes_dim]
   Tensor5 pha_mat_data_int;
 
-  Index this_f_index;
+  // Frequency and temperature interpolation stencils
+  ScatDataInterpolator sdi;
 
   Index i_se_flat = 0;
   // Loop over scattering species
@@ -2787,95 +2645,40 @@ void pha_mat_sptFromScat_data( // Output:
 
               // Frequency extraction and temperature interpolation
 
-              // Gridpositions and interpolation weights;
-              GridPos t_gp;
-              Vector itw;
-              Index this_T_index = -1;
+              // Interpolation stencils (only recalculated if grids differ
+              // from the ones of the previous scattering element)
+              if( PHA_MAT_DATA.nlibraries()==1 )
+                sdi.set_f_index( 0 );
+              else
+                sdi.set_f_index( f_index );
+
               if ( PHA_MAT_DATA.nvitrines()==1 )
                 {
-                  this_T_index = 0;
+                  sdi.set_T_index( 0 );
                 }
               else if( rtp_temperature < 0. ) // coding for 'not interpolate, but
                                               // pick one temperature'
                 {
                   if( rtp_temperature > -10. )      // lowest T-point
                     {
-                      this_T_index = 0;
+                      sdi.set_T_index( 0 );
                     }
                   else if( rtp_temperature > -20. ) // highest T-point
                     {
-                      this_T_index = PHA_MAT_DATA.nvitrines()-1;
+                      sdi.set_T_index( PHA_MAT_DATA.nvitrines()-1 );
                     }
                   else                              // median T-point
                     {
-                      this_T_index = PHA_MAT_DATA.nvitrines()/2;
+                      sdi.set_T_index( PHA_MAT_DATA.nvitrines()/2 );
                     }
                 }
               else
                 {
-                  ostringstream os;
-                  os << "In pha_mat_sptFromScat_data.\n"
-                     << "The temperature grid of the scattering data does not\n"
-                     << "cover the atmospheric temperature at cloud location.\n"
-                     << "The data should include the value T = "
-                     << rtp_temperature << " K.";
-                  chk_interpolation_grids( os.str(), T_DATAGRID, 
-                                           rtp_temperature );
-
-                  gridpos(t_gp, T_DATAGRID, rtp_temperature);
-
-                  // Interpolation weights:
-                  itw.resize(2);
-                  interpweights(itw, t_gp);
+                  sdi.set_T( T_DATAGRID, rtp_temperature,
+                             "pha_mat_sptFromScat_data" );
                 }
 
-              if( PHA_MAT_DATA.nlibraries()==1 )
-                this_f_index = 0;
-              else
-                this_f_index = f_index;
-
-              if ( this_T_index < 0 )
-                {
-                  // Interpolation of scattering matrix:
-                  for (Index i_za_sca = 0;
-                       i_za_sca < PHA_MAT_DATA.nshelves(); i_za_sca++)
-                    for (Index i_aa_sca = 0;
-                         i_aa_sca < PHA_MAT_DATA.nbooks(); i_aa_sca++)
-                      for (Index i_za_inc = 0;
-                           i_za_inc < PHA_MAT_DATA.npages(); i_za_inc++)
-                        for (Index i_aa_inc = 0;
-                             i_aa_inc < PHA_MAT_DATA.nrows(); i_aa_inc++)
-                          for (Index i = 0; i < PHA_MAT_DATA.ncols(); i++)
-                            pha_mat_data_int(i_za_sca, i_aa_sca,
-                                             i_za_inc, i_aa_inc, i) =
-                              interp(itw,
-                                     PHA_MAT_DATA(this_f_index, joker,
-                                                      i_za_sca, i_aa_sca,
-                                                      i_za_inc, i_aa_inc, i),
-                                     t_gp);
-                }
-              else
-                {
-                  pha_mat_data_int = PHA_MAT_DATA(this_f_index, this_T_index,
-                                                      joker, joker,
-                                                      joker, joker, joker);
-                  /*
-                  for (Index i_za_sca = 0;
-                       i_za_sca < PHA_MAT_DATA.nshelves(); i_za_sca++)
-                    for (Index i_aa_sca = 0;
-                         i_aa_sca < PHA_MAT_DATA.nbooks(); i_aa_sca++)
-                      for (Index i_za_inc = 0;
-                           i_za_inc < PHA_MAT_DATA.npages(); i_za_inc++)
-                        for (Index i_aa_inc = 0;
-                             i_aa_inc < PHA_MAT_DATA.nrows(); i_aa_inc++)
-                          for (Index i = 0; i < PHA_MAT_DATA.ncols(); i++)
-                            // Interpolation of phase matrix:
-                            pha_mat_data_int(i_za_sca, i_aa_sca,
-                                             i_za_inc, i_aa_inc, i) =
-                                PHA_MAT_DATA(this_f_index, this_T_index,
-                                                 i_za_sca, i_aa_sca,
-                  */
-                }
+              sdi.interp( pha_mat_data_int, PHA_MAT_DATA );
 
 
               // Do the transformation into the laboratory coordinate system.
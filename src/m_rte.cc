@@ -54,6 +54,7 @@
 #include "montecarlo.h"
 #include "physics_funcs.h"
 #include "ppath.h"
+#include "profiler.h"
 #include "rte.h"
 #include "special_interp.h"
 
@@ -1252,6 +1253,45 @@ void ppvar_optical_depthFromPpvar_trans_cumulat(
 
 
 
+//! nonzero_column_range
+/*!
+    Determines the range of columns of a matrix holding non-zero elements.
+
+    Used to restrict the application of the sensor response on *diyb_dx*
+    to the part of the retrieval grids actually seen by a measurement block.
+
+    \param   c0   Out: Index of first column with non-zero elements.
+    \param   nc   Out: Number of columns from c0 to the last column with
+                 non-zero elements. Zero if the matrix only holds zeros.
+    \param   A    The matrix.
+*/
+void nonzero_column_range(
+         Index&            c0,
+         Index&            nc,
+   ConstMatrixView         A )
+{
+  c0 = 0;
+  nc = 0;
+  Index c1 = -1;
+  for( Index c=0; c<A.ncols(); c++ )
+    {
+      for( Index r=0; r<A.nrows(); r++ )
+        {
+          if( A(r,c) != 0 )
+            {
+              if( c1 < 0 )
+                { c0 = c; }
+              c1 = c;
+              break;
+            }
+        }
+    }
+  if( c1 >= 0 )
+    { nc = c1 - c0 + 1; }
+}
+
+
+
 void yCalc_mblock_loop_body(
          bool&                       failed,
          String&                     fail_msg,
@@ -1338,13 +1378,18 @@ void yCalc_mblock_loop_body(
         // Apply sensor response matrix on diyb_dx, and put into jacobian
         // (that is, analytical jacobian part)
         //
+        // Only the columns of diyb_dx holding non-zero values are considered.
+        // For e.g. limb sounding each mblock only sees a part of the
+        // retrieval grids, and *jacobian* is already set to zero.
+        //
         if( j_analytical_do )
           {
             FOR_ANALYTICAL_JACOBIANS_DO2(
-              mult(jacobian(rowind,
-                            Range(jacobian_indices[iq][0],
-                                jacobian_indices[iq][1]-jacobian_indices[iq][0]+1)),
-                                sensor_response, diyb_dx[iq] );
+              Index c0 = 0;  Index nc = 0;
+              nonzero_column_range( c0, nc, diyb_dx[iq] );
+              if( nc )
+                mult( jacobian(rowind, Range(jacobian_indices[iq][0]+c0, nc)),
+                      sensor_response, diyb_dx[iq](joker,Range(c0,nc)) );
             )
           }
 
@@ -1537,10 +1582,13 @@ void yCalc(
       Agenda l_iy_main_agenda (iy_main_agenda);
       Agenda l_geo_pos_agenda (geo_pos_agenda);
 
+      ProfilerParallel profiler_parallel;
 #pragma omp parallel for                         \
   firstprivate(l_ws, l_jacobian_agenda, l_iy_main_agenda, l_geo_pos_agenda)
       for( Index mblock_index=0; mblock_index<nmblock; mblock_index++ )
       {
+          ProfilerWorker profiler_worker(profiler_parallel);
+
           // Skip remaining iterations if an error occurred
           if (failed) continue;
 
@@ -1589,6 +1637,48 @@ void yCalc(
   // Rethrow exception if a runtime error occurred in the mblock loop
   if (failed) throw runtime_error(fail_msg);
 
+  // Report the block sparsity of the Jacobian, as a guide for the choice
+  // of retrieval grids and mblock setup
+  if( jacobian_do  &&  ( verbosity.get_screen_verbosity() >= 2  ||
+                         verbosity.get_file_verbosity() >= 2 ) )
+    {
+      CREATE_OUT2;
+      Index nnz = 0, nblocks_nz = 0, nblockel = 0;
+      for( Index mblock_index=0; mblock_index<nmblock; mblock_index++ )
+        {
+          const Range rowind = get_rowindex_for_mblock( sensor_response,
+                                                        mblock_index );
+          for( Index q=0; q<jacobian_indices.nelem(); q++ )
+            {
+              const Index c0 = jacobian_indices[q][0];
+              const Index nc = jacobian_indices[q][1] - c0 + 1;
+              Index nnz_block = 0;
+              for( Index r=rowind.get_start();
+                   r<rowind.get_start()+rowind.get_extent(); r++ )
+                for( Index c=c0; c<c0+nc; c++ )
+                  if( jacobian(r,c) != 0 )
+                    nnz_block++;
+              nnz += nnz_block;
+              if( nnz_block )
+                {
+                  nblocks_nz++;
+                  nblockel += rowind.get_extent() * nc;
+                }
+            }
+        }
+      const Index   ntot = jacobian.nrows() * jacobian.ncols();
+      const Numeric mb   = Numeric(sizeof(Numeric)) / 1048576.;
+      out2 << "  Jacobian: " << jacobian.nrows() << " x " << jacobian.ncols()
+           << ", " << nblocks_nz << " of " << nmblock*jacobian_indices.nelem()
+           << " (mblock,quantity) blocks non-zero, "
+           << ( ntot > 0 ? 1e2*Numeric(nnz)/Numeric(ntot) : 0 )
+           << "% non-zero elements.\n"
+           << "  Storage dense: " << Numeric(ntot) * mb
+           << " MB, non-zero blocks only: " << Numeric(nblockel) * mb
+           << " MB, non-zero elements only: " << Numeric(nnz) * mb
+           << " MB.\n";
+    }
+
   // Compile y_aux
   //
   const Index nq = iyb_aux_array[0].nelem();
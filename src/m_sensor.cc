@@ -47,6 +47,7 @@
 #include "arts.h"
 #include "check_input.h"
 #include "interpolation_poly.h"
+#include "lin_alg.h"
 #include "math_funcs.h"
 #include "messages.h"
 #include "ppath.h"
@@ -941,6 +942,166 @@ void f_gridMetMM(
 
 
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void f_gridSelectFromTrainingSpectra(
+   // WS Output:
+          Vector&          f_grid,
+    ArrayOfArrayOfIndex&   channel2fgrid_indexes,
+          ArrayOfVector&   channel2fgrid_weights,
+    // WS Input:
+    const ArrayOfVector&   ybatch,
+    // Control Parameters:
+    const Numeric&         max_error,
+    const Index&           max_per_channel,
+    const Verbosity&       verbosity )
+{
+  CREATE_OUT1;
+  CREATE_OUT2;
+
+  // Some sizes
+  const Index nf  = f_grid.nelem();
+  const Index nch = channel2fgrid_indexes.nelem();
+  const Index na  = ybatch.nelem();
+
+  // Checks of input
+  //
+  if( channel2fgrid_weights.nelem() != nch )
+    throw runtime_error( "*channel2fgrid_indexes* and *channel2fgrid_weights* "
+                         "must have the same length." );
+  for( Index ch=0; ch<nch; ch++ )
+    {
+      if( channel2fgrid_weights[ch].nelem() != channel2fgrid_indexes[ch].nelem() )
+        {
+          ostringstream os;
+          os << "Size mismatch between *channel2fgrid_indexes* and "
+             << "*channel2fgrid_weights* for channel " << ch << ".";
+          throw runtime_error( os.str() );
+        }
+      for( Index j=0; j<channel2fgrid_indexes[ch].nelem(); j++ )
+        {
+          if( channel2fgrid_indexes[ch][j] < 0  ||
+              channel2fgrid_indexes[ch][j] >= nf )
+            {
+              ostringstream os;
+              os << "*channel2fgrid_indexes* holds an index outside *f_grid* "
+                 << "for channel " << ch << ".";
+              throw runtime_error( os.str() );
+            }
+        }
+    }
+  if( na < 1 )
+    throw runtime_error( "*ybatch* must hold at least one training spectrum." );
+  for( Index a=0; a<na; a++ )
+    {
+      if( ybatch[a].nelem() != nf )
+        {
+          ostringstream os;
+          os << "Element " << a << " of *ybatch* has length "
+             << ybatch[a].nelem() << ", but must match *f_grid* (" << nf
+             << ").\nThe training spectra shall be monochromatic, i.e. "
+             << "calculated without sensor\nresponse, for a single viewing "
+             << "direction and *stokes_dim* = 1.";
+          throw runtime_error( os.str() );
+        }
+    }
+  if( max_error <= 0 )
+    throw runtime_error( "*max_error* must be > 0." );
+
+  // Selected indexes (in original f_grid) and weights for each channel
+  ArrayOfArrayOfIndex sel_indexes( nch );
+  ArrayOfVector       sel_weights( nch );
+
+  // Least squares system. The first na rows are the training spectra, the
+  // last row the sum of the weights. The latter makes a constant spectrum to
+  // be reproduced exactly, which improves the behaviour for atmospheric
+  // states not part of the training set.
+  const Index M = na + 1;
+
+  for( Index ch=0; ch<nch; ch++ )
+    {
+      const ArrayOfIndex& fi = channel2fgrid_indexes[ch];
+      const Index         nj = fi.nelem();
+
+      // Reference channel values
+      Vector b( M, 0 );
+      for( Index a=0; a<na; a++ )
+        for( Index j=0; j<nj; j++ )
+          b[a] += channel2fgrid_weights[ch][j] * ybatch[a][fi[j]];
+      Numeric scale = sqrt( b[Range(0,na)] * b[Range(0,na)] / Numeric(na) );
+      if( scale == 0 )
+        scale = 1;
+      b[na] = scale * channel2fgrid_weights[ch].sum();
+
+      // Greedy selection, see nonneg_omp. Stops when the maximum error
+      // over the training spectra is below max_error.
+      ArrayOfIndex sel;
+      Vector w, res;
+      const Index nmax = max_per_channel > 0 ? min( max_per_channel, nj ) : nj;
+      nonneg_omp( sel, w, res, b, nj, nmax,
+                  [&]( VectorView col, Index j ) {
+                    for( Index a=0; a<na; a++ )
+                      col[a] = ybatch[a][fi[j]];
+                    col[na] = scale;
+                  },
+                  [&]( ConstVectorView r ) {
+                    for( Index a=0; a<na; a++ )
+                      if( fabs( r[a] ) > max_error )
+                        return false;
+                    return true;
+                  } );
+      Numeric err = 0;
+      for( Index a=0; a<na; a++ )
+        err = max( err, fabs( res[a] ) );
+
+      if( !sel.nelem() )
+        {
+          ostringstream os;
+          os << "No frequency could be selected for channel " << ch << ".";
+          throw runtime_error( os.str() );
+        }
+      if( err > max_error )
+        out1 << "  WARNING: channel " << ch << " has a maximum training error "
+             << "of " << err << ", above *max_error*.\n";
+      out2 << "  Channel " << ch << ": " << sel.nelem() << " of " << nj
+           << " frequencies, maximum training error " << err << ".\n";
+
+      sel_indexes[ch].resize( sel.nelem() );
+      for( Index k=0; k<sel.nelem(); k++ )
+        sel_indexes[ch][k] = fi[sel[k]];
+      sel_weights[ch] = w;
+    }
+
+  // Form the new f_grid, holding the frequencies selected for any channel
+  ArrayOfIndex old2new( nf, -1 );
+  for( Index ch=0; ch<nch; ch++ )
+    for( Index k=0; k<sel_indexes[ch].nelem(); k++ )
+      old2new[sel_indexes[ch][k]] = 0;
+  //
+  Index nnew = 0;
+  for( Index i=0; i<nf; i++ )
+    if( old2new[i] >= 0 )
+      old2new[i] = nnew++;
+  //
+  Vector f_grid_old = f_grid;
+  f_grid.resize( nnew );
+  for( Index i=0; i<nf; i++ )
+    if( old2new[i] >= 0 )
+      f_grid[old2new[i]] = f_grid_old[i];
+
+  for( Index ch=0; ch<nch; ch++ )
+    {
+      channel2fgrid_indexes[ch].resize( sel_indexes[ch].nelem() );
+      for( Index k=0; k<sel_indexes[ch].nelem(); k++ )
+        channel2fgrid_indexes[ch][k] = old2new[sel_indexes[ch][k]];
+      channel2fgrid_weights[ch] = sel_weights[ch];
+    }
+
+  out1 << "  Selected " << nnew << " of " << nf << " frequencies for " << nch
+       << " channels.\n";
+}
+
+
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void sensor_responseAntenna(
           Sparse&         sensor_response,
@@ -2272,16 +2433,14 @@ void sensor_responseMixerBackendPrecalcWeights(
   //
   Sparse hmb( nout, nin );
   {  
+    // The precalculated weights are sparse already, and are inserted
+    // directly as elements (and not as complete rows)
+    ArrayOfIndex rowind, colind;
+    ArrayOfNumeric values;
+
     // Loop output channels
     for( Index ifr=0; ifr<nout_f; ifr++ ) 
       {
-        // The summation vector for 1 polarisation and 1 viewing direction
-        Vector w1( nin_f, 0.0 );
-        for( Index j=0; j<channel2fgrid_indexes[ifr].nelem(); j++ )
-          { 
-            w1[channel2fgrid_indexes[ifr][j]] = channel2fgrid_weights[ifr][j]; 
-          }
-
         // Loop over polarisation and spectra (viewing directions)
         // Weights change only with frequency
         // (this code is copied from function spectrometer_matrix)
@@ -2289,15 +2448,18 @@ void sensor_responseMixerBackendPrecalcWeights(
           {
             for( Index pol=0; pol<npol; pol++ ) 
               {
-                // Distribute the compact weight vector into a complte one
-                Vector weights_long( nin, 0.0 );
-                weights_long[Range(sp*nin_f*npol+pol,nin_f,npol)] = w1;
-            
-                // Insert temp_long into H at the correct row
-                hmb.insert_row( sp*nout_f*npol + ifr*npol + pol, weights_long );
+                for( Index j=0; j<channel2fgrid_indexes[ifr].nelem(); j++ )
+                  {
+                    rowind.push_back( sp*nout_f*npol + ifr*npol + pol );
+                    colind.push_back( sp*nin_f*npol +
+                                      channel2fgrid_indexes[ifr][j]*npol + pol );
+                    values.push_back( channel2fgrid_weights[ifr][j] );
+                  }
               }
           }
       }
+
+    hmb.insert_elements( values.nelem(), rowind, colind, Vector(values) );
   }
 
   // Here we need a temporary sparse that is copy of the sensor_response
@@ -25,6 +25,7 @@
 */
 
 #include "m_xml.h"
+#include "workspace_snapshot.h"
 
 
 /* Workspace method: Doxygen documentation will be auto-generated */
@@ -56,3 +57,33 @@ output_file_formatSetBinary (// WS Output:
   file_format = "binary";
 }
 
+
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void
+ReadWorkspaceSnapshot (Workspace& ws,
+                       // WS Generic Input:
+                       const String& filename,
+                       const Verbosity& verbosity)
+{
+  String f = filename;
+
+  filename_xml (f, "snapshot");
+
+  read_workspace_snapshot (ws, f, verbosity);
+}
+
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void
+WriteWorkspaceSnapshot (Workspace& ws,
+                        // WS Generic Input:
+                        const String& filename,
+                        const Verbosity& verbosity)
+{
+  String f = filename;
+
+  filename_xml (f, "snapshot");
+
+  write_workspace_snapshot (f, ws, verbosity);
+}
@@ -47,12 +47,14 @@
 #include "file.h"
 #include "methods.h"
 #include "parser.h"
+#include "profiler.h"
 #include "auto_md.h"
 #include "absorption.h"
 #include "wsv_aux.h"
 #include "agenda_record.h"
 #include "mystring.h"
 #include "workspace_ng.h"
+#include "workspace_snapshot.h"
 #include "arts_omp.h"
 #include "docserver.h"
 #include "global_data.h"
@@ -694,6 +696,28 @@ String arts_mod_time (String)
 #endif
 
 
+/** Write the profile to the file given with --profile. Errors are
+    only reported, since this is called on the way out.
+
+    \param verbosity Verbosity */
+void write_profile(const Verbosity& verbosity)
+{
+  extern const Parameters parameters;
+  CREATE_OUT0;
+
+  if (parameters.profile == "") return;
+
+  try
+    {
+      profiler_write_chrome_trace(parameters.profile, verbosity);
+    }
+  catch (const std::runtime_error &x)
+    {
+      out0 << x.what() << "\n";
+    }
+}
+
+
 /** This is the main function of ARTS. (You never guessed that, did you?)
     The getopt_long function is used to parse the command line parameters.
  
@@ -1140,6 +1164,9 @@ int main (int argc, char **argv)
            << "                    Screen:      " << verbosity.get_screen_verbosity() << "\n"
            << "                    Report file: " << verbosity.get_file_verbosity() << "\n";
 
+      if (parameters.profile != "")
+        profiler_enable();
+
       out3 << "\nReading control files:\n";
       for ( Index i=0; i<parameters.controlfiles.nelem(); ++i )
         {
@@ -1151,6 +1178,12 @@ int main (int argc, char **argv)
             Agenda tasklist;
             
             Workspace workspace;
+
+            // Restore the snapshot before parsing, the parser has to know
+            // the variables that were created in it:
+            if (parameters.snapshot != "")
+              read_workspace_snapshot(workspace, parameters.snapshot,
+                                      verbosity);
             
             // Call the parser to parse the control text:
             ArtsParser arts_parser(tasklist, parameters.controlfiles[i], verbosity);
@@ -1201,6 +1234,7 @@ int main (int argc, char **argv)
       }
 #endif
 
+      write_profile(verbosity);
       arts_exit_with_error_message(x.what(), out0);
     }
 
@@ -1226,6 +1260,8 @@ int main (int argc, char **argv)
     }
 #endif
 
+  write_profile(verbosity);
+
   out1 << "Everything seems fine. Goodbye.\n";
   arts_exit (EXIT_SUCCESS);
 }
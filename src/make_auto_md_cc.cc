@@ -91,6 +91,7 @@ int main()
           << "#include \"m_reduce.h\"\n"
           << "#include \"m_select.h\"\n"
           << "#include \"m_xml.h\"\n"
+          << "#include \"xml_io_types.h\"\n"
           << "#include \"m_basic_types.h\"\n"
           << "#include \"propagationmatrix.h\"\n"
           << "#include \"agenda_record.h\"\n"
@@ -429,6 +430,59 @@ int main()
         ofs << "};\n\n";
       }
 
+      // XML IO for workspace variables of arbitrary groups, used e.g. for
+      // workspace snapshots:
+      {
+        const Index any_group = get_wsv_group_id("Any");
+
+        ofs << "void xml_read_wsv_from_stream(istream& is_xml, Index group, void* wsv,\n"
+            << "                              bifstream* pbifs, const Verbosity& verbosity)\n"
+            << "{\n"
+            << "  switch (group)\n"
+            << "    {\n";
+        for (Index i = 0; i < wsv_group_names.nelem(); i++)
+          {
+            if (i == any_group) continue;
+            ofs << "    case " << i << ":\n"
+                << "      xml_read_from_stream(is_xml, *((" << wsv_group_names[i]
+                << "*)wsv), pbifs, verbosity);\n"
+                << "      break;\n";
+          }
+        ofs << "    default:\n"
+            << "      {\n"
+            << "        ostringstream os;\n"
+            << "        os << \"Cannot read variables of group \"\n"
+            << "           << global_data::wsv_group_names[group];\n"
+            << "        throw runtime_error(os.str());\n"
+            << "      }\n"
+            << "    }\n"
+            << "}\n\n";
+
+        ofs << "void xml_write_wsv_to_stream(ostream& os_xml, Index group, const void* wsv,\n"
+            << "                             bofstream* pbofs, const String& name,\n"
+            << "                             const Verbosity& verbosity)\n"
+            << "{\n"
+            << "  switch (group)\n"
+            << "    {\n";
+        for (Index i = 0; i < wsv_group_names.nelem(); i++)
+          {
+            if (i == any_group) continue;
+            ofs << "    case " << i << ":\n"
+                << "      xml_write_to_stream(os_xml, *((const " << wsv_group_names[i]
+                << "*)wsv), pbofs, name, verbosity);\n"
+                << "      break;\n";
+          }
+        ofs << "    default:\n"
+            << "      {\n"
+            << "        ostringstream os;\n"
+            << "        os << \"Cannot write variables of group \"\n"
+            << "           << global_data::wsv_group_names[group];\n"
+            << "        throw runtime_error(os.str());\n"
+            << "      }\n"
+            << "    }\n"
+            << "}\n\n";
+      }
+
         // Agenda execute helper function
 
       ofs << "void auto_md_agenda_execute_helper(bool& agenda_failed, String& agenda_error_msg, Workspace& ws, const Agenda& input_agenda)\n";
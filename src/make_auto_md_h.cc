@@ -670,6 +670,8 @@ int main()
           << "#include \"telsem.h\"\n"
           << "#include \"tessem.h\"\n"
           << "#include \"hitran_xsec.h\"\n"
+          << "#include \"bifstream.h\"\n"
+          << "#include \"bofstream.h\"\n"
           << "\n";
 
       ofs << "// This is only used for a consistency check. You can get the\n"
@@ -721,6 +723,13 @@ int main()
 
       ofs << "\n";
 
+      ofs << "// XML IO for workspace variables of arbitrary groups:\n"
+          << "void xml_read_wsv_from_stream(istream& is_xml, Index group, void* wsv,\n"
+          << "                              bifstream* pbifs, const Verbosity& verbosity);\n"
+          << "void xml_write_wsv_to_stream(ostream& os_xml, Index group, const void* wsv,\n"
+          << "                             bofstream* pbofs, const String& name,\n"
+          << "                             const Verbosity& verbosity);\n\n";
+
       // Create prototypes for the agenda wrappers
 
       // Initialize agenda data.
@@ -367,7 +367,8 @@ void Sparse::insert_elements(Index nelems,
                              const Vector       &data)
 {
     typedef Eigen::Triplet<Numeric> T;
-    std::vector<T> tripletList(nelems);
+    std::vector<T> tripletList;
+    tripletList.reserve(nelems);
 
     for (Index i = 0; i < nelems; i++)
     {
@@ -378,6 +379,35 @@ void Sparse::insert_elements(Index nelems,
     matrix.setFromTriplets(tripletList.begin(), tripletList.end());
 }
 
+//! Set elements from compressed sparse row arrays.
+/*!
+  Replaces all elements of the matrix. The arrays are copied directly
+  into the internal storage, which has the same layout, so no sorting
+  is needed. The column indices of each row must be sorted.
+
+  \param nnz The number of non-zero elements.
+  \param row_starts Index of the first element of each row in
+         column_indices and data, followed by nnz (nrows()+1 values).
+  \param column_indices The column index of each element.
+  \param data The values of the elements.
+*/
+void Sparse::insert_elements_csr(Index nnz,
+                                 const int     *row_starts,
+                                 const int     *column_indices,
+                                 const Numeric *data)
+{
+    assert( row_starts[nrows()] == nnz );
+
+    matrix.setZero();
+    matrix.makeCompressed();
+    matrix.resizeNonZeros( (int) nnz );
+    std::copy(row_starts, row_starts + nrows() + 1,
+              matrix.outerIndexPtr());
+    std::copy(column_indices, column_indices + nnz,
+              matrix.innerIndexPtr());
+    std::copy(data, data + nnz, matrix.valuePtr());
+}
+
 //! Resize function.
 /*!
   If the size is already correct this function does nothing.
@@ -71,6 +71,10 @@ public:
                          const ArrayOfIndex &rowind,
                          const ArrayOfIndex &colind,
                          const Vector       &data);
+    void insert_elements_csr(Index nnz,
+                             const int     *row_starts,
+                             const int     *column_indices,
+                             const Numeric *data);
 
     // Resize function:
     void resize(Index r, Index c);
@@ -116,6 +120,10 @@ public:
     int *   get_column_index_pointer() {return matrix.innerIndexPtr();}
     int *   get_row_start_pointer()    {return matrix.outerIndexPtr();}
 
+    // Remove the free space left by element insertion, so that the
+    // pointers above describe the matrix in plain CSR format.
+    void make_compressed() {matrix.makeCompressed();}
+
     // Friends:
     friend std::ostream& operator<<(std::ostream& os, const Sparse& v);
     friend void abs (Sparse& A, const Sparse& B );
@@ -666,6 +666,35 @@ void define_md_data_raw()
         ));
     
     
+  md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "abs_linesReadFromIndexedCatalogue" ),
+        DESCRIPTION
+        (
+         "Read lines from an indexed line catalogue.\n"
+         "\n"
+         "Only the lines of the species in *abs_species* that lie inside\n"
+         "[fmin, fmax] are read. The catalogue has a frequency index per\n"
+         "species, so only these lines are located, read and parsed, and\n"
+         "not the full catalogue. The lines are returned grouped by species\n"
+         "and sorted by frequency within each species.\n"
+         "\n"
+         "Indexed catalogues are created by *abs_linesWriteIndexedCatalogue*.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT( "abs_lines" ),
+        GOUT(),
+        GOUT_TYPE(),
+        GOUT_DESC(),
+        IN( "abs_species" ),
+        GIN(         "filename", "fmin",    "fmax" ),
+        GIN_TYPE(    "String",   "Numeric", "Numeric" ),
+        GIN_DEFAULT( NODEF,      NODEF,     NODEF ),
+        GIN_DESC( "Name (and path) of the catalogue file.",
+                  "Minimum frequency for lines to read [Hz].",
+                  "Maximum frequency for lines to read [Hz]." )
+        ));
+
     md_data_raw.push_back
     ( MdRecord
       ( NAME( "abs_linesReadFromLBLRTM" ),
@@ -1010,6 +1039,36 @@ void define_md_data_raw()
       GIN_DESC( "Frequency to shift line centers [Hz]." )
     ));
     
+  md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "abs_linesWriteIndexedCatalogue" ),
+        DESCRIPTION
+        (
+         "Write *abs_lines* to an indexed line catalogue.\n"
+         "\n"
+         "The catalogue is a binary file holding the lines sorted by species\n"
+         "and frequency, with an index that lets\n"
+         "*abs_linesReadFromIndexedCatalogue* load the lines of single\n"
+         "species in a frequency range without parsing the whole catalogue.\n"
+         "The line records themselves are stored in ARTSCAT form, so the\n"
+         "conversion is lossless.\n"
+         "\n"
+         "To convert a HITRAN or ARTSCAT catalogue, read it with e.g.\n"
+         "*abs_linesReadFromHitran* or *abs_linesReadFromArts* and write it\n"
+         "with this method. All lines must have the same ARTSCAT version.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT(),
+        GOUT(),
+        GOUT_TYPE(),
+        GOUT_DESC(),
+        IN( "abs_lines" ),
+        GIN(         "filename" ),
+        GIN_TYPE(    "String" ),
+        GIN_DEFAULT( NODEF ),
+        GIN_DESC(    "Name (and path) of the catalogue file." )
+        ));
+
     md_data_raw.push_back
     ( MdRecord
     ( NAME( "abs_lines_per_bandFromband_identifiers" ),
@@ -6661,6 +6720,101 @@ void define_md_data_raw()
                   "Merge frequencies that are closer than this value in Hz." )
         ));
   
+  md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "f_gridRepresentativeFromIrradiance" ),
+        DESCRIPTION
+        (
+         "Selects representative frequencies for broadband fluxes and heating\n"
+         "rates from a reference line-by-line calculation.\n"
+         "\n"
+         "Input is a *spectral_irradiance_field* calculated on the full (fine)\n"
+         "*f_grid*. The method selects a subset of *f_grid* and associated\n"
+         "quadrature weights, such that the weighted sum over the selected\n"
+         "frequencies reproduces the frequency integrated irradiance field,\n"
+         "and the net flux differences between pressure levels (determining\n"
+         "the heating rates), of the reference calculation.\n"
+         "\n"
+         "The selection is greedy: in each step the frequency best correlated\n"
+         "with the remaining residual is added, and all weights are refitted\n"
+         "by least squares. Frequencies obtaining non-positive weights are\n"
+         "dropped. The selection stops when *nf_reduced* frequencies are\n"
+         "selected, or when the relative residual falls below *rel_tol*.\n"
+         "\n"
+         "On output, *f_grid* holds the selected frequencies (sorted) and\n"
+         "*f_weights* the weights. Calculate *spectral_irradiance_field* for\n"
+         "further atmospheric states with this *f_grid* and integrate using\n"
+         "*RadiationFieldSpectralWeightedSum* instead of\n"
+         "*RadiationFieldSpectralIntegrate*.\n"
+         "\n"
+         "The maximum errors of the irradiances and heating rates of the\n"
+         "reduced representation, with respect to the reference calculation,\n"
+         "are reported at verbosity level 1. Note that these errors refer to\n"
+         "the reference atmosphere(s). Use several columns (latitudes and\n"
+         "longitudes) in the reference calculation to make the selection\n"
+         "representative for other states.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT( "f_grid" ),
+        GOUT( "f_weights" ),
+        GOUT_TYPE( "Vector" ),
+        GOUT_DESC( "Quadrature weights [Hz] of the selected frequencies." ),
+        IN( "f_grid", "p_grid", "spectral_irradiance_field",
+            "specific_heat_capacity", "g0" ),
+        GIN( "nf_reduced", "rel_tol" ),
+        GIN_TYPE( "Index", "Numeric" ),
+        GIN_DEFAULT( NODEF, "0" ),
+        GIN_DESC( "Maximum number of representative frequencies.",
+                  "Stop selection when the relative residual of the fit is\n"
+                  "below this value." )
+        ));
+
+  md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "f_gridSelectFromTrainingSpectra" ),
+        DESCRIPTION
+        (
+         "Selects a reduced set of monochromatic frequencies, and associated\n"
+         "weights, for each channel, based on a set of training spectra.\n"
+         "\n"
+         "The method starts from a fine *f_grid* and a matching channel\n"
+         "description in *channel2fgrid_indexes* and *channel2fgrid_weights*,\n"
+         "such as given by *f_gridMetMM* with a dense frequency spacing.\n"
+         "The training spectra are taken from *ybatch*. Each element must be a\n"
+         "monochromatic spectrum matching *f_grid*. That is, the batch\n"
+         "calculations shall be done without sensor response, for a single\n"
+         "viewing direction and with *stokes_dim* = 1. The training set should\n"
+         "cover the range of atmospheric states to be simulated.\n"
+         "\n"
+         "For each channel, frequencies are added one by one (greedy search,\n"
+         "in the spirit of optimal spectral sampling), and the weights of all\n"
+         "selected frequencies are fitted by least squares, until the largest\n"
+         "deviation from the reference channel value over the training set is\n"
+         "below *max_error* (same unit as *ybatch*). The fit is constrained to\n"
+         "reproduce the sum of the reference weights, and negative weights are\n"
+         "not allowed. The number of frequencies per channel can further be\n"
+         "limited by *max_per_channel*.\n"
+         "\n"
+         "On output, *f_grid* holds the frequencies selected for any channel,\n"
+         "and *channel2fgrid_indexes* and *channel2fgrid_weights* refer to the\n"
+         "new *f_grid*. The result can be used directly by\n"
+         "*sensor_responseMixerBackendPrecalcWeights* and *sensor_responseMetMM*.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT( "f_grid", "channel2fgrid_indexes", "channel2fgrid_weights" ),
+        GOUT(),
+        GOUT_TYPE(),
+        GOUT_DESC(),
+        IN( "f_grid", "channel2fgrid_indexes", "channel2fgrid_weights",
+            "ybatch" ),
+        GIN( "max_error", "max_per_channel" ),
+        GIN_TYPE( "Numeric", "Index" ),
+        GIN_DEFAULT( "0.1", "-1" ),
+        GIN_DESC( "Maximum allowed deviation over the training set.",
+                  "Maximum number of frequencies per channel. No limit "
+                  "if <= 0." )
+        ));
+
   md_data_raw.push_back     
     ( MdRecord
       ( NAME( "g0Earth" ),
@@ -7653,6 +7807,15 @@ void define_md_data_raw()
       DESCRIPTION
       (
          "So far just for testing.\n"
+         "\n"
+         "Analytical Jacobians are provided for the same quantities as for\n"
+         "*iyEmissionStandard* and for scattering species (through\n"
+         "*dpnd_field_dx*). The scattering source is taken from the fixed\n"
+         "*doit_i_field*, i.e. its dependency on the retrieval quantities is\n"
+         "neglected. Temperature Jacobians include the temperature\n"
+         "dependence of the single scattering data (extinction, absorption\n"
+         "and phase matrix), derived by a local perturbation of the\n"
+         "temperature.\n"
       ),
       AUTHORS( "Patrick Eriksson", "Jana Mendrok", "Richard Larsson" ),
         OUT( "iy", "iy_aux", "diy_dx", "ppvar_p", "ppvar_t", "ppvar_nlte",
@@ -9013,6 +9176,11 @@ void define_md_data_raw()
          "This function is added to *jacobian_agenda* by\n"
          "jacobianAddAbsSpecies and should normally not be called\n"
          "by the user.\n"
+         "\n"
+         "The perturbations are calculated in parallel (if not already\n"
+         "inside a parallel region, e.g. the mblock loop of *yCalc*). Each\n"
+         "thread holds one copy of the perturbed field. The memory usage can\n"
+         "thus be limited by the number of threads (arts -n).\n"
          ),
         AUTHORS( "Mattias Ekstrom", "Patrick Eriksson" ),
         OUT( "jacobian" ),
@@ -9227,6 +9395,11 @@ void define_md_data_raw()
          "This function is added to *jacobian_agenda* by\n"
          "jacobianAddTemperature and should normally not be called\n"
          "by the user.\n"
+         "\n"
+         "The perturbations are calculated in parallel (if not already\n"
+         "inside a parallel region, e.g. the mblock loop of *yCalc*). Each\n"
+         "thread holds one copy of the perturbed field. The memory usage can\n"
+         "thus be limited by the number of threads (arts -n).\n"
          ),
         AUTHORS( "Mattias Ekstrom", "Patrick Eriksson" ),
         OUT( "jacobian" ),
@@ -10363,6 +10536,17 @@ void define_md_data_raw()
           "Only \"1\" and \"Ze\" are allowed for *iy_unit*. The value of\n"
           "*mc_error* follows the selection for *iy_unit* (both for in- and\n"
           "output.\n"
+          "\n"
+          "Variance reduction: after each scattering event the new direction\n"
+          "is by default sampled isotropically. With *ism_fraction* > 0, this\n"
+          "fraction of the new directions is instead sampled inside a cone\n"
+          "of half-width *ism_cone* around the direction back towards the\n"
+          "receiver (importance sampling). Photons are re-weighted with the\n"
+          "sampling density, so the result is unbiased, while more photons\n"
+          "contribute to the multiple scattering signal.\n"
+          "\n"
+          "An efficiency report (photons per second and the effective sample\n"
+          "size of each range bin) is given at verbosity level 1.\n"
           ),
         AUTHORS( "Ian S. Adams" ),
         OUT( "y", "mc_error" ),
@@ -10379,14 +10563,18 @@ void define_md_data_raw()
             "atmfields_checked", "atmgeom_checked", "scat_data_checked",
             "cloudbox_checked", "iy_unit", "mc_max_scatorder", "mc_seed", 
             "mc_max_iter" ),
-        GIN(      "ze_tref", "k2", "t_interp_order" ),
-        GIN_TYPE( "Numeric", "Numeric", "Index" ),
-        GIN_DEFAULT( "273.15", "-1", "1" ),
+        GIN(      "ze_tref", "k2", "t_interp_order", "ism_fraction",
+                  "ism_cone" ),
+        GIN_TYPE( "Numeric", "Numeric", "Index", "Numeric", "Numeric" ),
+        GIN_DEFAULT( "273.15", "-1", "1", "0", "10" ),
         GIN_DESC( "Reference temperature for conversion to Ze.",
                   "Reference dielectric factor.",
                   "Interpolation order of temperature for scattering data (so"
                   " far only applied in phase matrix, not in extinction and"
-                  " absorption." )
+                  " absorption.",
+                  "Fraction of scattering directions sampled towards the"
+                  " receiver (0 = isotropic sampling only).",
+                  "Half-width [deg] of the cone used for importance sampling." )
         ));
 
 
@@ -11000,6 +11188,14 @@ void define_md_data_raw()
          "for the linear system that has to be solved in each minimzation step.\n"
          "This of advantage for very large problems, that would otherwise require\n"
          "the computation of expensive matrix products.\n"
+         "The variants li_pcg, gn_pcg and lm_pcg use instead a Jacobi\n"
+         "preconditioned conjugate gradient solver. The linear system is only\n"
+         "accessed through products with *jacobian* and its transpose, and the\n"
+         "preconditioner is derived from the diagonals of the inverse covariance\n"
+         "matrices, including the damping of the LM methods. This gives faster\n"
+         "convergence of the CG iteration for large state vectors. To avoid\n"
+         "any n x n matrix, also leave *x_norm* empty and set *clear_matrices*\n"
+         "to 1 (*dxdy* is otherwise computed).\n"
          "\n"
          "Description of the special input arguments:\n"
          "\n"
@@ -11010,6 +11206,8 @@ void define_md_data_raw()
          "  \"gn_cg\": Non-linear, with Gauss-Newton and conjugate gradient solver.\n"
          "  \"lm\": Non-linear, with Levenberg-Marquardt (LM) iteration scheme.\n"
          "  \"lm_cg\": Non-linear, with Levenberg-Marquardt (LM) iteration scheme and conjugate gradient solver.\n"
+         "  \"li_pcg\", \"gn_pcg\", \"lm_pcg\": As the _cg variants, but with a\n"
+         "     preconditioned conjugate gradient solver.\n"
          "*max_start_cost*\n"
          "  No inversion is done if the cost matching the a priori state is above\n"
          "  this value. If set to a negative value, all values are accepted.\n"
@@ -11049,6 +11247,35 @@ void define_md_data_raw()
          "*display_progress*\n"
          "   Controls if there is any screen output. The overall report level\n"
          "   is ignored by this WSM.\n"
+         "*checkpoint_file*\n"
+         "   If set, the state vector, *yf*, *jacobian* and *lm_ga_history*\n"
+         "   are saved (binary XML) each time a new Jacobian is obtained. The\n"
+         "   file names are formed by appending \".x.xml\", \".yf.xml\",\n"
+         "   \".jacobian.xml\" and \".lm_ga_history.xml\" to the given basename.\n"
+         "   The number of the iteration the state belongs to, and the\n"
+         "   (normalised) cost of each iteration so far, are saved as\n"
+         "   \".iteration.xml\" and \".cost_history.xml\". For the LM methods,\n"
+         "   the present gamma factor is also saved (\".lm_ga.xml\"). If the\n"
+         "   saved state vector equals *x*, the inversion starts with this\n"
+         "   gamma factor instead of the one in *lm_ga_settings*.\n"
+         "*checkpoint_resume*\n"
+         "   If set to 1, an interrupted inversion is resumed from the files of\n"
+         "   *checkpoint_file*. *x*, *yf* and *jacobian* are then read from\n"
+         "   these files, and the iterations already done count towards\n"
+         "   *max_iter*. The iteration numbers, *lm_ga_history* and the start\n"
+         "   cost in *oem_diagnostics* continue those of the interrupted run.\n"
+         "   If there are no checkpoint files, the inversion starts from\n"
+         "   scratch, so the same call can be used for a first run and\n"
+         "   restarts.\n"
+         "*jacobian_update*\n"
+         "   \"full\": *jacobian* is calculated by *inversion_iterate_agenda*\n"
+         "      for each iteration.\n"
+         "   \"broyden\": *jacobian* is calculated (or taken from input) only\n"
+         "      for the first iteration, and then adjusted by Broyden's rank-one\n"
+         "      update. For a series of similar scenes, the Jacobian of the\n"
+         "      previous scene can be given as input and no Jacobian calculation\n"
+         "      is needed at all. *yf* must be set as well, but only *jacobian*\n"
+         "      is taken from input and *yf* is recalculated for the start state.\n"
          ),
         AUTHORS( "Patrick Eriksson" ),
         OUT( "x", "yf", "jacobian", "dxdy", "oem_diagnostics", "lm_ga_history", "oem_errors"),
@@ -11058,11 +11285,12 @@ void define_md_data_raw()
         IN( "xa", "x", "covmat_sx", "yf", "y", "covmat_se", "jacobian",
             "jacobian_do", "jacobian_quantities", "inversion_iterate_agenda" ),
         GIN( "method", "max_start_cost", "x_norm", "max_iter", "stop_dx", 
-             "lm_ga_settings", "clear_matrices", "display_progress" ),
+             "lm_ga_settings", "clear_matrices", "display_progress",
+             "checkpoint_file", "jacobian_update", "checkpoint_resume" ),
         GIN_TYPE( "String", "Numeric", "Vector", "Index", "Numeric", 
-                  "Vector", "Index", "Index" ),
+                  "Vector", "Index", "Index", "String", "String", "Index" ),
         GIN_DEFAULT( NODEF, "Inf", "[]", "10", "0.01", 
-                     "[]", "0", "0" ),
+                     "[]", "0", "0", "", "full", "0" ),
         GIN_DESC( "Iteration method. For this and all options below, see "
                   "further above.",
                   "Maximum allowed value of cost function at start.",
@@ -11072,7 +11300,10 @@ void define_md_data_raw()
                   "Settings associated with the ga factor of the LM method.",
                   "An option to save memory.",
                   "Flag to control if inversion diagnostics shall be printed "
-                  "on the screen.")
+                  "on the screen.",
+                  "Basename of checkpoint files. No files written if empty.",
+                  "Jacobian update scheme, \"full\" or \"broyden\".",
+                  "Flag to resume from checkpoint files.")
         ));
 
   md_data_raw.push_back
@@ -11758,6 +11989,49 @@ void define_md_data_raw()
         GIN_DESC( "Order of bin quadrature." )
         ));
  
+  md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "pnd_fieldCalcFromBulkTable" ),
+        DESCRIPTION
+        (
+         "Maps particle bulk property data to *pnd_field*, for scattering\n"
+         "data prepared by *ScatSpeciesBulkTableCalc*.\n"
+         "\n"
+         "Each scattering element of a species then represents the bulk\n"
+         "properties at one value of *bulk_grid*. For each cloudbox point,\n"
+         "the value x of the species' bulk property (the single input of\n"
+         "its pnd-agenda, taken from *particle_bulkprop_field*) is mapped\n"
+         "to the two surrounding table nodes, interpolating linearly in\n"
+         "log(x) after normalising each node by its bulk property value.\n"
+         "Below the first value of *bulk_grid*, the properties of the first\n"
+         "node are scaled linearly with x. Values above the end of\n"
+         "*bulk_grid* give an error.\n"
+         "\n"
+         "Temperature dependency is handled by the temperature grid of the\n"
+         "table elements. At most two elements per species are non-zero at\n"
+         "each point.\n"
+         "\n"
+         "If *jacobian_do* is set, *dpnd_field_dx* is calculated for\n"
+         "scattering species Jacobian quantities with respect to the bulk\n"
+         "property of the table.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT( "pnd_field", "dpnd_field_dx" ),
+        GOUT(),
+        GOUT_TYPE(),
+        GOUT_DESC(),
+        IN( "atmosphere_dim", "p_grid", "lat_grid", "lon_grid",
+            "cloudbox_on", "cloudbox_limits", "scat_species", "scat_data",
+            "particle_bulkprop_field", "particle_bulkprop_names",
+            "pnd_agenda_array_input_names",
+            "jacobian_do", "jacobian_quantities" ),
+        GIN( "bulk_grid" ),
+        GIN_TYPE( "Vector" ),
+        GIN_DEFAULT( NODEF ),
+        GIN_DESC( "Bulk property values of the table nodes (must match the"
+                  " one used in *ScatSpeciesBulkTableCalc*)." )
+        ));
+
   md_data_raw.push_back
     ( MdRecord
       ( NAME( "pnd_fieldCalcFromParticleBulkProps" ),
@@ -13659,6 +13933,34 @@ void define_md_data_raw()
         GIN_DEFAULT(NODEF),
         GIN_DESC("TBD")
         ));
+
+ md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "RadiationFieldSpectralWeightedSum" ),
+        DESCRIPTION
+        (
+         "Sums fields like *spectral_irradiance_field* or *doit_i_field*\n"
+         "over frequency, using given quadrature weights.\n"
+         "\n"
+         "This is the counterpart of *RadiationFieldSpectralIntegrate* for a\n"
+         "reduced spectral representation, where *f_grid* and the weights\n"
+         "are obtained by *f_gridRepresentativeFromIrradiance*.\n"
+         "Important, the first dimension must be the frequency dimension!\n"
+         "If a field  like *doit_i_field* is input, the stokes dimension\n"
+         "is also removed.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT( ),
+        GOUT("radiation_field"),
+        GOUT_TYPE("Tensor4, Tensor5"),
+        GOUT_DESC("Frequency summed field."),
+        IN("f_grid"),
+        GIN("spectral_radiation_field", "f_weights"),
+        GIN_TYPE("Tensor5, Tensor7", "Vector"),
+        GIN_DEFAULT(NODEF, NODEF),
+        GIN_DESC("Spectral field, frequency as first dimension.",
+                 "Quadrature weight of each frequency [Hz].")
+        ));
     
  md_data_raw.push_back
     ( MdRecord
@@ -13734,8 +14036,8 @@ void define_md_data_raw()
         AUTHORS( "Oliver Lemke" ),
         OUT(),
         GOUT(      "out"    ),
-        GOUT_TYPE( "Vector, Matrix, Tensor3, Tensor4, Tensor5, ArrayOfVector,"
-                   "ArrayOfMatrix, GasAbsLookup" ),
+        GOUT_TYPE( "Vector, Matrix, Tensor3, Tensor4, Tensor5, Tensor6, Tensor7,"
+                   "ArrayOfVector, ArrayOfMatrix, GasAbsLookup" ),
         GOUT_DESC( "Variable to be read." ),
         IN(),
         GIN(         "filename" ),
@@ -13749,6 +14051,76 @@ void define_md_data_raw()
         PASSWSVNAMES(   true  )
         ));
 
+  md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "ReadNetCDFSlab" ),
+        DESCRIPTION
+        (
+         "Reads a hyperslab of a tensor from a NetCDF file.\n"
+         "\n"
+         "Reads the part of the tensor that starts at the indices given by\n"
+         "*start* and has the extents given by *count*, one value per\n"
+         "dimension. A negative count selects all elements from the start\n"
+         "index to the end of that dimension. If *start* and *count* are\n"
+         "empty, the whole tensor is read.\n"
+         "\n"
+         "Only the requested part is read from the file, which makes it\n"
+         "possible to work on single frequencies or positions of large\n"
+         "fields stored by *WriteNetCDF*.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT(),
+        GOUT(      "out"    ),
+        GOUT_TYPE( "Tensor3, Tensor4, Tensor5, Tensor6, Tensor7" ),
+        GOUT_DESC( "Variable to be read." ),
+        IN(),
+        GIN(         "filename", "start",        "count" ),
+        GIN_TYPE(    "String",   "ArrayOfIndex", "ArrayOfIndex" ),
+        GIN_DEFAULT( NODEF,      "[]",           "[]" ),
+        GIN_DESC(    "Name of the NetCDF file.",
+                     "Start index along each dimension.",
+                     "Number of elements along each dimension." ),
+        SETMETHOD(      false ),
+        AGENDAMETHOD(   false ),
+        USES_TEMPLATES( true  )
+        ));
+
+  md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "ReadWorkspaceSnapshot" ),
+        DESCRIPTION
+        (
+         "Restores workspace variables from a snapshot file.\n"
+         "\n"
+         "Reads a snapshot written by *WriteWorkspaceSnapshot*. All variables\n"
+         "stored in the snapshot are set, including agendas and variables\n"
+         "created in the controlfile of the run that wrote the snapshot.\n"
+         "Variables that do not exist yet are added to the workspace.\n"
+         "\n"
+         "To start a run directly from a snapshot, use the command line\n"
+         "option --snapshot instead. It restores the snapshot before the\n"
+         "controlfile is parsed, so that the controlfile can use the\n"
+         "variables created in the snapshot.\n"
+         "\n"
+         "If the filename is omitted, the snapshot is read from\n"
+         "<basename>.snapshot.xml.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT(),
+        GOUT(),
+        GOUT_TYPE(),
+        GOUT_DESC(),
+        IN(),
+        GIN(         "filename" ),
+        GIN_TYPE(    "String" ),
+        GIN_DEFAULT( "" ),
+        GIN_DESC(    "Name of the snapshot file." ),
+        SETMETHOD(      false ),
+        AGENDAMETHOD(   false ),
+        USES_TEMPLATES( false ),
+        PASSWORKSPACE(  true  )
+        ));
+
   md_data_raw.push_back
     ( MdRecord
       ( NAME( "ReadXML" ),
@@ -14881,6 +15253,12 @@ void define_md_data_raw()
          "angular dimension of the output *doit_i_field* is fixed to the\n"
          "*nstreams* given as input to this WSM.\n"
          "\n"
+         "Without *auto_inc_nstreams*, the quadrature is fixed and the layer\n"
+         "optical properties are derived in parallel for blocks of\n"
+         "frequencies (one frequency per thread), while the RT4 solver calls\n"
+         "themselves are done serially. Timings of the two stages are\n"
+         "reported at verbosity level 2.\n"
+         "\n"
          "Quadrature methods available are: 'L'obatto, 'G'auss-Legendre and\n"
          "'D'ouble Gauss quadrature.\n"
          "\n"
@@ -15260,6 +15638,48 @@ void define_md_data_raw()
         ));
 
  
+  md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "ScatSpeciesBulkTableCalc" ),
+        DESCRIPTION
+        (
+         "Replaces the scattering elements of each species by bulk\n"
+         "single scattering properties tabulated over a bulk property.\n"
+         "\n"
+         "For each value x of *bulk_grid* and each temperature of *T_grid*\n"
+         "the pnd-agenda of the species is executed, and the pnd-weighted\n"
+         "sum of the single scattering properties of all its elements is\n"
+         "stored as a new scattering element with temperature grid *T_grid*.\n"
+         "Each species thus gets *bulk_grid* elements, irrespective of the\n"
+         "number of size bins, and the sum over size bins is done once here\n"
+         "instead of at each atmospheric point and RT call. Use\n"
+         "*pnd_fieldCalcFromBulkTable* to obtain the matching *pnd_field*.\n"
+         "\n"
+         "Requirements: Each pnd-agenda must have a single input (beside\n"
+         "temperature), and all elements of a species must share ptype,\n"
+         "*f_grid*, *za_grid* and *aa_grid* (no angular or frequency\n"
+         "interpolation is made). Table temperatures outside the temperature\n"
+         "grid of an element are mapped to the closest end of that grid.\n"
+         "The method shall be applied on *scat_data* (not *scat_data_raw*),\n"
+         "and *scat_meta* is replaced by dummy entries.\n"
+         "\n"
+         "The accuracy of the approach depends on the spacing of\n"
+         "*bulk_grid*. A logarithmic spacing is recommended.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT( "scat_data", "scat_meta" ),
+        GOUT(),
+        GOUT_TYPE(),
+        GOUT_DESC(),
+        IN( "scat_data", "scat_meta", "pnd_agenda_array",
+            "pnd_agenda_array_input_names" ),
+        GIN( "bulk_grid", "T_grid" ),
+        GIN_TYPE( "Vector", "Vector" ),
+        GIN_DEFAULT( NODEF, NODEF ),
+        GIN_DESC( "Bulk property values of the table nodes.",
+                  "Temperatures of the table." )
+        ));
+
   md_data_raw.push_back
     ( MdRecord
       ( NAME( "ScatSpeciesExtendTemperature" ),
@@ -15462,6 +15882,12 @@ void define_md_data_raw()
          "Important note:\n"
          "The order of the filenames for the single scattering data files has to\n"
          "exactly correspond to the order of the scattering meta data files.\n"
+         "\n"
+         "To reduce memory usage for large databases, the frequency range of\n"
+         "the data to keep can be limited by *fmin* and *fmax*. All data\n"
+         "frequencies not needed to interpolate to this range (see\n"
+         "*scat_dataCalc*) are skipped while reading each file, so they are\n"
+         "never held in memory. Set the range to cover *f_grid*.\n"
          ),
         AUTHORS( "Daniel Kreyling, Oliver Lemke, Jana Mendrok" ),
         OUT( "scat_data_raw", "scat_meta" ),
@@ -15469,10 +15895,12 @@ void define_md_data_raw()
         GOUT_TYPE(),
         GOUT_DESC(),
         IN( "scat_data_raw", "scat_meta" ),
-        GIN(         "scat_data_files" ),
-        GIN_TYPE(    "ArrayOfString" ),
-        GIN_DEFAULT( NODEF ),
-        GIN_DESC( "Array of single scattering data file names." )
+        GIN(         "scat_data_files", "fmin",    "fmax" ),
+        GIN_TYPE(    "ArrayOfString",   "Numeric", "Numeric" ),
+        GIN_DEFAULT( NODEF,             "0",       "1e99" ),
+        GIN_DESC( "Array of single scattering data file names.",
+                  "Lower frequency limit of data to keep.",
+                  "Upper frequency limit of data to keep." )
         ));
 
   md_data_raw.push_back
@@ -19458,6 +19886,12 @@ void define_md_data_raw()
          "\n"
          "If the filename is omitted, the variable is written\n"
          "to <basename>.<variable_name>.nc.\n"
+         "\n"
+         "The file format is selected by *format*. \"netcdf4\" gives a\n"
+         "NetCDF-4 (HDF5) file, with the data chunked along the leading\n"
+         "dimensions and compressed with deflate. \"classic\" gives an\n"
+         "uncompressed file in the classic NetCDF format, readable by\n"
+         "software linked against NetCDF libraries without NetCDF-4 support.\n"
          ),
         AUTHORS( "Oliver Lemke" ),
         OUT(),
@@ -19466,14 +19900,18 @@ void define_md_data_raw()
         GOUT_DESC(),
         IN(),
         GIN(          "in",
-                      "filename" ),
-        GIN_TYPE(     "Vector, Matrix, Tensor3, Tensor4, Tensor5, ArrayOfVector,"
-                      "ArrayOfMatrix, GasAbsLookup",
+                      "filename",
+                      "format" ),
+        GIN_TYPE(     "Vector, Matrix, Tensor3, Tensor4, Tensor5, Tensor6, Tensor7,"
+                      "ArrayOfVector, ArrayOfMatrix, GasAbsLookup",
+                      "String",
                       "String" ),
         GIN_DEFAULT(  NODEF,
-                      "" ),
+                      "",
+                      "netcdf4" ),
         GIN_DESC(     "Variable to be saved.",
-                      "Name of the NetCDF file." ),
+                      "Name of the NetCDF file.",
+                      "File format, \"netcdf4\" or \"classic\"." ),
         SETMETHOD(      false ),
         AGENDAMETHOD(   false ),
         USES_TEMPLATES( true  ),
@@ -19500,14 +19938,18 @@ void define_md_data_raw()
         GOUT_DESC(),
         IN( "file_index" ),
         GIN(          "in",
-                      "filename" ),
-        GIN_TYPE(     "Vector, Matrix, Tensor3, Tensor4, Tensor5, ArrayOfVector,"
-                      "ArrayOfMatrix, GasAbsLookup",
+                      "filename",
+                      "format" ),
+        GIN_TYPE(     "Vector, Matrix, Tensor3, Tensor4, Tensor5, Tensor6, Tensor7,"
+                      "ArrayOfVector, ArrayOfMatrix, GasAbsLookup",
+                      "String",
                       "String" ),
         GIN_DEFAULT(  NODEF,
-                      "" ),
+                      "",
+                      "netcdf4" ),
         GIN_DESC(     "Variable to be saved.",
-                      "Name of the NetCDF file." ),
+                      "Name of the NetCDF file.",
+                      "File format, \"netcdf4\" or \"classic\"." ),
         SETMETHOD(      false ),
         AGENDAMETHOD(   false ),
         USES_TEMPLATES( true  ),
@@ -19515,6 +19957,42 @@ void define_md_data_raw()
         PASSWSVNAMES(   true  )
         ));
 
+  md_data_raw.push_back
+    ( MdRecord
+      ( NAME( "WriteWorkspaceSnapshot" ),
+        DESCRIPTION
+        (
+         "Writes all initialized workspace variables to a snapshot file.\n"
+         "\n"
+         "The snapshot contains the complete state of the workspace,\n"
+         "including agendas, loaded data and variables created in the\n"
+         "controlfile. It is stored in binary XML format. A controlfile\n"
+         "that does all the setup of a calculation can end with this method,\n"
+         "later runs then start from the snapshot with the command line\n"
+         "option --snapshot and skip the setup.\n"
+         "\n"
+         "Variables of groups without XML support (e.g. *MCAntenna*) are not\n"
+         "stored, a warning is printed for them.\n"
+         "\n"
+         "If the filename is omitted, the snapshot is written to\n"
+         "<basename>.snapshot.xml.\n"
+         ),
+        AUTHORS( "agent" ),
+        OUT(),
+        GOUT(),
+        GOUT_TYPE(),
+        GOUT_DESC(),
+        IN(),
+        GIN(         "filename" ),
+        GIN_TYPE(    "String" ),
+        GIN_DEFAULT( "" ),
+        GIN_DESC(    "Name of the snapshot file." ),
+        SETMETHOD(      false ),
+        AGENDAMETHOD(   false ),
+        USES_TEMPLATES( false ),
+        PASSWORKSPACE(  true  )
+        ));
+
   md_data_raw.push_back
     ( MdRecord
       ( NAME( "WriteXML" ),
@@ -19946,6 +20424,12 @@ void define_md_data_raw()
          "The Jacobian provided (*jacobian*) is adopted to selected retrieval\n"
          "units, but no transformations are applied. Transformations are\n"
          "included by calling *jacobianAdjustAndTranform*.\n"
+         "\n"
+         "The sensor response is only applied on the part of each retrieval\n"
+         "grid that gives a non-zero contribution to a measurement block.\n"
+         "The sparsity of the obtained Jacobian is reported at verbosity\n"
+         "level 2, including the storage that a block-sparse representation\n"
+         "would need. The Jacobian itself is always stored as a dense matrix.\n"
          ),
         AUTHORS( "Patrick Eriksson" ),
         OUT( "y", "y_f", "y_pol", "y_pos", "y_los", "y_aux", "y_geo", "jacobian" ),
@@ -2223,3 +2223,88 @@ void Sample_los_uniform (
   new_rte_los[0] = acos( 1 - 2 * rng.draw() ) * RAD2DEG;
 }
 
+
+
+
+//! Sample_los_mixture
+/*!
+   Samples a line of sight from a mixture of an isotropic distribution and
+   a uniform distribution inside a cone around a preferred direction.
+
+   With probability *cone_frac* the new direction is drawn inside the cone
+   of half-width *cone_width* around *pref_los*, otherwise it is drawn
+   uniformly over the full sphere. The returned *pdf* is the probability
+   density (per steradian) of the mixture evaluated at the selected
+   direction, to be used as importance weight by the calling function.
+
+   For *cone_frac* = 0 the function is equivalent to Sample_los_uniform
+   (including the number of random numbers drawn), and *pdf* = 1/(4*pi).
+
+   \param[out]    new_rte_los  Selected line of sight.
+   \param[out]    pdf          Probability density of the selected direction.
+   \param[in,out] rng          Rng random number generator instance.
+   \param[in]     pref_los     Centre of the cone (zenith, azimuth) [deg].
+   \param[in]     cone_frac    Fraction of samples taken inside the cone.
+   \param[in]     cone_width   Half-width of the cone [deg].
+*/
+void Sample_los_mixture (
+                         VectorView       new_rte_los,
+                         Numeric&         pdf,
+                         Rng&             rng,
+                         ConstVectorView  pref_los,
+                   const Numeric          cone_frac,
+                   const Numeric          cone_width
+                        )
+{
+  assert( cone_frac >= 0  &&  cone_frac <= 1 );
+  assert( cone_width > 0  &&  cone_width <= 180 );
+
+  const Numeric cos_c   = cos( DEG2RAD * cone_width );
+  const Numeric cone_sr = 2 * PI * ( 1 - cos_c );
+
+  // Unit vector of cone centre
+  Numeric cx, cy, cz;
+  zaaa2cart( cx, cy, cz, pref_los[0], pref_los[1] );
+
+  if( cone_frac > 0  &&  rng.draw() < cone_frac )
+    {
+      // Polar angle relative to cone centre and rotation around centre
+      const Numeric cos_t = 1 - rng.draw() * ( 1 - cos_c );
+      const Numeric sin_t = sqrt( max( 0.0, 1 - cos_t * cos_t ) );
+      const Numeric phi   = 2 * PI * rng.draw();
+
+      // Orthonormal basis (u,v) perpendicular to the centre vector, built
+      // from the coordinate axis least aligned with the centre
+      Numeric ux, uy, uz;
+      if( abs( cz ) < 0.9 )
+        { ux = cy;  uy = -cx;  uz = 0; }
+      else
+        { ux = 0;  uy = cz;  uz = -cy; }
+      const Numeric un = sqrt( ux * ux + uy * uy + uz * uz );
+      ux /= un;  uy /= un;  uz /= un;
+      const Numeric vx = cy * uz - cz * uy;
+      const Numeric vy = cz * ux - cx * uz;
+      const Numeric vz = cx * uy - cy * ux;
+
+      const Numeric a = sin_t * cos( phi );
+      const Numeric b = sin_t * sin( phi );
+      cart2zaaa( new_rte_los[0], new_rte_los[1],
+                 cos_t * cx + a * ux + b * vx,
+                 cos_t * cy + a * uy + b * vy,
+                 cos_t * cz + a * uz + b * vz );
+    }
+  else
+    {
+      Sample_los_uniform( new_rte_los, rng );
+    }
+
+  // Mixture density at selected direction
+  pdf = ( 1 - cone_frac ) / ( 4 * PI );
+  if( cone_frac > 0 )
+    {
+      Numeric dx, dy, dz;
+      zaaa2cart( dx, dy, dz, new_rte_los[0], new_rte_los[1] );
+      if( dx * cx + dy * cy + dz * cz >= cos_c )
+        { pdf += cone_frac / cone_sr; }
+    }
+}
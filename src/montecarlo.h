@@ -246,4 +246,11 @@ void Sample_los (VectorView       new_rte_los,
 void Sample_los_uniform (VectorView    new_rte_los,
                          Rng&          rng);
 
+void Sample_los_mixture (VectorView       new_rte_los,
+                         Numeric&         pdf,
+                         Rng&             rng,
+                         ConstVectorView  pref_los,
+                   const Numeric          cone_frac,
+                   const Numeric          cone_width);
+
 #endif  // montecarlo_h
@@ -143,6 +143,9 @@ void nca_read_from_file(const String&    filename,
 /*!
  \param[in]  filename    NetCDF filename
  \param[in]  type        Output variable
+ \param[in]  netcdf4     Write a NetCDF-4 (HDF5) file instead of a classic
+                         one. Only NetCDF-4 files hold chunked and
+                         compressed variables.
  \param[in]  verbosity   Verbosity
  
  \author Oliver Lemke
@@ -150,6 +153,7 @@ void nca_read_from_file(const String&    filename,
 template<typename T>
 void nca_write_to_file(const String&    filename,
                        const T&         type,
+                       const bool       netcdf4,
                        const Verbosity& verbosity)
 {
   CREATE_OUT2;
@@ -158,10 +162,20 @@ void nca_write_to_file(const String&    filename,
   
   out2 << "  Writing " << efilename << '\n';
 
+#ifdef NC_NETCDF4
+  const int cmode = netcdf4 ? NC_CLOBBER | NC_NETCDF4 : NC_CLOBBER;
+#else
+  if (netcdf4)
+    throw runtime_error("The NetCDF library ARTS was compiled with does not "
+                        "support NetCDF-4 files.\n"
+                        "Use the classic format instead.");
+  const int cmode = NC_CLOBBER;
+#endif
+
 #pragma omp critical(netcdf__critical_region)
     {
   int ncid;
-  if (nc_create(efilename.c_str(), NC_CLOBBER, &ncid))
+  if (nc_create(efilename.c_str(), cmode, &ncid))
     {
       ostringstream os;
       os << "Error writing file: " << efilename << endl;
@@ -185,6 +199,55 @@ void nca_write_to_file(const String&    filename,
 }
 
 
+//! Reads a hyperslab of a variable from a NetCDF file
+/*!
+ \param[in]  filename    NetCDF filename
+ \param[out] type        Input variable
+ \param[in]  start       Start index along each dimension
+ \param[in]  count       Number of elements along each dimension
+ \param[in]  verbosity   Verbosity
+*/
+template<typename T>
+void nca_read_slab_from_file(const String&       filename,
+                             T&                  type,
+                             const ArrayOfIndex& start,
+                             const ArrayOfIndex& count,
+                             const Verbosity&    verbosity)
+{
+  CREATE_OUT2;
+
+  String efilename = expand_path(filename);
+
+  out2 << "  Reading hyperslab from " << efilename << '\n';
+
+#pragma omp critical(netcdf__critical_region)
+    {
+  int ncid;
+  if (nc_open(efilename.c_str(), NC_NOWRITE, &ncid))
+    {
+      ostringstream os;
+      os << "Error reading file: " << efilename << endl;
+      throw runtime_error(os.str());
+    }
+
+  try
+    {
+      nca_read_slab_from_file(ncid, type, start, count, verbosity);
+    }
+  catch (const std::runtime_error &e)
+    {
+      nc_close(ncid);
+      ostringstream os;
+      os << "Error reading file: " << efilename << endl;
+      os << e.what() << endl;
+      throw runtime_error(os.str());
+    }
+
+  nc_close(ncid);
+    }
+}
+
+
 //! Define NetCDF dimension.
 /** 
  \param[in]  ncid   NetCDF file descriptor
@@ -219,6 +282,55 @@ void nca_def_var(const int ncid, const String& name, const nc_type type, const i
   int retval;
   if ((retval = nc_def_var(ncid, name.c_str(), type, ndims, dims, varid)))
     nca_error(retval, "nc_def_var");
+  if (type == NC_DOUBLE)
+    nca_compress_var(ncid, *varid, ndims, dims);
+}
+
+
+//! Enable chunking and compression for a NetCDF variable.
+/**
+ Only has an effect for NetCDF-4 files. The chunks span the trailing
+ (fastest varying) dimensions up to about one MB, so that reading a
+ slice along the leading dimensions touches as few chunks as possible.
+ Data are compressed with the shuffle filter and deflate level 1, which
+ is much faster than the higher levels at a small loss in ratio.
+
+ \param[in]  ncid   NetCDF file descriptor
+ \param[in]  varid  NetCDF variable handle
+ \param[in]  ndims  Number of dimensions
+ \param[in]  dims   Pointer to dimensions
+ */
+void nca_compress_var(const int ncid, const int varid, const int ndims,
+                      const int* dims)
+{
+#ifdef NC_NETCDF4
+  const size_t max_chunk_elems = 131072;
+
+  int retval, format;
+  if ((retval = nc_inq_format(ncid, &format)))
+    nca_error(retval, "nc_inq_format");
+  if (format != NC_FORMAT_NETCDF4 || ndims < 1) return;
+
+  size_t chunks[NC_MAX_VAR_DIMS];
+  size_t chunk_elems = 1;
+  for (int i = ndims - 1; i >= 0; i--)
+    {
+      size_t len;
+      if ((retval = nc_inq_dimlen(ncid, dims[i], &len)))
+        nca_error(retval, "nc_inq_dimlen");
+      if (!len) return;
+
+      chunks[i] = min(len, max((size_t)1, max_chunk_elems / chunk_elems));
+      chunk_elems *= chunks[i];
+    }
+
+  if ((retval = nc_def_var_chunking(ncid, varid, NC_CHUNKED, chunks)))
+    nca_error(retval, "nc_def_var_chunking");
+  if ((retval = nc_def_var_deflate(ncid, varid, 1, 1, 1)))
+    nca_error(retval, "nc_def_var_deflate");
+#else
+  (void)ncid; (void)varid; (void)ndims; (void)dims;
+#endif
 }
 
 
@@ -423,6 +535,26 @@ void nca_get_dataa_double(const int ncid, const String& name,
 }
 
 
+//! Read a hyperslab of a variable of type double from NetCDF file.
+/**
+ \param[in]  ncid   NetCDF file descriptor
+ \param[in]  name   Variable name in NetCDF file
+ \param[in]  start  Start index along each dimension
+ \param[in]  count  Number of elements along each dimension
+ \param[out] data   Data read from file
+ */
+void nca_get_slab_double(const int ncid, const String& name,
+                         const size_t* start, const size_t* count,
+                         Numeric* data)
+{
+  int retval, varid;
+  if ((retval = nc_inq_varid(ncid, name.c_str(), &varid)))
+    nca_error(retval, "nc_inq_varid("+name+")");
+  if ((retval = nc_get_vara_double(ncid, varid, start, count, data)))
+    nca_error(retval, "nc_get_vara("+name+")");
+}
+
+
 //! Read variable of type array of char from NetCDF file.
 /** 
  \param[in]  ncid   NetCDF file descriptor
@@ -59,7 +59,14 @@ void nca_read_from_file(const String& filename, T& type, const Verbosity& verbos
 
 
 template<typename T>
-void nca_write_to_file(const String& filename, const T& type, const Verbosity& verbosity);
+void nca_write_to_file(const String& filename, const T& type,
+                       const bool netcdf4, const Verbosity& verbosity);
+
+template<typename T>
+void nca_read_slab_from_file(const String& filename, T& type,
+                             const ArrayOfIndex& start,
+                             const ArrayOfIndex& count,
+                             const Verbosity& verbosity);
 
 
 /*void nc_read_var(const int ncf, const int **ncvar,
@@ -69,6 +76,9 @@ void nca_def_dim(const int ncid, const String& name, const Index nelem, int* ncd
 void nca_def_var(const int ncid, const String& name, const nc_type type, const int ndims,
                  const int* dims, int* varid);
 
+void nca_compress_var(const int ncid, const int varid, const int ndims,
+                      const int* dims);
+
 int nca_def_ArrayOfIndex(const int ncid, const String& name, const ArrayOfIndex& a);
 
 int nca_def_Vector(const int ncid, const String& name, const Vector& v);
@@ -88,6 +98,10 @@ void nca_get_data_double(const int ncid, const String& name, Numeric* data);
 void nca_get_dataa_double(const int ncid, const String& name,
                           size_t start, size_t count, Numeric* data);
 
+void nca_get_slab_double(const int ncid, const String& name,
+                         const size_t* start, const size_t* count,
+                         Numeric* data);
+
 void nca_get_data_text(const int ncid, const String& name, char* data);
 
 void nca_get_data_ArrayOfIndex(const int     ncid,
@@ -69,6 +69,7 @@ void nca_write_to_file(const int ncid, const Matrix& m, const Verbosity&)
     nca_error(retval, "nc_def_dim");
   if ((retval = nc_def_var(ncid, "Matrix", NC_DOUBLE, 2, &ncdims[0], &varid)))
     nca_error(retval, "nc_def_var");
+  nca_compress_var(ncid, varid, 2, &ncdims[0]);
   if ((retval = nc_enddef(ncid))) nca_error(retval, "nc_enddef");
   if ((retval = nc_put_var_double(ncid, varid, m.get_c_array())))
     nca_error(retval, "nc_put_var");
@@ -111,6 +112,7 @@ void nca_write_to_file(const int ncid, const Tensor3& t, const Verbosity&)
     nca_error(retval, "nc_def_dim");
   if ((retval = nc_def_var(ncid, "Tensor3", NC_DOUBLE, 3, &ncdims[0], &varid)))
     nca_error(retval, "nc_def_var");
+  nca_compress_var(ncid, varid, 3, &ncdims[0]);
   if ((retval = nc_enddef(ncid))) nca_error(retval, "nc_enddef");
   if ((retval = nc_put_var_double(ncid, varid, t.get_c_array())))
     nca_error(retval, "nc_put_var");
@@ -156,6 +158,7 @@ void nca_write_to_file(const int ncid, const Tensor4& t, const Verbosity&)
     nca_error(retval, "nc_def_dim");
   if ((retval = nc_def_var(ncid, "Tensor4", NC_DOUBLE, 4, &ncdims[0], &varid)))
     nca_error(retval, "nc_def_var");
+  nca_compress_var(ncid, varid, 4, &ncdims[0]);
   if ((retval = nc_enddef(ncid))) nca_error(retval, "nc_enddef");
   if ((retval = nc_put_var_double(ncid, varid, t.get_c_array())))
     nca_error(retval, "nc_put_var");
@@ -204,6 +207,114 @@ void nca_write_to_file(const int ncid, const Tensor5& t, const Verbosity&)
     nca_error(retval, "nc_def_dim");
   if ((retval = nc_def_var(ncid, "Tensor5", NC_DOUBLE, 5, &ncdims[0], &varid)))
     nca_error(retval, "nc_def_var");
+  nca_compress_var(ncid, varid, 5, &ncdims[0]);
+  if ((retval = nc_enddef(ncid))) nca_error(retval, "nc_enddef");
+  if ((retval = nc_put_var_double(ncid, varid, t.get_c_array())))
+    nca_error(retval, "nc_put_var");
+}
+
+
+//=== Tensor6 ==========================================================
+
+//! Reads a Tensor6 from a NetCDF file
+/*!
+  \param ncf     NetCDF file descriptor
+  \param t       Tensor6
+*/
+void nca_read_from_file(const int ncid, Tensor6& t, const Verbosity&)
+{
+  Index nvitrines, nshelves, nbooks, npages, nrows, ncols;
+  nvitrines = nc_get_dim(ncid, "nvitrines");
+  nshelves  = nc_get_dim(ncid, "nshelves");
+  nbooks    = nc_get_dim(ncid, "nbooks");
+  npages    = nc_get_dim(ncid, "npages");
+  nrows     = nc_get_dim(ncid, "nrows");
+  ncols     = nc_get_dim(ncid, "ncols");
+
+  t.resize(nvitrines, nshelves, nbooks, npages, nrows, ncols);
+  nca_get_data_double(ncid, "Tensor6", t.get_c_array());
+}
+
+
+//! Writes a Tensor6 to a NetCDF file
+/*!
+  \param ncf     NetCDF file descriptor
+  \param t       Tensor6
+*/
+void nca_write_to_file(const int ncid, const Tensor6& t, const Verbosity&)
+{
+  int retval;
+  int ncdims[6], varid;
+  if ((retval = nc_def_dim(ncid, "nvitrines", t.nvitrines(), &ncdims[0])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "nshelves", t.nshelves(), &ncdims[1])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "nbooks", t.nbooks(), &ncdims[2])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "npages", t.npages(), &ncdims[3])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "nrows", t.nrows(), &ncdims[4])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "ncols", t.ncols(), &ncdims[5])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_var(ncid, "Tensor6", NC_DOUBLE, 6, &ncdims[0], &varid)))
+    nca_error(retval, "nc_def_var");
+  nca_compress_var(ncid, varid, 6, &ncdims[0]);
+  if ((retval = nc_enddef(ncid))) nca_error(retval, "nc_enddef");
+  if ((retval = nc_put_var_double(ncid, varid, t.get_c_array())))
+    nca_error(retval, "nc_put_var");
+}
+
+
+//=== Tensor7 ==========================================================
+
+//! Reads a Tensor7 from a NetCDF file
+/*!
+  \param ncf     NetCDF file descriptor
+  \param t       Tensor7
+*/
+void nca_read_from_file(const int ncid, Tensor7& t, const Verbosity&)
+{
+  Index nlibraries, nvitrines, nshelves, nbooks, npages, nrows, ncols;
+  nlibraries = nc_get_dim(ncid, "nlibraries");
+  nvitrines  = nc_get_dim(ncid, "nvitrines");
+  nshelves   = nc_get_dim(ncid, "nshelves");
+  nbooks     = nc_get_dim(ncid, "nbooks");
+  npages     = nc_get_dim(ncid, "npages");
+  nrows      = nc_get_dim(ncid, "nrows");
+  ncols      = nc_get_dim(ncid, "ncols");
+
+  t.resize(nlibraries, nvitrines, nshelves, nbooks, npages, nrows, ncols);
+  nca_get_data_double(ncid, "Tensor7", t.get_c_array());
+}
+
+
+//! Writes a Tensor7 to a NetCDF file
+/*!
+  \param ncf     NetCDF file descriptor
+  \param t       Tensor7
+*/
+void nca_write_to_file(const int ncid, const Tensor7& t, const Verbosity&)
+{
+  int retval;
+  int ncdims[7], varid;
+  if ((retval = nc_def_dim(ncid, "nlibraries", t.nlibraries(), &ncdims[0])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "nvitrines", t.nvitrines(), &ncdims[1])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "nshelves", t.nshelves(), &ncdims[2])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "nbooks", t.nbooks(), &ncdims[3])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "npages", t.npages(), &ncdims[4])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "nrows", t.nrows(), &ncdims[5])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_dim(ncid, "ncols", t.ncols(), &ncdims[6])))
+    nca_error(retval, "nc_def_dim");
+  if ((retval = nc_def_var(ncid, "Tensor7", NC_DOUBLE, 7, &ncdims[0], &varid)))
+    nca_error(retval, "nc_def_var");
+  nca_compress_var(ncid, varid, 7, &ncdims[0]);
   if ((retval = nc_enddef(ncid))) nca_error(retval, "nc_enddef");
   if ((retval = nc_put_var_double(ncid, varid, t.get_c_array())))
     nca_error(retval, "nc_put_var");
@@ -240,12 +351,107 @@ void nca_write_to_file(const int ncid, const Vector& v, const Verbosity&)
     nca_error(retval, "nc_def_dim");
   if ((retval = nc_def_var(ncid, "Vector", NC_DOUBLE, 1, &ncdim, &varid)))
     nca_error(retval, "nc_def_var");
+  nca_compress_var(ncid, varid, 1, &ncdim);
   if ((retval = nc_enddef(ncid))) nca_error(retval, "nc_enddef");
   if ((retval = nc_put_var_double(ncid, varid, v.get_c_array())))
     nca_error(retval, "nc_put_var");
 }
 
 
+//=== Hyperslab reading ====================================================
+
+//! Reads a hyperslab of a TensorN from a NetCDF file
+/*!
+  Reads the part of the variable that starts at the indices in start and
+  has the extents in count. A negative count selects everything from start
+  to the end of the dimension. Empty start and count select the whole
+  variable.
+
+  \param ncid     NetCDF file descriptor
+  \param varname  Variable name in the file
+  \param ndims    Number of dimensions of the variable
+  \param start    Start index along each dimension
+  \param count    Number of elements along each dimension
+  \param nc_start Returned start indices
+  \param nc_count Returned extents
+*/
+static void nca_get_slab_extent(const int ncid, const String& varname,
+                                const int ndims,
+                                const ArrayOfIndex& start,
+                                const ArrayOfIndex& count,
+                                size_t* nc_start, size_t* nc_count)
+{
+  int retval, varid, var_ndims;
+  int dimids[NC_MAX_VAR_DIMS];
+
+  if ((retval = nc_inq_varid(ncid, varname.c_str(), &varid)))
+    nca_error(retval, "nc_inq_varid("+varname+")");
+  if ((retval = nc_inq_varndims(ncid, varid, &var_ndims)))
+    nca_error(retval, "nc_inq_varndims("+varname+")");
+  if (var_ndims != ndims)
+    {
+      ostringstream os;
+      os << "Variable " << varname << " has " << var_ndims
+         << " dimensions, expected " << ndims << ".";
+      throw runtime_error(os.str());
+    }
+  if ((start.nelem() && start.nelem() != ndims)
+      || (count.nelem() && count.nelem() != ndims))
+    {
+      ostringstream os;
+      os << "*start* and *count* must be empty or have " << ndims
+         << " elements.";
+      throw runtime_error(os.str());
+    }
+  if ((retval = nc_inq_vardimid(ncid, varid, dimids)))
+    nca_error(retval, "nc_inq_vardimid("+varname+")");
+
+  for (int i = 0; i < ndims; i++)
+    {
+      size_t len;
+      if ((retval = nc_inq_dimlen(ncid, dimids[i], &len)))
+        nca_error(retval, "nc_inq_dimlen");
+
+      const Index s = start.nelem() ? start[i] : 0;
+      const Index c = (count.nelem() && count[i] >= 0) ? count[i]
+                                                       : (Index)len - s;
+      if (s < 0 || c < 0 || s + c > (Index)len)
+        {
+          ostringstream os;
+          os << "Hyperslab [" << s << ", " << s + c << ") is outside of "
+             << "dimension " << i << " of " << varname << " (size "
+             << len << ").";
+          throw runtime_error(os.str());
+        }
+      nc_start[i] = (size_t)s;
+      nc_count[i] = (size_t)c;
+    }
+}
+
+
+#define NCA_READ_SLAB(what, ndims, resize_args) \
+  void nca_read_slab_from_file(const int ncid, what& t, \
+                               const ArrayOfIndex& start, \
+                               const ArrayOfIndex& count, \
+                               const Verbosity&) \
+  { \
+    size_t s[ndims], c[ndims]; \
+    nca_get_slab_extent(ncid, #what, ndims, start, count, s, c); \
+    size_t n = 1; \
+    for (int i = 0; i < ndims; i++) n *= c[i]; \
+    t.resize resize_args; \
+    if (n) nca_get_slab_double(ncid, #what, s, c, t.get_c_array()); \
+  }
+
+NCA_READ_SLAB(Tensor3, 3, (c[0], c[1], c[2]))
+NCA_READ_SLAB(Tensor4, 4, (c[0], c[1], c[2], c[3]))
+NCA_READ_SLAB(Tensor5, 5, (c[0], c[1], c[2], c[3], c[4]))
+NCA_READ_SLAB(Tensor6, 6, (c[0], c[1], c[2], c[3], c[4], c[5]))
+NCA_READ_SLAB(Tensor7, 7, (c[0], c[1], c[2], c[3], c[4], c[5], c[6]))
+
+#undef NCA_READ_SLAB
+
+
 ////////////////////////////////////////////////////////////////////////////
 //   Dummy funtion for groups for which
 //   IO function have not yet been implemented
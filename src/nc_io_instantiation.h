@@ -38,7 +38,8 @@
 #include "nc_io_types.h"
 
 #define TMPL_NC_READ_WRITE_FILE(what) \
-  template void nca_write_to_file<what>(const String&, const what&, const Verbosity&); \
+  template void nca_write_to_file<what>(const String&, const what&, const bool, \
+                                        const Verbosity&); \
   template void nca_read_from_file<what>(const String&, what&, const Verbosity&);
 
 
@@ -52,8 +53,26 @@ TMPL_NC_READ_WRITE_FILE(Matrix)
 TMPL_NC_READ_WRITE_FILE(Tensor3)
 TMPL_NC_READ_WRITE_FILE(Tensor4)
 TMPL_NC_READ_WRITE_FILE(Tensor5)
+TMPL_NC_READ_WRITE_FILE(Tensor6)
+TMPL_NC_READ_WRITE_FILE(Tensor7)
 TMPL_NC_READ_WRITE_FILE(Vector)
 
+//=== Hyperslab reading ====================================================
+
+#define TMPL_NC_READ_SLAB_FILE(what) \
+  template void nca_read_slab_from_file<what>(const String&, what&, \
+                                              const ArrayOfIndex&, \
+                                              const ArrayOfIndex&, \
+                                              const Verbosity&);
+
+TMPL_NC_READ_SLAB_FILE(Tensor3)
+TMPL_NC_READ_SLAB_FILE(Tensor4)
+TMPL_NC_READ_SLAB_FILE(Tensor5)
+TMPL_NC_READ_SLAB_FILE(Tensor6)
+TMPL_NC_READ_SLAB_FILE(Tensor7)
+
+#undef TMPL_NC_READ_SLAB_FILE
+
 //=== Compound Types =======================================================
 
 TMPL_NC_READ_WRITE_FILE(Agenda)
@@ -59,8 +59,24 @@ TMPL_NC_READ_WRITE_FILE(Matrix)
 TMPL_NC_READ_WRITE_FILE(Tensor3)
 TMPL_NC_READ_WRITE_FILE(Tensor4)
 TMPL_NC_READ_WRITE_FILE(Tensor5)
+TMPL_NC_READ_WRITE_FILE(Tensor6)
+TMPL_NC_READ_WRITE_FILE(Tensor7)
 TMPL_NC_READ_WRITE_FILE(Vector)
 
+//=== Hyperslab reading ====================================================
+
+#define TMPL_NC_READ_SLAB_FILE(what) \
+  void nca_read_slab_from_file(const int, what&, const ArrayOfIndex&, \
+                               const ArrayOfIndex&, const Verbosity&);
+
+TMPL_NC_READ_SLAB_FILE(Tensor3)
+TMPL_NC_READ_SLAB_FILE(Tensor4)
+TMPL_NC_READ_SLAB_FILE(Tensor5)
+TMPL_NC_READ_SLAB_FILE(Tensor6)
+TMPL_NC_READ_SLAB_FILE(Tensor7)
+
+#undef TMPL_NC_READ_SLAB_FILE
+
 //=== Compound Types =======================================================
 
 TMPL_NC_READ_WRITE_FILE(Agenda)
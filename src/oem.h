@@ -10,6 +10,7 @@
 #ifndef oem_h
 #define oem_h
 
+#include <functional>
 #include <type_traits>
 
 #include "invlib/algebra.h"
@@ -72,6 +73,7 @@ using OEM_MFORM = invlib::MAP<
 
 using Std     = invlib::Standard;
 using CG      = invlib::ConjugateGradient<>;
+class PCG;
 template <typename TransformationMatrixType, typename SolverType>
 class NormalizingSolver;
 
@@ -92,6 +94,8 @@ using LM_S        = invlib::LevenbergMarquardt<Numeric, OEMCovarianceMatrix, Nor
 using LM_CG_S     = invlib::LevenbergMarquardt<Numeric, OEMCovarianceMatrix, Normed<CG>>;
 using LM_I        = invlib::LevenbergMarquardt<Numeric, Identity,  Normed<>>;
 using LM_CG_I     = invlib::LevenbergMarquardt<Numeric, Identity,  Normed<CG>>;
+using GN_PCG      = invlib::GaussNewton<Numeric, Normed<PCG>>;
+using LM_PCG_S    = invlib::LevenbergMarquardt<Numeric, OEMCovarianceMatrix, Normed<PCG>>;
 
 ////////////////////////////////////////////////////////////////////////////////
 //  Normalizing Solver
@@ -135,6 +139,107 @@ private:
     const TransformationMatrixType & trans;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+//  Preconditioned CG Solver
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Functor applying the inverse of a diagonal preconditioner, i.e. an element-
+ * wise scaling of the given vector.
+ */
+class JacobiPreconditioner
+{
+public:
+    JacobiPreconditioner(const Vector &d) : diag_inv(d) {}
+
+    OEMVector operator()(const OEMVector &v) const
+    {
+        OEMVector w(v);
+        for (Index i = 0; i < w.nelem(); i++) {
+            w[i] *= diag_inv[i];
+        }
+        return w;
+    }
+
+private:
+    Vector diag_inv;
+};
+
+/**
+ * Conjugate gradient solver for the standard form of the OEM, using a Jacobi
+ * preconditioner.
+ *
+ * The linear system is only accessed through matrix-vector products, so
+ * neither K^T Se^-1 K nor any other n x n matrix is formed. The diagonal of
+ * the preconditioner is approximated as
+ *
+ *   diag(K^T diag(Se^-1) K) + (1 + lambda) diag(Sa^-1),
+ *
+ * where lambda is the current Levenberg-Marquardt damping factor (zero for
+ * Gauss-Newton) and the diagonals are taken from the inverse covariance
+ * matrices. This is exact for block-diagonal Se and requires a single pass
+ * over the Jacobian per solve. The Jacobian, covariance matrices and
+ * normalisation vector are accessed through pointers, so that the latest
+ * Jacobian is used in each iteration. If the normalisation vector is non-empty,
+ * the preconditioner is scaled correspondingly, as NormalizingSolver applies
+ * this solver to the normalised system.
+ */
+class PCG
+{
+public:
+    PCG(const Matrix *K_,
+        const CovarianceMatrix *Se_,
+        const CovarianceMatrix *Sa_,
+        const Vector *x_norm_,
+        std::function<Numeric()> lambda_,
+        double tol,
+        int verbosity_)
+    : K(K_), Se(Se_), Sa(Sa_), x_norm(x_norm_), lambda(lambda_),
+      tolerance(tol), verbosity(verbosity_) {}
+
+    template <typename MatrixType, typename VectorType>
+    auto solve(const MatrixType & A, const VectorType & v)
+    -> typename VectorType::ResultType
+    {
+        const Index m = K->nrows();
+        const Index n = K->ncols();
+        const Vector se_inv_diag = Se->inverse_diagonal();
+        const Vector sa_inv_diag = Sa->inverse_diagonal();
+        const Numeric damping = 1.0 + (lambda ? lambda() : 0.0);
+
+        Vector d(n);
+        for (Index j = 0; j < n; j++) {
+            d[j] = damping * sa_inv_diag[j];
+        }
+        for (Index i = 0; i < m; i++) {
+            const Numeric w = se_inv_diag[i];
+            for (Index j = 0; j < n; j++) {
+                d[j] += w * (*K)(i, j) * (*K)(i, j);
+            }
+        }
+        const bool apply_norm = x_norm->nelem() == n;
+        for (Index j = 0; j < n; j++) {
+            if (apply_norm) {
+                d[j] *= (*x_norm)[j] * (*x_norm)[j];
+            }
+            d[j] = 1.0 / d[j];
+        }
+
+        JacobiPreconditioner f(d);
+        invlib::PreconditionedConjugateGradient<JacobiPreconditioner, true>
+            solver(f, tolerance, verbosity);
+        return solver.solve(A, v);
+    }
+
+private:
+    const Matrix           *K;
+    const CovarianceMatrix *Se, *Sa;
+    const Vector           *x_norm;
+    std::function<Numeric()> lambda;
+    double tolerance;
+    int    verbosity;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Custom Log Class
 ////////////////////////////////////////////////////////////////////////////////
@@ -216,6 +321,8 @@ typename Solver
   the optimization method is the Levenberg-Marquardt method.
   Finally, finalize is called which finalizes the iteration table
   and prints out summarizing information to the screen.
+  For a resumed inversion, the step numbers and the gamma history
+  start at the given offset, the number of iterations already done.
 */
 template
 <
@@ -226,8 +333,8 @@ class ArtsLog
 
 public:
 
-    ArtsLog(unsigned int v, Vector & g, bool l = false)
-        : verbosity(v), gamma_history(g), linear(l),
+    ArtsLog(unsigned int v, Vector & g, bool l = false, Index o = 0)
+        : verbosity(v), gamma_history(g), offset(o), linear(l),
         finalized(false) {}
 
     ~ArtsLog()
@@ -294,7 +401,7 @@ public:
             using OptimizationType =
                 typename std::decay<typename std::tuple_element<5, decltype(tuple)>::type>::type;
 
-            auto step_number = std::get<0>(tuple);
+            auto step_number = std::get<0>(tuple) + offset;
             std::cout<< std::setw(5)  << step_number;
             if (step_number == 0) {
                 start_cost = std::get<1>(tuple);
@@ -309,7 +416,7 @@ public:
             } else {
                 std::cout<< std::setw(15) << std::get<4>(tuple);
             }
-            std::cout<< OptimizerLog<OptimizationType>::log(std::get<5>(tuple), gamma_history, std::get<0>(tuple));
+            std::cout<< OptimizerLog<OptimizationType>::log(std::get<5>(tuple), gamma_history, step_number);
             std::cout << std::endl;
         }
     }
@@ -371,6 +478,7 @@ private:
 
     int      verbosity;
     Vector & gamma_history;
+    Index    offset;
     Numeric  scaling_factor, start_cost;
     bool     linear, finalized;
 
@@ -2566,6 +2566,41 @@ String PTypeToString(const PType& ptype)
 }
 
 
+//! Frequencies of SingleScatteringData needed for a frequency range.
+/*!
+ Determines the data frequencies needed for interpolating to frequencies
+ inside [fmin, fmax]. The points bracketing the range, and one further
+ point on each side (to allow polynomial interpolation up to order 3), are
+ included. Data with a single frequency are always kept completely.
+
+ \param[out] first   Index of the first needed frequency.
+ \param[out] extent  Number of needed frequencies.
+ \param[in]  f_grid  Frequency grid of the data.
+ \param[in]  fmin    Lower limit of frequency range.
+ \param[in]  fmax    Upper limit of frequency range.
+*/
+void SingleScatteringDataFrequencyRange(Index& first,
+                                        Index& extent,
+                                        ConstVectorView f_grid,
+                                        const Numeric fmin,
+                                        const Numeric fmax)
+{
+    const Index nf = f_grid.nelem();
+    first = 0;
+    extent = nf;
+    if (nf < 2) return;
+
+    // Last point <= fmin and first point >= fmax
+    Index i0 = 0;
+    while (i0 < nf-1 && f_grid[i0+1] <= fmin) i0++;
+    Index i1 = nf-1;
+    while (i1 > 0 && f_grid[i1-1] >= fmax) i1--;
+
+    first = max(Index(0), i0-1);
+    extent = min(nf-1, i1+1) - first + 1;
+}
+
+
 //! Convert azimuthally-random oriented SingleScatteringData to latest version.
 /*!
  Converts SingleScatteringData to version 3.
@@ -2721,3 +2756,205 @@ String PTypeToString(const ParticleSSDMethod& particle_ssdmethod)
     return particle_ssdmethod_string;
 }
 
+
+
+
+//! Compares two grids element by element
+/*!
+   \param a  First grid.
+   \param b  Second grid.
+
+   \return True if the grids are identical.
+*/
+bool ScatDataInterpolator::same_grid( ConstVectorView a, ConstVectorView b )
+{
+  if( a.nelem() != b.nelem() )
+    return false;
+  for( Index i=0; i<a.nelem(); i++ )
+    {
+      if( a[i] != b[i] )
+        return false;
+    }
+  return true;
+}
+
+
+
+//! Sets frequency stencil for linear interpolation
+/*!
+   The stencil is kept if grid and frequency match the last call.
+
+   \param data_f_grid  Frequency grid of the scattering element.
+   \param f            Frequency to interpolate to.
+*/
+void ScatDataInterpolator::set_f( ConstVectorView data_f_grid,
+                                  const Numeric   f )
+{
+  if( f_fixed < 0  &&  nf > 0  &&  f == f_value  &&
+      same_grid( f_cached, data_f_grid ) )
+    return;
+
+  GridPos gp;
+  gridpos( gp, data_f_grid, f );
+
+  f_cached = data_f_grid;
+  f_value  = f;
+  f_fixed  = -1;
+
+  // Points with zero weight are skipped
+  nf = 0;
+  if( gp.fd[1] != 0 )
+    { fi[nf] = gp.idx;    fw[nf] = gp.fd[1];  nf++; }
+  if( gp.fd[0] != 0 )
+    { fi[nf] = gp.idx+1;  fw[nf] = gp.fd[0];  nf++; }
+}
+
+
+
+//! Sets frequency stencil to a single frequency point
+/*!
+   \param f_index  Index of data frequency to pick.
+*/
+void ScatDataInterpolator::set_f_index( const Index f_index )
+{
+  f_fixed = f_index;
+  nf      = 1;
+  fi[0]   = f_index;
+  fw[0]   = 1;
+}
+
+
+
+//! Sets temperature stencil for linear interpolation
+/*!
+   The stencil is kept if grid and temperature match the last call. The
+   grid range check is only done when the stencil is recalculated.
+
+   \param data_T_grid  Temperature grid of the scattering element.
+   \param T            Temperature to interpolate to.
+   \param caller       Name of calling function, for error messages.
+*/
+void ScatDataInterpolator::set_T( ConstVectorView data_T_grid,
+                                  const Numeric   T,
+                                  const String&   caller )
+{
+  if( T_fixed < 0  &&  nT > 0  &&  T == T_value  &&
+      same_grid( T_cached, data_T_grid ) )
+    return;
+
+  ostringstream os;
+  os << "In " << caller << ".\n"
+     << "The temperature grid of the scattering data does not\n"
+     << "cover the atmospheric temperature at cloud location.\n"
+     << "The data should include the value T = "
+     << T << " K.";
+  chk_interpolation_grids( os.str(), data_T_grid, T );
+
+  GridPos gp;
+  gridpos( gp, data_T_grid, T );
+
+  T_cached = data_T_grid;
+  T_value  = T;
+  T_fixed  = -1;
+
+  nT = 0;
+  if( gp.fd[1] != 0 )
+    { Ti[nT] = gp.idx;    Tw[nT] = gp.fd[1];  nT++; }
+  if( gp.fd[0] != 0 )
+    { Ti[nT] = gp.idx+1;  Tw[nT] = gp.fd[0];  nT++; }
+}
+
+
+
+//! Sets temperature stencil to a single temperature point
+/*!
+   \param T_index  Index of data temperature to pick.
+*/
+void ScatDataInterpolator::set_T_index( const Index T_index )
+{
+  T_fixed = T_index;
+  nT      = 1;
+  Ti[0]   = T_index;
+  Tw[0]   = 1;
+}
+
+
+
+//! Applies the stencil to phase matrix data
+/*!
+   \param out   Interpolated data, size of pha_mat_data without the
+                frequency and temperature dimensions.
+   \param data  Phase matrix data (pha_mat_data).
+*/
+void ScatDataInterpolator::interp( Tensor5View out,
+                                   ConstTensor7View data ) const
+{
+  assert( nf > 0  &&  nT > 0 );
+  assert( out.nshelves() == data.nshelves() );
+  assert( out.nbooks()   == data.nbooks() );
+  assert( out.npages()   == data.npages() );
+  assert( out.nrows()    == data.nrows() );
+  assert( out.ncols()    == data.ncols() );
+
+  bool first = true;
+  for( Index i=0; i<nf; i++ )
+    for( Index j=0; j<nT; j++ )
+      {
+        const Numeric w = fw[i] * Tw[j];
+        ConstTensor5View d = data( fi[i], Ti[j],
+                                   joker, joker, joker, joker, joker );
+        if( first )
+          {
+            out  = d;
+            out *= w;
+            first = false;
+          }
+        else
+          {
+            for( Index s=0; s<out.nshelves(); s++ )
+              for( Index b=0; b<out.nbooks(); b++ )
+                for( Index p=0; p<out.npages(); p++ )
+                  for( Index r=0; r<out.nrows(); r++ )
+                    for( Index c=0; c<out.ncols(); c++ )
+                      out(s,b,p,r,c) += w * d(s,b,p,r,c);
+          }
+      }
+}
+
+
+
+//! Applies the stencil to extinction matrix or absorption vector data
+/*!
+   \param out   Interpolated data, size of ext_mat_data (abs_vec_data)
+                without the frequency and temperature dimensions.
+   \param data  Extinction matrix (absorption vector) data.
+*/
+void ScatDataInterpolator::interp( Tensor3View out,
+                                   ConstTensor5View data ) const
+{
+  assert( nf > 0  &&  nT > 0 );
+  assert( out.npages() == data.npages() );
+  assert( out.nrows()  == data.nrows() );
+  assert( out.ncols()  == data.ncols() );
+
+  bool first = true;
+  for( Index i=0; i<nf; i++ )
+    for( Index j=0; j<nT; j++ )
+      {
+        const Numeric w = fw[i] * Tw[j];
+        ConstTensor3View d = data( fi[i], Ti[j], joker, joker, joker );
+        if( first )
+          {
+            out  = d;
+            out *= w;
+            first = false;
+          }
+        else
+          {
+            for( Index p=0; p<out.npages(); p++ )
+              for( Index r=0; r<out.nrows(); r++ )
+                for( Index c=0; c<out.ncols(); c++ )
+                  out(p,r,c) += w * d(p,r,c);
+          }
+      }
+}
@@ -132,6 +132,62 @@ ostream& operator<< (ostream& os, const ArrayOfScatteringMetaData& assd);
 
 
 
+/*===========================================================================
+  === The ScatDataInterpolator class
+  ===========================================================================*/
+/*!
+   Frequency and temperature interpolation stencil for scattering data.
+
+   The data fields of SingleScatteringData have frequency and temperature
+   as their two leading dimensions. The class holds the (at most four)
+   data points and weights needed to obtain the data for one frequency and
+   one temperature. The stencil is only recalculated when the grids or
+   the requested frequency/temperature differ from the ones of the last
+   call, so when looping over the scattering elements of a species
+   (normally sharing f_grid and T_grid) the grid positions and the grid
+   range checks are done only once.
+
+   Usage: Call set_f or set_f_index, then set_T or set_T_index, for each
+   scattering element, and then interp for each data field.
+*/
+class ScatDataInterpolator {
+public:
+  ScatDataInterpolator() : f_value(-1), f_fixed(-1), T_value(-1),
+                           T_fixed(-1), nf(0), nT(0) {}
+
+  void set_f( ConstVectorView data_f_grid,
+              const Numeric   f );
+
+  void set_f_index( const Index f_index );
+
+  void set_T( ConstVectorView data_T_grid,
+              const Numeric   T,
+              const String&   caller );
+
+  void set_T_index( const Index T_index );
+
+  void interp( Tensor5View out, ConstTensor7View data ) const;
+
+  void interp( Tensor3View out, ConstTensor5View data ) const;
+
+private:
+  static bool same_grid( ConstVectorView a, ConstVectorView b );
+
+  // Cached grids and values the stencils refer to
+  Vector  f_cached, T_cached;
+  Numeric f_value;
+  Index   f_fixed;
+  Numeric T_value;
+  Index   T_fixed;
+
+  // Stencils, with number of active points
+  Index   nf, nT;
+  Index   fi[2], Ti[2];
+  Numeric fw[2], Tw[2];
+};
+
+
+
 // General functions:
 // =============================================================
 
@@ -346,6 +402,12 @@ String PTypeToString(const PType& ptype);
 
 void ConvertAzimuthallyRandomSingleScatteringData(SingleScatteringData& ssd);
 
+void SingleScatteringDataFrequencyRange(Index& first,
+                                        Index& extent,
+                                        ConstVectorView f_grid,
+                                        const Numeric fmin,
+                                        const Numeric fmax);
+
 ParticleSSDMethod ParticleSSDMethodFromString(const String& particle_ssdmethod_string);
 
 String ParticleSSDMethodToString(const ParticleSSDMethod& particle_ssdmethod_type);
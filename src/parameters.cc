@@ -133,7 +133,9 @@ bool get_parameters(int argc, char **argv)
     { "numthreads",         required_argument, NULL, 'n' },
     { "outdir",             required_argument, NULL, 'o' },
     { "plain",              no_argument,       NULL, 'p' },
+    { "profile",            required_argument, NULL, 'P' },
     { "reporting",          required_argument, NULL, 'r' },
+    { "snapshot",           required_argument, NULL, 'L' },
 #ifdef ENABLE_DOCSERVER
     { "docserver",          optional_argument, NULL, 's' },
     { "docdaemon",          optional_argument, NULL, 'S' },
@@ -145,7 +147,7 @@ bool get_parameters(int argc, char **argv)
   };
 
   parameters.usage =
-    "Usage: arts [-bBdghimnrsSvw]\n"
+    "Usage: arts [-bBdghiLmnPrsSvw]\n"
     "       [--basename <name>]\n"
     "       [--describe <method or variable>]\n"
     "       [--groups]\n"
@@ -157,7 +159,9 @@ bool get_parameters(int argc, char **argv)
     "       [--numthreads <#>\n"
     "       [--outdir <name>]\n"
     "       [--plain]\n"
+    "       [--profile <file>]\n"
     "       [--reporting <xyz>]\n"
+    "       [--snapshot <file>]\n"
 #ifdef ENABLE_DOCSERVER
     "       [--docserver[=<port>] --baseurl=BASEURL]\n"
     "       [--docdaemon[=<port>] --baseurl=BASEURL]\n"
@@ -203,6 +207,12 @@ bool get_parameters(int argc, char **argv)
     "                    Default is the current directory.\n"
     "-p  --plain         Generate plain help output suitable for\n"
     "                    script processing.\n"
+    "-P, --profile       Record the time spent in each agenda and workspace\n"
+    "                    method and write it to the given file at exit.\n"
+    "                    The file is in Chrome trace format and can be\n"
+    "                    viewed as flame graph in chrome://tracing.\n"
+    "                    Calls made by parallel threads are listed per\n"
+    "                    thread below the method that started them.\n"
     "-r, --reporting     Three digit integer. Sets the reporting\n"
     "                    level for agenda calls (first digit),\n"
     "                    screen (second digit) and file (third \n"
@@ -211,6 +221,10 @@ bool get_parameters(int argc, char **argv)
     "                    The agenda setting applies in addition to both\n"
     "                    screen and file output.\n"
     "                    Default is 010.\n"
+    "-L, --snapshot      Restore the workspace from a snapshot written by\n"
+    "                    WriteWorkspaceSnapshot before the controlfiles\n"
+    "                    are parsed. Variables and agendas from the\n"
+    "                    snapshot can be used directly in the controlfiles.\n"
 #ifdef ENABLE_DOCSERVER
     "-s, --docserver     Start documentation server. Optionally, specify\n"
     "                    the port number the server should listen on,\n"
@@ -291,6 +305,12 @@ bool get_parameters(int argc, char **argv)
         case 'I':
           parameters.includepath.push_back (optarg);
           break;
+        case 'L':
+          parameters.snapshot = optarg;
+          break;
+        case 'P':
+          parameters.profile = optarg;
+          break;
         case 'D':
           parameters.datapath.push_back (optarg);
           break;
@@ -64,7 +64,9 @@ public:
     docserver(0),
     baseurl(""),
     daemon(false),
-    gui(false)
+    gui(false),
+    snapshot(""),
+    profile("")
   { /* Nothing to be done here */ }
   
   /** Short message how to call the program. */
@@ -128,6 +130,11 @@ public:
   bool daemon;
   /** Flag to run with graphical user interface. */
   bool gui;
+  /** Workspace snapshot to restore before the controlfiles are
+      parsed (written by WriteWorkspaceSnapshot). */
+  String snapshot;
+  /** File to write the agenda and method profile to. */
+  String profile;
 };
 
 
@@ -0,0 +1,439 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   profiler.cc
+
+  \brief  Hierarchical profiling of agendas and workspace methods.
+*/
+
+#include "profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "arts_omp.h"
+#include "file.h"
+
+
+bool profiler_is_enabled = false;
+
+//! Bytes allocated with operator new by this thread while profiling.
+static thread_local unsigned long long thread_allocated = 0;
+
+//! Bytes allocated by the threads of parallel regions, except their masters.
+static std::atomic<unsigned long long> worker_allocated(0);
+
+
+//! One node of the call tree, identified by its nesting path.
+struct ProfilerNode
+{
+  String name;
+  bool is_agenda;
+  Index parent;
+  std::map<String, Index> children;
+  Index calls;
+  double inclusive;
+  double exclusive;
+  unsigned long long bytes;
+};
+
+//! A single call, written to the trace file.
+struct ProfilerEvent
+{
+  Index node;
+  double start;
+  double duration;
+  unsigned long long bytes;
+};
+
+//! A call that has not returned yet.
+struct ProfilerFrame
+{
+  Index node;
+  double start;
+  double children;
+  unsigned long long allocated;
+  bool inherited;
+};
+
+//! All data recorded by one thread.
+struct ThreadProfile
+{
+  Index tid;
+  std::vector<ProfilerNode> nodes;
+  std::vector<ProfilerEvent> events;
+  std::vector<ProfilerFrame> stack;
+  Index dropped_events;
+};
+
+//! Single calls are not stored in the trace beyond this number per thread.
+static const size_t max_events_per_thread = 1000000;
+
+static std::mutex profiler_mutex;
+static std::vector<std::unique_ptr<ThreadProfile> > thread_profiles;
+static thread_local ThreadProfile* thread_profile = NULL;
+static std::chrono::steady_clock::time_point profiler_start;
+
+
+//! Seconds since the profiler was enabled.
+static double profiler_time()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                       - profiler_start).count();
+}
+
+
+//! Return true if this thread is a worker of an OpenMP parallel region.
+static bool is_worker_thread()
+{
+  return arts_omp_in_parallel() && arts_omp_get_thread_num() != 0;
+}
+
+
+//! Bytes attributed to the calls of this thread so far.
+/*!
+  Threads that are not workers of a parallel region also include the
+  allocations of all workers, as these run on behalf of their open calls.
+*/
+static unsigned long long allocated_bytes()
+{
+  if (is_worker_thread()) return thread_allocated;
+  return thread_allocated + worker_allocated.load(std::memory_order_relaxed);
+}
+
+
+//! Return the profile of the calling thread, create it if necessary.
+static ThreadProfile& get_thread_profile()
+{
+  if (!thread_profile)
+    {
+      std::unique_ptr<ThreadProfile> tp(new ThreadProfile);
+      tp->dropped_events = 0;
+
+      ProfilerNode root;
+      root.is_agenda = true;
+      root.parent = -1;
+      root.calls = 0;
+      root.inclusive = 0;
+      root.exclusive = 0;
+      root.bytes = 0;
+      tp->nodes.push_back(root);
+
+      std::lock_guard<std::mutex> lock(profiler_mutex);
+      tp->tid = (Index)thread_profiles.size();
+      thread_profile = tp.get();
+      thread_profiles.push_back(std::move(tp));
+    }
+  return *thread_profile;
+}
+
+
+//! Enable recording of agenda and method calls.
+/*!
+  Should be called once before the first agenda is executed.
+*/
+void profiler_enable()
+{
+  profiler_start = std::chrono::steady_clock::now();
+  profiler_is_enabled = true;
+}
+
+
+//! Return the child node with the given name, create it if necessary.
+static Index child_node(ThreadProfile& tp,
+                        Index parent,
+                        const String& name,
+                        bool is_agenda)
+{
+  std::map<String, Index>::const_iterator it =
+    tp.nodes[parent].children.find(name);
+  if (it != tp.nodes[parent].children.end())
+    return it->second;
+  else
+    {
+      ProfilerNode n;
+      n.name = name;
+      n.is_agenda = is_agenda;
+      n.parent = parent;
+      n.calls = 0;
+      n.inclusive = 0;
+      n.exclusive = 0;
+      n.bytes = 0;
+      const Index node = (Index)tp.nodes.size();
+      tp.nodes.push_back(n);
+      tp.nodes[parent].children[name] = node;
+      return node;
+    }
+}
+
+
+//! Open a call on the stack of this thread.
+static void push_frame(ThreadProfile& tp,
+                       const String& name,
+                       bool is_agenda,
+                       bool inherited)
+{
+  const Index parent = tp.stack.empty() ? 0 : tp.stack.back().node;
+
+  ProfilerFrame frame;
+  frame.node = child_node(tp, parent, name, is_agenda);
+  frame.children = 0;
+  frame.allocated = allocated_bytes();
+  frame.inherited = inherited;
+  frame.start = profiler_time();
+  tp.stack.push_back(frame);
+}
+
+
+//! Start recording a call.
+/*!
+  Use ProfilerScope instead of calling this directly.
+
+  \param name       Name of the agenda or method
+  \param is_agenda  True for agendas, false for methods
+*/
+void profiler_begin(const String& name, bool is_agenda)
+{
+  push_frame(get_thread_profile(), name, is_agenda, false);
+}
+
+
+//! Stop recording the innermost call of this thread.
+void profiler_end()
+{
+  const double end = profiler_time();
+  ThreadProfile& tp = get_thread_profile();
+  if (tp.stack.empty() || tp.stack.back().inherited) return;
+
+  const ProfilerFrame frame = tp.stack.back();
+  tp.stack.pop_back();
+
+  const double duration = end - frame.start;
+  const unsigned long long bytes = allocated_bytes() - frame.allocated;
+
+  ProfilerNode& n = tp.nodes[frame.node];
+  n.calls++;
+  n.inclusive += duration;
+  n.exclusive += duration - frame.children;
+  n.bytes += bytes;
+
+  if (!tp.stack.empty())
+    tp.stack.back().children += duration;
+
+  if (tp.events.size() < max_events_per_thread)
+    {
+      ProfilerEvent event;
+      event.node = frame.node;
+      event.start = frame.start;
+      event.duration = duration;
+      event.bytes = bytes;
+      tp.events.push_back(event);
+    }
+  else
+    tp.dropped_events++;
+}
+
+
+ProfilerParallel::ProfilerParallel() : owner(NULL)
+{
+  if (!profiler_enabled()) return;
+
+  const ThreadProfile& tp = get_thread_profile();
+  owner = &tp;
+  for (size_t i = 0; i < tp.stack.size(); i++)
+    {
+      const ProfilerNode& n = tp.nodes[tp.stack[i].node];
+      path.push_back(std::make_pair(n.name, n.is_agenda));
+    }
+}
+
+
+ProfilerWorker::ProfilerWorker(const ProfilerParallel& parallel)
+  : inherited(0)
+{
+  if (!profiler_enabled() || !parallel.owner) return;
+
+  ThreadProfile& tp = get_thread_profile();
+  if (&tp == parallel.owner || !tp.stack.empty()) return;
+
+  for (size_t i = 0; i < parallel.path.size(); i++)
+    push_frame(tp, parallel.path[i].first, parallel.path[i].second, true);
+  inherited = parallel.path.size();
+}
+
+
+ProfilerWorker::~ProfilerWorker()
+{
+  if (!inherited) return;
+
+  ThreadProfile& tp = *thread_profile;
+  tp.stack.resize(tp.stack.size() - inherited);
+}
+
+
+//! Write string as JSON string literal.
+static void write_json_string(ostream& os, const String& s)
+{
+  os << '"';
+  for (size_t i = 0; i < s.size(); i++)
+    {
+      const char c = s[i];
+      if (c == '"' || c == '\\')
+        os << '\\' << c;
+      else if ((unsigned char)c < 0x20)
+        os << ' ';
+      else
+        os << c;
+    }
+  os << '"';
+}
+
+
+//! Return the nesting path of a node, e.g. Arts/yCalc.
+static String node_path(const ThreadProfile& tp, Index node)
+{
+  String path = tp.nodes[node].name;
+  for (Index i = tp.nodes[node].parent; i > 0; i = tp.nodes[i].parent)
+    path = tp.nodes[i].name + "/" + path;
+  return path;
+}
+
+
+//! Write the recorded profile as Chrome trace file.
+/*!
+  Times in the trace events are given in microseconds, the aggregated
+  times under "artsProfile" in seconds.
+
+  \param filename   Name of the output file
+  \param verbosity  Verbosity
+*/
+void profiler_write_chrome_trace(const String& filename,
+                                 const Verbosity& verbosity)
+{
+  CREATE_OUT1;
+  CREATE_OUT2;
+
+  std::lock_guard<std::mutex> lock(profiler_mutex);
+
+  const String efilename = add_basedir(filename);
+  ofstream ofs;
+  open_output_file(ofs, efilename);
+  ofs.precision(12);
+
+  ofs << "{\"traceEvents\":[\n";
+  bool first = true;
+  Index dropped_events = 0;
+  for (size_t t = 0; t < thread_profiles.size(); t++)
+    {
+      const ThreadProfile& tp = *thread_profiles[t];
+      dropped_events += tp.dropped_events;
+
+      if (!first) ofs << ",\n";
+      first = false;
+      ofs << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+          << tp.tid << ",\"args\":{\"name\":\"Thread " << tp.tid << "\"}}";
+
+      for (size_t i = 0; i < tp.events.size(); i++)
+        {
+          const ProfilerEvent& e = tp.events[i];
+          const ProfilerNode& n = tp.nodes[e.node];
+          ofs << ",\n{\"name\":";
+          write_json_string(ofs, n.name);
+          ofs << ",\"cat\":\"" << (n.is_agenda ? "agenda" : "method")
+              << "\",\"ph\":\"X\",\"ts\":" << e.start * 1e6
+              << ",\"dur\":" << e.duration * 1e6
+              << ",\"pid\":1,\"tid\":" << tp.tid
+              << ",\"args\":{\"bytes\":" << e.bytes << "}}";
+        }
+    }
+  ofs << "\n],\n\"displayTimeUnit\":\"ms\",\n\"artsProfile\":[\n";
+
+  first = true;
+  for (size_t t = 0; t < thread_profiles.size(); t++)
+    {
+      const ThreadProfile& tp = *thread_profiles[t];
+      for (size_t i = 1; i < tp.nodes.size(); i++)
+        {
+          const ProfilerNode& n = tp.nodes[i];
+          // Calls inherited from the thread opening a parallel region.
+          if (!n.calls) continue;
+
+          if (!first) ofs << ",\n";
+          first = false;
+          ofs << "{\"thread\":" << tp.tid << ",\"path\":";
+          write_json_string(ofs, node_path(tp, (Index)i));
+          ofs << ",\"type\":\"" << (n.is_agenda ? "agenda" : "method")
+              << "\",\"calls\":" << n.calls
+              << ",\"inclusive\":" << n.inclusive
+              << ",\"exclusive\":" << n.exclusive
+              << ",\"bytes\":" << n.bytes << "}";
+        }
+    }
+  ofs << "\n]}\n";
+
+  if (dropped_events)
+    out1 << "  Warning: Trace is incomplete, " << dropped_events
+         << " calls were only included in the aggregated profile.\n";
+  out2 << "  Profile written to " << efilename << "\n";
+}
+
+
+////////////////////////////////////////////////////////////////////////////
+// Global allocation functions that count the allocated bytes per thread.
+////////////////////////////////////////////////////////////////////////////
+
+void* operator new(std::size_t size)
+{
+  if (profiler_is_enabled)
+    {
+      thread_allocated += size;
+      if (is_worker_thread())
+        worker_allocated.fetch_add(size, std::memory_order_relaxed);
+    }
+  if (size == 0) size = 1;
+
+  void* p;
+  while ((p = std::malloc(size)) == NULL)
+    {
+      std::new_handler handler = std::get_new_handler();
+      if (!handler) throw std::bad_alloc();
+      handler();
+    }
+  return p;
+}
+
+void* operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
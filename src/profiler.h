@@ -0,0 +1,147 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   profiler.h
+
+  \brief  Hierarchical profiling of agendas and workspace methods.
+
+  When enabled, every agenda execution and every workspace method call is
+  recorded with its wall time and the number of bytes allocated with
+  operator new while it runs. Calls are aggregated per thread along their
+  nesting path, e.g. Arts/ybatchCalc/ybatch_calc_agenda/yCalc, giving
+  call counts and inclusive and exclusive times.
+
+  Calls made by the threads of an OpenMP parallel region are nested below
+  the call that opened the region if the region is marked with
+  ProfilerParallel and ProfilerWorker. Calls in unmarked regions start at
+  the root of their thread's call tree. Bytes allocated by the threads of
+  any parallel region are added to the calls of the thread that opened it.
+
+  The profile is written as a Chrome trace file in JSON format, which can
+  be viewed as a flame graph in chrome://tracing, Perfetto or speedscope.
+  The aggregated statistics are stored in the same file under the key
+  "artsProfile".
+
+  Profiling is disabled by default and costs a single test of a global
+  flag per agenda and method call.
+*/
+
+#ifndef profiler_h
+#define profiler_h
+
+#include <vector>
+#include "arts.h"
+#include "messages.h"
+#include "mystring.h"
+
+
+//! Enable recording of agenda and method calls.
+void profiler_enable();
+
+//! Return true if the profiler records calls.
+inline bool profiler_enabled()
+{
+  extern bool profiler_is_enabled;
+  return profiler_is_enabled;
+}
+
+void profiler_begin(const String& name, bool is_agenda);
+
+void profiler_end();
+
+void profiler_write_chrome_trace(const String& filename,
+                                 const Verbosity& verbosity);
+
+
+//! Records one agenda or method call for the lifetime of the object.
+/*!
+  The call is also closed correctly if an exception is thrown.
+*/
+class ProfilerScope
+{
+public:
+  ProfilerScope(const String& name, bool is_agenda)
+    : active(profiler_enabled())
+  {
+    if (active) profiler_begin(name, is_agenda);
+  }
+
+  ~ProfilerScope()
+  {
+    if (active) profiler_end();
+  }
+
+private:
+  ProfilerScope(const ProfilerScope&);
+  ProfilerScope& operator=(const ProfilerScope&);
+
+  bool active;
+};
+
+
+//! Captures the current call of a thread that opens a parallel region.
+/*!
+  Create before the parallel region and add a ProfilerWorker to the body
+  of the region, e.g.
+
+    ProfilerParallel profiler_parallel;
+    #pragma omp parallel for
+    for (Index i = 0; i < n; i++)
+      {
+        ProfilerWorker profiler_worker(profiler_parallel);
+        ...
+      }
+*/
+class ProfilerParallel
+{
+public:
+  ProfilerParallel();
+
+private:
+  ProfilerParallel(const ProfilerParallel&);
+  ProfilerParallel& operator=(const ProfilerParallel&);
+
+  friend class ProfilerWorker;
+
+  //! Profile of the thread that opened the region.
+  const void* owner;
+  //! Names and types of the open calls of that thread.
+  std::vector<std::pair<String, bool> > path;
+};
+
+
+//! Nests the calls of a worker thread below the call opening the region.
+/*!
+  Has no effect on the thread that opened the region and on threads that
+  have open calls of their own.
+*/
+class ProfilerWorker
+{
+public:
+  explicit ProfilerWorker(const ProfilerParallel& parallel);
+
+  ~ProfilerWorker();
+
+private:
+  ProfilerWorker(const ProfilerWorker&);
+  ProfilerWorker& operator=(const ProfilerWorker&);
+
+  size_t inherited;
+};
+
+#endif /* profiler_h */
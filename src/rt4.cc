@@ -35,8 +35,10 @@
 #ifdef ENABLE_RT4
 
 #include <cfloat>
+#include <chrono>
 #include <complex.h>
 #include <stdexcept>
+#include "arts_omp.h"
 #include "interpolation.h"
 #include "m_xml.h"
 #include "physics_funcs.h"
@@ -631,9 +633,38 @@ void run_rt4( Workspace& ws,
     scat_za_grid_orig = scat_za_grid;
 
 
+  // With a fixed number of streams, the quadrature and all angle-dependent
+  // setup is the same for all frequencies. The layer optical properties are
+  // then derived in parallel for blocks of frequencies (one per thread), into
+  // work buffers allocated once here. RT4 itself (Fortran, SAVE variables) is
+  // called serially. With auto_inc_nstreams the stream number can change from
+  // frequency to frequency, and the preparation stays inside the loop.
+  const Index nf = f_grid.nelem();
+  const Index nfblock = auto_inc_nstreams ? 0 :
+    max( Index(1), min( nf, Index(arts_omp_get_max_threads()) ) );
+  Matrix gas_extinct_blk;
+  Tensor7 scatter_matrix_blk;
+  Tensor6 extinct_matrix_blk;
+  Tensor5 emis_vector_blk;
+  if( nfblock )
+  {
+    gas_extinct_blk.resize(nfblock, num_layers);
+    gas_extinct_blk = 0.;
+    if( pndtot )
+    {
+      scatter_matrix_blk.resize(nfblock, num_scatlayers, 4, nummu, stokes_dim,
+                                nummu, stokes_dim);
+      extinct_matrix_blk.resize(nfblock, num_scatlayers, 2, nummu, stokes_dim,
+                                stokes_dim);
+      emis_vector_blk.resize(nfblock, num_scatlayers, 2, nummu, stokes_dim);
+    }
+  }
+
+  std::chrono::steady_clock::duration t_optprop(0), t_rt4(0);
+
   Index nummu_new = 0;
   // Loop over frequencies
-  for (Index f_index = 0; f_index < f_grid.nelem(); f_index ++) 
+  for (Index f_index = 0; f_index < nf; f_index ++) 
     {
       // Wavelength [um]
       Numeric wavelength;
@@ -644,73 +675,175 @@ void run_rt4( Workspace& ws,
       Matrix surfemisvec=surf_emis_vec(f_index,joker,joker);
       //Vector muvalues=mu_values;
 
-      // only update gas_extinct if there is any gas absorption at all (since
-      // vmr_field is not freq-dependent, gas_extinct will remain as above
-      // initialized (with 0) for all freqs, ie we can rely on that it wasn't
-      // changed.
-      if( vmr_field.nbooks()>0 )
+      auto t_start = std::chrono::steady_clock::now();
+
+      Index pfct_failed = 0;
+      if( nfblock )
+      {
+        // Fixed streams: prepare the next block of frequencies in parallel,
+        // then just pick up the buffered properties of this frequency.
+        const Index ib = f_index % nfblock;
+        if( ib==0 )
         {
-          gas_optpropCalc( ws, gas_extinct,
-                           propmat_clearsky_agenda,
-                           t_field(Range(0,num_layers+1),joker,joker),
-                           vmr_field(joker,Range(0,num_layers+1),joker,joker),
-                           p_grid[Range(0,num_layers+1)],
-                           f_grid[Range(f_index,1)]);
+          const Index nb = min( nfblock, nf-f_index );
+
+          // We have to make a local copy of the Workspace and the agendas
+          // because only non-reference types can be declared firstprivate in
+          // OpenMP
+          Workspace l_ws (ws);
+          Agenda l_propmat_clearsky_agenda (propmat_clearsky_agenda);
+
+          String fail_msg;
+          bool failed = false;
+
+#pragma omp parallel for                                    \
+if(!arts_omp_in_parallel() && nb>1)                       \
+firstprivate(l_ws, l_propmat_clearsky_agenda)
+          for (Index jb = 0; jb < nb; jb++)
+            {
+              if (failed)
+                continue;
+
+              const Index jf = f_index+jb;
+              try {
+                if( vmr_field.nbooks()>0 )
+                  gas_optpropCalc( l_ws, gas_extinct_blk(jb,joker),
+                                   l_propmat_clearsky_agenda,
+                                   t_field(Range(0,num_layers+1),joker,joker),
+                                   vmr_field(joker,Range(0,num_layers+1),
+                                             joker,joker),
+                                   p_grid[Range(0,num_layers+1)],
+                                   f_grid[Range(jf,1)]);
+
+                if( pndtot )
+                {
+                  Tensor4View emis_jb =
+                    emis_vector_blk(jb,joker,joker,joker,joker);
+                  Tensor5View ext_jb =
+                    extinct_matrix_blk(jb,joker,joker,joker,joker,joker);
+                  if( new_optprop )
+                  {
+                    const Index jf_ssd =
+                      emis_vector_allf.nshelves()==1 ? 0 : jf;
+                    emis_jb = emis_vector_allf(jf_ssd,joker,joker,joker,joker);
+                    ext_jb = extinct_matrix_allf(jf_ssd,
+                                                 joker,joker,joker,joker,joker);
+                  }
+                  else
+                  {
+                    par_optpropCalc( emis_jb, ext_jb,
+                                     scat_data, scat_za_grid, jf,
+                                     pnd_field,
+                                     t_field(Range(0,num_layers+1),joker,joker),
+                                     cloudbox_limits, stokes_dim, nummu,
+                                     verbosity );
+                  }
+                  Index pfct_failed_jb = 0;
+                  sca_optpropCalc( scatter_matrix_blk(jb,joker,joker,joker,
+                                                      joker,joker,joker),
+                                   pfct_failed_jb,
+                                   emis_jb, ext_jb,
+                                   jf, scat_data, pnd_field, stokes_dim,
+                                   scat_za_grid, quad_weights,
+                                   pfct_method, pfct_aa_grid_size,
+                                   pfct_threshold, 0,
+                                   verbosity );
+                }
+              } catch (const std::runtime_error &e) {
+                ostringstream os;
+                os << "Error for f_index = " << jf
+                   << " (" << f_grid[jf] << " Hz)" << endl
+                   << e.what();
+#pragma omp critical (run_rt4_fail)
+                { failed = true; fail_msg = os.str(); }
+              }
+            }
+
+          if (failed)
+            throw runtime_error(fail_msg);
         }
 
-      Index pfct_failed = 0;
-      if( pndtot )
+        gas_extinct = gas_extinct_blk(ib,joker);
+        if( pndtot )
+        {
+          scatter_matrix = scatter_matrix_blk(ib,joker,joker,joker,
+                                              joker,joker,joker);
+          extinct_matrix = extinct_matrix_blk(Range(ib,1),
+                                              joker,joker,joker,joker,joker);
+          emis_vector = emis_vector_blk(Range(ib,1),joker,joker,joker,joker);
+        }
+      }
+      else
       {
-        if( nummu_new<nummu )
+        // only update gas_extinct if there is any gas absorption at all (since
+        // vmr_field is not freq-dependent, gas_extinct will remain as above
+        // initialized (with 0) for all freqs, ie we can rely on that it wasn't
+        // changed.
+        if( vmr_field.nbooks()>0 )
+          {
+            gas_optpropCalc( ws, gas_extinct,
+                             propmat_clearsky_agenda,
+                             t_field(Range(0,num_layers+1),joker,joker),
+                             vmr_field(joker,Range(0,num_layers+1),joker,joker),
+                             p_grid[Range(0,num_layers+1)],
+                             f_grid[Range(f_index,1)]);
+          }
+
+        if( pndtot )
         {
-          if( new_optprop )
+          if( nummu_new<nummu )
           {
-            if( !auto_inc_nstreams ) // all freq calculated before. just copy
-                                     // here. but only if needed.
+            if( new_optprop )
             {
-              if( emis_vector_allf.nshelves()!=1 )
+              if( !auto_inc_nstreams ) // all freq calculated before. just copy
+                                       // here. but only if needed.
+              {
+                if( emis_vector_allf.nshelves()!=1 )
+                {
+                  emis_vector = emis_vector_allf(Range(f_index,1),
+                                                 joker,joker,joker,joker);
+                  extinct_matrix = extinct_matrix_allf(Range(f_index,1),
+                                                       joker,joker,joker,joker,joker);
+                }
+              }
+              else
               {
-                emis_vector = emis_vector_allf(Range(f_index,1),
-                                               joker,joker,joker,joker);
-                extinct_matrix = extinct_matrix_allf(Range(f_index,1),
-                                                     joker,joker,joker,joker,joker);
+                par_optpropCalc2( emis_vector, extinct_matrix,
+                                 //scatlayers,
+                                 scat_data, scat_za_grid, f_index,
+                                 pnd_field,
+                                 t_field(Range(0,num_layers+1),joker,joker),
+                                 cloudbox_limits, stokes_dim );
               }
             }
             else
             {
-              par_optpropCalc2( emis_vector, extinct_matrix,
-                               //scatlayers,
-                               scat_data, scat_za_grid, f_index,
-                               pnd_field,
-                               t_field(Range(0,num_layers+1),joker,joker),
-                               cloudbox_limits, stokes_dim );
+                par_optpropCalc( emis_vector(0,joker,joker,joker,joker),
+                                 extinct_matrix(0,joker,joker,joker,joker,joker),
+                                 //scatlayers,
+                                 scat_data, scat_za_grid, f_index,
+                                 pnd_field,
+                                 t_field(Range(0,num_layers+1),joker,joker),
+                                 cloudbox_limits, stokes_dim, nummu,
+                                 verbosity );
             }
+            sca_optpropCalc( scatter_matrix, pfct_failed,
+                             emis_vector(0,joker,joker,joker,joker),
+                             extinct_matrix(0,joker,joker,joker,joker,joker),
+                             f_index, scat_data, pnd_field, stokes_dim,
+                             scat_za_grid, quad_weights,
+                             pfct_method, pfct_aa_grid_size, pfct_threshold,
+                             auto_inc_nstreams,
+                             verbosity );
           }
           else
           {
-              par_optpropCalc( emis_vector(0,joker,joker,joker,joker),
-                               extinct_matrix(0,joker,joker,joker,joker,joker),
-                               //scatlayers,
-                               scat_data, scat_za_grid, f_index,
-                               pnd_field,
-                               t_field(Range(0,num_layers+1),joker,joker),
-                               cloudbox_limits, stokes_dim, nummu,
-                               verbosity );
+            pfct_failed = 1;
           }
-          sca_optpropCalc( scatter_matrix, pfct_failed,
-                           emis_vector(0,joker,joker,joker,joker),
-                           extinct_matrix(0,joker,joker,joker,joker,joker),
-                           f_index, scat_data, pnd_field, stokes_dim,
-                           scat_za_grid, quad_weights,
-                           pfct_method, pfct_aa_grid_size, pfct_threshold,
-                           auto_inc_nstreams,
-                           verbosity );
-        }
-        else
-        {
-          pfct_failed = 1;
         }
       }
+      t_optprop += std::chrono::steady_clock::now() - t_start;
+      t_start = std::chrono::steady_clock::now();
 
       if (!pfct_failed)
       {
@@ -947,6 +1080,7 @@ void run_rt4( Workspace& ws,
         // reconstruct scat_za_grid
         scat_za_grid = scat_za_grid_orig;
       }
+      t_rt4 += std::chrono::steady_clock::now() - t_start;
 
 
       // RT4 rad output is in wavelength units, nominally in W/(m2 sr um), where
@@ -983,6 +1117,17 @@ void run_rt4( Workspace& ws,
                   down_rad(num_layers-k,j,ist)*rad_l2f;
               }
     }
+
+  CREATE_OUT2;
+  out2 << "  RT4 timing for " << nf << " frequencies:\n"
+       << "    optical properties ("
+       << (nfblock ? nfblock : 1) << " frequencies in parallel): "
+       << std::chrono::duration<Numeric>( t_optprop ).count() << " s\n"
+       << "    RT4 (serial";
+  if( auto_inc_nstreams )
+    out2 << ", incl. stream increases";
+  out2 << "): "
+       << std::chrono::duration<Numeric>( t_rt4 ).count() << " s\n";
 }
 
 //! run_rt4_new
@@ -49,6 +49,7 @@
 #include "montecarlo.h"
 #include "physics_funcs.h"
 #include "ppath.h"
+#include "profiler.h"
 #include "refraction.h"
 #include "rte.h"
 #include "special_interp.h"
@@ -1742,11 +1743,14 @@ void iyb_calc(
       << nf << " frequencies)\n";
 
       // Start of actual calculations
+      ProfilerParallel profiler_parallel;
 #pragma omp parallel for                   \
 if (!arts_omp_in_parallel()) \
 firstprivate(l_ws, l_iy_main_agenda, l_geo_pos_agenda)
       for( Index ilos=0; ilos<nlos; ilos++ )
         {
+          ProfilerWorker profiler_worker(profiler_parallel);
+
           // Skip remaining iterations if an error occurred
           if (failed) continue;
           
@@ -2728,13 +2732,97 @@ void get_stepwise_scattersky_propmat(StokesVector& ap,
     }
   }
 
+  // Temperature derivative of the bulk properties due to the temperature
+  // dependence of the single scattering data. Obtained by perturbing the
+  // local temperature (as done for the gas absorption); the propagation
+  // along the path is then analytical.
+  Tensor5 dext_mat_bulk_dt;
+  Tensor4 dabs_vec_bulk_dt;
+  if( jacobian_do  &&  do_temperature_jacobian(jacobian_quantities) )
+  {
+    Numeric dt = temperature_perturbation(jacobian_quantities);
+    Vector t_pert = ppath_temperature;
+    t_pert += dt;
+    ArrayOfArrayOfTensor5 ext_mat_Nse_dt;
+    ArrayOfArrayOfTensor4 abs_vec_Nse_dt;
+    ArrayOfArrayOfIndex ptypes_Nse_dt;
+    Matrix t_ok_dt;
+    opt_prop_NScatElems( ext_mat_Nse_dt, abs_vec_Nse_dt, ptypes_Nse_dt, t_ok_dt,
+                         scat_data, stokes_dim, t_pert, dir_array, -1 );
+
+    // Scattering elements with T+dt outside of their T-grid use a backward
+    // difference instead (as in get_stepwise_scattersky_source).
+    bool any_backward = false;
+    for( Index ise = 0; ise < t_ok_dt.nrows(); ise++ )
+      if( ppath_1p_pnd(ise,0) != 0.  &&  t_ok_dt(ise,0) <= 0. )
+        any_backward = true;
+
+    ArrayOfArrayOfTensor5 ext_mat_Nse_back;
+    ArrayOfArrayOfTensor4 abs_vec_Nse_back;
+    ArrayOfArrayOfIndex ptypes_Nse_back;
+    Matrix t_ok_back;
+    if( any_backward )
+    {
+      Vector t_back = ppath_temperature;
+      t_back -= dt;
+      opt_prop_NScatElems( ext_mat_Nse_back, abs_vec_Nse_back,
+                           ptypes_Nse_back, t_ok_back, scat_data, stokes_dim,
+                           t_back, dir_array, -1 );
+    }
+
+    // Derivatives of the scattering elements, stored in place of the
+    // perturbed properties
+    Index ise = 0;
+    for( Index i_ss = 0; i_ss < ext_mat_Nse_dt.nelem(); i_ss++ )
+      for( Index i_se = 0; i_se < ext_mat_Nse_dt[i_ss].nelem(); i_se++, ise++ )
+      {
+        Tensor5& dext = ext_mat_Nse_dt[i_ss][i_se];
+        Tensor4& dabs = abs_vec_Nse_dt[i_ss][i_se];
+        Numeric dt_se = dt;
+        if( ppath_1p_pnd(ise,0) == 0. )
+        {
+          dext = 0.;
+          dabs = 0.;
+          continue;
+        }
+        else if( t_ok_dt(ise,0) <= 0. )
+        {
+          if( t_ok_back(ise,0) <= 0. )
+          {
+            ostringstream os;
+            os << "Temperature Jacobian: Neither T+dt nor T-dt is inside the "
+               << "temperature grid of (flat-array) scattering element #"
+               << ise << "\n"
+               << "at ppath point #" << ppath_1p_id << " (T = "
+               << ppath_temperature[0] << " K, dt = " << dt << " K).\n"
+               << "Use a smaller temperature perturbation or scattering data "
+               << "with a wider temperature grid.";
+            throw runtime_error( os.str() );
+          }
+          dt_se = -dt;
+          dext = ext_mat_Nse_back[i_ss][i_se];
+          dabs = abs_vec_Nse_back[i_ss][i_se];
+        }
+        dext -= ext_mat_Nse[i_ss][i_se];
+        dext *= 1./dt_se;
+        dabs -= abs_vec_Nse[i_ss][i_se];
+        dabs *= 1./dt_se;
+      }
+
+    opt_prop_ScatSpecBulk( ext_mat_ssbulk, abs_vec_ssbulk, ptype_ssbulk,
+                           ext_mat_Nse_dt, abs_vec_Nse_dt, ptypes_Nse,
+                           ppath_1p_pnd, t_ok );
+    opt_prop_Bulk( dext_mat_bulk_dt, dabs_vec_bulk_dt, ptype_bulk,
+                   ext_mat_ssbulk, abs_vec_ssbulk, ptype_ssbulk );
+  }
+
   if( jacobian_do )
     FOR_ANALYTICAL_JACOBIANS_DO
     (
       if( ppath_dpnd_dx[iq].empty() )
       {
-        dap_dx[iq].SetZero();
-        dKp_dx[iq].SetZero();
+        ext_mat_bulk = 0.;
+        abs_vec_bulk = 0.;
       }
       else
       {
@@ -2746,18 +2834,23 @@ void get_stepwise_scattersky_propmat(StokesVector& ap,
                                t_ok );
         opt_prop_Bulk( ext_mat_bulk, abs_vec_bulk, ptype_bulk,
                        ext_mat_ssbulk, abs_vec_ssbulk, ptype_ssbulk );
-        for( Index iv = 0; iv < nf; iv++ )
+      }
+      if( jacobian_quantities[iq] == JacPropMatType::Temperature )
+      {
+        ext_mat_bulk += dext_mat_bulk_dt;
+        abs_vec_bulk += dabs_vec_bulk_dt;
+      }
+      for( Index iv = 0; iv < nf; iv++ )
+      {
+        if( nf_ssd>1 )
         {
-          if( nf_ssd>1 )
-          {
-            dap_dx[iq].SetAtPosition(abs_vec_bulk(iv,0,0,joker), iv);
-            dKp_dx[iq].SetAtPosition(ext_mat_bulk(iv,0,0,joker,joker), iv);
-          }
-          else
-          {
-            dap_dx[iq].SetAtPosition(abs_vec_bulk(0,0,0,joker), iv);
-            dKp_dx[iq].SetAtPosition(ext_mat_bulk(0,0,0,joker,joker), iv);
-          }
+          dap_dx[iq].SetAtPosition(abs_vec_bulk(iv,0,0,joker), iv);
+          dKp_dx[iq].SetAtPosition(ext_mat_bulk(iv,0,0,joker,joker), iv);
+        }
+        else
+        {
+          dap_dx[iq].SetAtPosition(abs_vec_bulk(0,0,0,joker), iv);
+          dKp_dx[iq].SetAtPosition(ext_mat_bulk(0,0,0,joker,joker), iv);
         }
       }
     )
@@ -2857,6 +2950,22 @@ void get_stepwise_scattersky_source(StokesVector& Sp,
   Index ptype;
   Tensor3 scat_source_1se(ne, nf, stokes_dim, 0.);
 
+  // For temperature Jacobians, the scattering source is also derived at a
+  // perturbed temperature (see get_stepwise_scattersky_propmat).
+  const bool do_t_jac = jacobian_do &&
+                        do_temperature_jacobian(jacobian_quantities);
+  Numeric dt = 0.;
+  Vector temperature_pert;
+  Tensor3 dscat_source_1se_dt(0, 0, 0);
+  if( do_t_jac )
+    {
+      dt = temperature_perturbation(jacobian_quantities);
+      temperature_pert = temperature;
+      temperature_pert += dt;
+      dscat_source_1se_dt.resize(ne, nf, stokes_dim);
+      dscat_source_1se_dt = 0.;
+    }
+
   Index ise_flat = 0;
   for( Index i_ss = 0; i_ss<scat_data.nelem(); i_ss++ )
     {
@@ -2925,6 +3034,74 @@ void get_stepwise_scattersky_source(StokesVector& Sp,
                                                          scat_aa_grid );
                     }
                 }  // for iv
+
+              if( do_t_jac  &&  ppath_1p_pnd[ise_flat] != 0 )
+                {
+                  Numeric dt_se = dt;
+                  pha_mat_1ScatElem( pha_mat_1se, ptype, t_ok,
+                                     scat_data[i_ss][i_se],
+                                     temperature_pert, pdir, idir,
+                                     0, t_interp_order );
+                  if( !t_ok[0] )
+                    {
+                      // Outside of T-grid, use backward difference
+                      dt_se = -dt;
+                      Vector temperature_back = temperature;
+                      temperature_back += dt_se;
+                      pha_mat_1ScatElem( pha_mat_1se, ptype, t_ok,
+                                         scat_data[i_ss][i_se],
+                                         temperature_back, pdir, idir,
+                                         0, t_interp_order );
+                      if( !t_ok[0] )
+                        {
+                          ostringstream os;
+                          os << "Temperature Jacobian: Neither T+dt nor T-dt "
+                             << "is inside the temperature grid of (flat-array) "
+                             << "scattering element #" << ise_flat << "\n"
+                             << "at location/temperature point #"
+                             << ppath_1p_id << " (T = " << temperature[0]
+                             << " K, dt = " << dt << " K).\n"
+                             << "Use a smaller temperature perturbation or "
+                             << "scattering data with a wider temperature grid.";
+                          throw runtime_error( os.str() );
+                        }
+                    }
+
+                  this_iv = 0;
+                  for( Index iv = 0; iv < nf; iv++ )
+                    {
+                      if( !duplicate_freqs )
+                        { this_iv = iv; }
+                      Tensor3 product_fields(nza, naa, stokes_dim, 0.);
+
+                      ia = 0;
+                      for( Index iza = 0; iza < nza; iza++ )
+                        {
+                          for( Index iaa = 0; iaa < naa; iaa++ )
+                            {
+                              for ( Index i = 0; i < stokes_dim; i++)
+                                {
+                                  for ( Index j = 0; j < stokes_dim; j++ )
+                                    {
+                                      product_fields(iza, iaa, i) +=
+                                        pha_mat_1se(this_iv, 0, 0, ia, i, j) *
+                                        inc_field(iv, iza, j);
+                                    }
+                                }
+                              ia++;
+                            }
+                        }
+
+                      for ( Index i = 0; i < stokes_dim; i++ )
+                        {
+                          dscat_source_1se_dt( ise_flat, iv, i) =
+                            ( AngIntegrate_trapezoid(
+                                product_fields(joker, joker, i), scat_za_grid,
+                                scat_aa_grid ) -
+                              scat_source_1se( ise_flat, iv, i) ) / dt_se;
+                        }
+                    }  // for iv
+                }
             } // if val_pnd
 
           ise_flat++;
@@ -2948,7 +3125,9 @@ void get_stepwise_scattersky_source(StokesVector& Sp,
       if( jacobian_do )
         {
           FOR_ANALYTICAL_JACOBIANS_DO(
-            if( ppath_dpnd_dx[iq].empty() )
+            const bool is_t = jacobian_quantities[iq] ==
+                              JacPropMatType::Temperature;
+            if( ppath_dpnd_dx[iq].empty() && !is_t )
               { dSp_dx[iq].SetZero(); }
             else
               {
@@ -2957,11 +3136,15 @@ void get_stepwise_scattersky_source(StokesVector& Sp,
                   {
                     for( Index i=0; i<stokes_dim; i ++ )
                       {
-                        scat_source[i] += scat_source_1se(ise_flat,iv,i) *
-                          ppath_dpnd_dx[iq](ise_flat,ppath_1p_id);
-                        dSp_dx[iq].SetAtPosition(scat_source,iv);
+                        if( !ppath_dpnd_dx[iq].empty() )
+                          scat_source[i] += scat_source_1se(ise_flat,iv,i) *
+                            ppath_dpnd_dx[iq](ise_flat,ppath_1p_id);
+                        if( is_t )
+                          scat_source[i] += dscat_source_1se_dt(ise_flat,iv,i) *
+                            ppath_1p_pnd[ise_flat];
                       }
                   }
+                dSp_dx[iq].SetAtPosition(scat_source,iv);
               }
            )
         }
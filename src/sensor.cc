@@ -134,10 +134,13 @@ void antenna1d_matrix(
   // Resize H
   H.resize( n_ant*nfpol, n_za*nfpol );
 
-  // Storage vectors for response weights
-  Vector hrow( H.ncols(), 0.0 );
+  // Storage vector for response weights
   Vector hza( n_za, 0.0 );
 
+  // Non-zero elements of H, inserted after the loops
+  ArrayOfIndex rowind, colind;
+  ArrayOfNumeric values;
+
   // Antenna response to apply (possibly obtained by frequency interpolation)
   Vector aresponse( n_ar_za, 0.0 );
 
@@ -206,14 +209,20 @@ void antenna1d_matrix(
               //
               const Index ii = f*n_pol + ip;
               //
-              hrow[ Range(ii,n_za,nfpol) ] = hza;
-              //
-              H.insert_row( ia*nfpol+ii, hrow );
-              //
-              hrow = 0;
+              for( Index iz=0; iz<n_za; iz++ )
+                {
+                  if( hza[iz] != 0 )
+                    {
+                      rowind.push_back( ia*nfpol+ii );
+                      colind.push_back( iz*nfpol+ii );
+                      values.push_back( hza[iz] );
+                    }
+                }
             }
         }
     }
+
+  H.insert_elements( values.nelem(), rowind, colind, Vector(values) );
 }
 
 
@@ -960,12 +969,14 @@ void spectrometer_matrix(
   //
   H.resize( nout, nin );
 
-  // Calculate the sensor integration vector and put values in the temporary
-  // vector, then copy vector to the transfer matrix
+  // Calculate the sensor integration vector and collect the non-zero
+  // values, that are inserted into the transfer matrix in one go. Inserting
+  // complete rows is much slower for large matrices.
   //
   Vector ch_response_f;
   Vector weights( nin_f );
-  Vector weights_long( nin, 0.0 );
+  ArrayOfIndex rowind, colind;
+  ArrayOfNumeric values;
   //
   for( Index ifr=0; ifr<nout_f; ifr++ ) 
     {
@@ -989,17 +1000,20 @@ void spectrometer_matrix(
         {
           for( Index pol=0; pol<n_pol; pol++ ) 
             {
-              // Distribute the compact weight vector into weight_long
-              weights_long[Range(sp*nin_f*n_pol+pol,nin_f,n_pol)] = weights;
-
-              // Insert temp_long into H at the correct row
-              H.insert_row( sp*nout_f*n_pol + ifr*n_pol + pol, weights_long );
-
-              // Reset weight_long to zero.
-              weights_long = 0.0;
+              for( Index i=0; i<nin_f; i++ )
+                {
+                  if( weights[i] != 0 )
+                    {
+                      rowind.push_back( sp*nout_f*n_pol + ifr*n_pol + pol );
+                      colind.push_back( sp*nin_f*n_pol + i*n_pol + pol );
+                      values.push_back( weights[i] );
+                    }
+                }
             }
         }
     }
+
+  H.insert_elements( values.nelem(), rowind, colind, Vector(values) );
 }
 
 
@@ -0,0 +1,195 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+   USA. */
+
+/*!
+  \file   test_arts_server.cc
+
+  \brief  Test of concurrent client sessions of ArtsServer.
+
+  Two clients execute controlfiles on their own sessions at the same time.
+  Each controlfile sets a variable of the base workspace to a session
+  specific value and checks that it still holds this value afterwards.
+  The base workspace must not be changed.
+*/
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "arts.h"
+#include "arts_server.h"
+#include "global_data.h"
+#include "wsv_aux.h"
+
+// Error buffer of the C API, used by InteractiveWorkspace.
+std::string string_buffer;
+
+Index get_wsv_id(const char*);
+
+static const char socket_path[] = "test_arts_server.socket";
+
+static Index n_failed = 0;
+
+static void check(bool ok, const String& what)
+{
+  cout << what << ": " << (ok ? "PASSED" : "FAILED") << endl;
+  if (!ok) n_failed++;
+}
+
+//! Connect to the server, waiting for it to start listening.
+static int connect_to_server()
+{
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, socket_path);
+
+  for (Index i = 0; i < 100; i++)
+    {
+      int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if (fd >= 0
+          && ::connect(fd, (sockaddr*) &address, sizeof(address)) == 0)
+        return fd;
+      if (fd >= 0) ::close(fd);
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+  return -1;
+}
+
+//! Send a request and return the reply, including an error message.
+static String request(int fd, const String& line)
+{
+  const String msg = line + "\n";
+  if (::send(fd, msg.c_str(), msg.size(), MSG_NOSIGNAL) != (ssize_t) msg.size())
+    return "";
+
+  String reply;
+  char c;
+  while (::recv(fd, &c, 1, 0) == 1 && c != '\n')
+    reply += c;
+
+  size_t n;
+  if (sscanf(reply.c_str(), "ERROR %zu", &n) == 1)
+    {
+      reply += '\n';
+      for (; n > 0 && ::recv(fd, &c, 1, 0) == 1; n--)
+        reply += c;
+    }
+  return reply;
+}
+
+//! Controlfile setting f_grid to value and checking it n times.
+static String write_controlfile(const String& name, Numeric value)
+{
+  const String filename = "test_arts_server." + name + ".arts";
+  std::ofstream os(filename.c_str());
+  os << "Arts2 {\n"
+     << "VectorCreate( ref_" << name << " )\n"
+     << "VectorSetConstant( ref_" << name << ", 10000, " << value << " )\n";
+  for (Index i = 0; i < 50; i++)
+    os << "VectorSetConstant( f_grid, 10000, " << value << " )\n"
+       << "Compare( f_grid, ref_" << name << ", 0, \"f_grid changed\" )\n";
+  os << "}\n";
+  return filename;
+}
+
+static bool equals(const Vector& v, const Vector& ref)
+{
+  if (v.nelem() != ref.nelem()) return false;
+  for (Index i = 0; i < v.nelem(); i++)
+    if (v[i] != ref[i]) return false;
+  return true;
+}
+
+int main()
+{
+  InteractiveWorkspace::initialize();
+  InteractiveWorkspace base(0, 0);
+
+  const Index f_grid = get_wsv_id("f_grid");
+  const Numeric f[] = {1., 2., 3.};
+  base.set_vector_variable(f_grid, 3, f);
+  const Vector f_ref(f[0], 3, 1.);
+
+  const String controlfiles[] = {write_controlfile("a", 10.),
+                                 write_controlfile("b", 20.)};
+  {
+    std::ofstream os("test_arts_server.exit.arts");
+    os << "Arts2 {\nExit\n}\n";
+  }
+
+  ArtsServer server(base, socket_path, 2);
+  std::thread server_thread([&server]() {
+      try
+        {
+          server.run();
+        }
+      catch (const std::runtime_error& e)
+        {
+          cerr << e.what() << endl;
+        }
+    });
+
+  int fd[2];
+  String id[2];
+  for (Index i = 0; i < 2; i++)
+    {
+      fd[i] = connect_to_server();
+      String reply = fd[i] < 0 ? "" : request(fd[i], "create");
+      if (reply.substr(0, 3) == "OK ") id[i] = reply.substr(3);
+    }
+  check(fd[0] >= 0 && fd[1] >= 0 && id[0].size() && id[1].size()
+        && id[0] != id[1], "Two sessions created");
+
+  // Both clients execute their controlfile repeatedly at the same time.
+  Index n_ok[2] = {0, 0};
+  std::thread clients[2];
+  for (Index i = 0; i < 2; i++)
+    clients[i] = std::thread([&, i]() {
+        for (Index j = 0; j < 20; j++)
+          {
+            String reply = request(fd[i], "execute " + id[i] + " "
+                                   + controlfiles[i]);
+            if (reply.substr(0, 3) == "OK ") n_ok[i]++;
+            else cerr << reply << endl;
+          }
+      });
+  for (Index i = 0; i < 2; i++) clients[i].join();
+
+  check(n_ok[0] == 20 && n_ok[1] == 20,
+        "Concurrent sessions keep their own values");
+  check(equals(*(Vector*) base[f_grid], f_ref), "Base keeps its value");
+
+  // Exit would stop the server for all clients.
+  String reply = request(fd[0], "execute " + id[0]
+                         + " test_arts_server.exit.arts");
+  check(reply.substr(0, 6) == "ERROR ", "Exit rejected");
+  reply = request(fd[1], "stats");
+  check(reply.substr(0, 12) == "OK requests=", "Server still running");
+
+  request(fd[0], "shutdown");
+  server_thread.join();
+  ::close(fd[0]);
+  ::close(fd[1]);
+
+  return n_failed ? 1 : 0;
+}
@@ -404,6 +404,145 @@ Numeric test_io(Index n_tests)
     return 0.0;
 }
 
+/**
+ * Maximum absolute difference of two matrices, relative to the largest
+ * absolute element of the reference matrix.
+ */
+Numeric get_scaled_error(ConstMatrixView A, ConstMatrixView A_ref)
+{
+    Numeric e = 0.0, a_max = 0.0;
+    for (Index i = 0; i < A_ref.nrows(); i++) {
+        for (Index j = 0; j < A_ref.ncols(); j++) {
+            e     = std::max(e, abs(A(i,j) - A_ref(i,j)));
+            a_max = std::max(a_max, abs(A_ref(i,j)));
+        }
+    }
+    return e / a_max;
+}
+
+/**
+ * Add a block with elements f(k,l) to a covariance matrix.
+ *
+ * @param covmat The covariance matrix to add the block to
+ * @param i The block-row index
+ * @param j The block-column index
+ * @param row_range The range of element-rows covered by the block
+ * @param column_range The range of element-columns covered by the block
+ * @param f The functional giving the element at row k and column l of
+ *        the block.
+ */
+template<typename F>
+void add_dense_block(CovarianceMatrix &covmat, Index i, Index j,
+                     Range row_range, Range column_range, F f)
+{
+    std::shared_ptr<Matrix> m = std::make_shared<Matrix>(
+        row_range.get_extent(), column_range.get_extent());
+    for (Index k = 0; k < m->nrows(); k++) {
+        for (Index l = 0; l < m->ncols(); l++) {
+            (*m)(k,l) = f(k,l);
+        }
+    }
+    covmat.add_correlation(Block(row_range, column_range,
+                                 std::make_pair(i, j), m));
+}
+
+/**
+ * Test the different ways in which inverses are computed, i.e. the Cholesky
+ * decomposition for positive definite blocks, the general inversion for
+ * other blocks and the direct inversion of diagonal sparse blocks, as well
+ * as the removal of inverses that are no longer valid when blocks are
+ * added.
+ *
+ * @return The maximum error of the inverses with respect to the inverse of
+ * an identical matrix of type Matrix
+ */
+Numeric test_inverse_paths()
+{
+    Numeric e = 0.0;
+    Range r0(0, 5), r1(5, 4), r2(9, 3);
+
+    auto exp_corr = [](Index k, Index l) -> Numeric {
+        return exp(-abs(static_cast<Numeric>(k - l)) / 2.0);};
+    auto cross    = [](Index k, Index l) -> Numeric {
+        return 0.05 * exp(-abs(static_cast<Numeric>(k - l)));};
+    auto indefinite = [](Index k, Index l) -> Numeric {
+        if (k == l) return (k % 2 == 0) ? 2.0 : -3.0;
+        if (abs(k - l) == 1) return 0.1;
+        return 0.0;};
+
+    std::shared_ptr<Sparse> d = std::make_shared<Sparse>(3, 3);
+    d->insert_elements(3, ArrayOfIndex{0, 1, 2}, ArrayOfIndex{0, 1, 2},
+                       Vector{1.0, 2.0, 4.0});
+
+    // Positive definite correlated blocks (Cholesky) and a diagonal
+    // sparse block.
+    CovarianceMatrix covmat_1{};
+    add_dense_block(covmat_1, 0, 0, r0, r0, exp_corr);
+    add_dense_block(covmat_1, 1, 1, r1, r1, exp_corr);
+    add_dense_block(covmat_1, 0, 1, r0, r1, cross);
+    covmat_1.add_correlation(Block(r2, r2, std::make_pair(2, 2), d));
+    covmat_1.compute_inverse();
+
+    Matrix A(covmat_1), A_inv(A.nrows(), A.ncols());
+    inv(A_inv, A);
+    e = std::max(e, get_scaled_error(covmat_1.get_inverse(), A_inv));
+
+    Vector d_inv = covmat_1.inverse_diagonal();
+    e = std::max(e, get_maximum_error(d_inv, A_inv.diagonal(), true));
+
+    // Symmetric but indefinite block, inverted by the general method.
+    CovarianceMatrix covmat_2{};
+    add_dense_block(covmat_2, 0, 0, r0, r0, indefinite);
+    covmat_2.add_correlation(Block(Range(5, 3), Range(5, 3),
+                                   std::make_pair(1, 1), d));
+    covmat_2.compute_inverse();
+
+    A = Matrix(covmat_2);
+    A_inv.resize(A.nrows(), A.ncols());
+    inv(A_inv, A);
+    e = std::max(e, get_scaled_error(covmat_2.get_inverse(), A_inv));
+
+    // Quantities 0 and 1 are correlated through 2, so there is an inverse
+    // block for each pair. Adding a direct correlation between 0 and 1
+    // must remove these inverses.
+    CovarianceMatrix covmat_3{};
+    add_dense_block(covmat_3, 0, 0, r0, r0, exp_corr);
+    add_dense_block(covmat_3, 1, 1, r1, r1, exp_corr);
+    add_dense_block(covmat_3, 2, 2, r2, r2, exp_corr);
+    add_dense_block(covmat_3, 0, 2, r0, r2, cross);
+    add_dense_block(covmat_3, 1, 2, r1, r2, cross);
+    covmat_3.compute_inverse();
+    add_dense_block(covmat_3, 0, 1, r0, r1, cross);
+    covmat_3.compute_inverse();
+
+    A = Matrix(covmat_3);
+    A_inv.resize(A.nrows(), A.ncols());
+    inv(A_inv, A);
+    e = std::max(e, get_scaled_error(covmat_3.get_inverse(), A_inv));
+
+    // A provided inverse replaces an earlier one of the same block.
+    CovarianceMatrix covmat_4{};
+    std::shared_ptr<Sparse> d2 = std::make_shared<Sparse>(*d);
+    *d2 *= 2.0;
+    covmat_4.add_correlation(Block(Range(0, 3), Range(0, 3),
+                                   std::make_pair(0, 0), d2));
+    covmat_4.compute_inverse();
+    std::shared_ptr<Matrix> d2_inv = std::make_shared<Matrix>(3, 3);
+    *d2_inv = 0.0;
+    for (Index k = 0; k < 3; k++) {
+        (*d2_inv)(k,k) = 1.0 / (2.0 * (*d)(k,k));
+    }
+    covmat_4.add_correlation_inverse(Block(Range(0, 3), Range(0, 3),
+                                           std::make_pair(0, 0), d2_inv));
+
+    Vector v{1.0, 1.0, 1.0}, w(3), w_ref(3);
+    solve(w, covmat_4, v);
+    mult(w_ref, *d2_inv, v);
+    e = std::max(e, get_maximum_error(w, w_ref, true));
+
+    return e;
+}
+
 template<typename MatrixType>
 void covmat_seSet(CovarianceMatrix& covmat,
                   const MatrixType& block,
@@ -651,6 +790,13 @@ int main() {
         return -1;
     }
 
+    e = test_inverse_paths();
+    std::cout << "\tInverse paths:           " << e << std::endl;
+    e_max = std::max(e, e_max);
+    if (e_max > 1e-5) {
+        return -1;
+    }
+
     std::cout << std::endl << "\tTesting workspace functions ... ";
     test_workspace_methods();
     std::cout << " DONE." << std::endl;
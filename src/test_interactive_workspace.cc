@@ -0,0 +1,228 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of the
+   License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+   USA. */
+
+/*!
+  \file   test_interactive_workspace.cc
+
+  \brief  Tests for workspaces sharing the variables of a base workspace.
+*/
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "arts.h"
+#include "global_data.h"
+#include "interactive_workspace.h"
+#include "matpackVII.h"
+#include "wsv_aux.h"
+
+// Error buffer of the C API, used by InteractiveWorkspace.
+std::string string_buffer;
+
+Index get_wsv_id(const char*);
+
+static Index n_failed = 0;
+
+static void check(bool ok, const String& what)
+{
+  cout << what << ": " << (ok ? "PASSED" : "FAILED") << endl;
+  if (!ok) n_failed++;
+}
+
+//! Agenda holding a single method call.
+static Agenda single_method_agenda(const String& method,
+                                   const ArrayOfIndex& output,
+                                   const ArrayOfIndex& input)
+{
+  using global_data::MdMap;
+
+  Agenda a;
+  a.set_name("test_agenda");
+  a.push_back(MRecord(MdMap.find(method)->second, output, input,
+                      TokVal(), Agenda()));
+  a.set_main_agenda();
+  return a;
+}
+
+static bool equals(const Vector& v, const Vector& ref)
+{
+  if (v.nelem() != ref.nelem()) return false;
+  for (Index i = 0; i < v.nelem(); i++)
+    if (v[i] != ref[i]) return false;
+  return true;
+}
+
+//! Check the lifetime rules for a variable using memory of the caller.
+/*!
+  The variable wraps a caller buffer. A method writing to the variable must
+  work on a copy, leaving the buffer untouched. Releasing the buffer gives
+  a copy of the data or an empty variable.
+*/
+template <class T>
+static void test_external(InteractiveWorkspace& ws,
+                          const String& group,
+                          const ArrayOfIndex& dims,
+                          Index scale)
+{
+  const Index group_id = get_wsv_group_id(group);
+  long n[7];
+  Index nelem = 1;
+  for (Index i = 0; i < dims.nelem(); i++)
+    {
+      n[i] = dims[i];
+      nelem *= dims[i];
+    }
+
+  std::vector<Numeric> buffer(nelem);
+  for (Index i = 0; i < nelem; i++) buffer[i] = Numeric(i + 1);
+  const std::vector<Numeric> original(buffer);
+
+  const String name = "test_external_" + group;
+  const Index id = ws.add_variable(group_id, name.c_str());
+  bool ok = ws.set_external_variable(id, group_id, n, buffer.data());
+  check(ok && reinterpret_cast<T*>(ws[id])->get_c_array() == buffer.data(),
+        group + " wraps caller buffer");
+
+  // Scale the variable in place.
+  Agenda scale_agenda = single_method_agenda(group + "Scale", {id},
+                                             {id, scale});
+  ws.unshare_outputs(scale_agenda);
+  ws.execute(scale_agenda);
+  const Numeric* data = reinterpret_cast<T*>(ws[id])->get_c_array();
+  ok = data != buffer.data() && buffer == original;
+  for (Index i = 0; ok && i < nelem; i++)
+    ok = data[i] == 2 * original[i];
+  check(ok, group + " method output leaves buffer untouched");
+
+  // The variable owns its data now, so releasing has no effect.
+  ws.release_external_variable(id, false);
+  check(reinterpret_cast<T*>(ws[id])->get_c_array() == data
+        && data[0] == 2 * original[0],
+        group + " owned after method call");
+
+  ws.set_external_variable(id, group_id, n, buffer.data());
+  ws.release_external_variable(id, true);
+  data = reinterpret_cast<T*>(ws[id])->get_c_array();
+  ok = data != buffer.data();
+  for (Index i = 0; ok && i < nelem; i++)
+    ok = data[i] == original[i];
+  check(ok, group + " keeps a copy when released with keep_value");
+
+  ws.set_external_variable(id, group_id, n, buffer.data());
+  ws.release_external_variable(id, false);
+  check(reinterpret_cast<T*>(ws[id])->empty() && buffer == original,
+        group + " is empty when released without keep_value");
+}
+
+int main()
+{
+  InteractiveWorkspace::initialize();
+  InteractiveWorkspace base(0, 0);
+
+  const Index f_grid = get_wsv_id("f_grid");
+  const Index p_grid = get_wsv_id("p_grid");
+  const Numeric f[] = {1., 2., 3.};
+  const Numeric p[] = {5., 6.};
+  base.set_vector_variable(f_grid, 3, f);
+  base.set_vector_variable(p_grid, 2, p);
+  const Vector f_ref(f[0], 3, 1.);
+  const Vector p_ref(p[0], 2, 1.);
+
+  InteractiveWorkspace client(base);
+  check(client[f_grid] == base[f_grid] && client[p_grid] == base[p_grid],
+        "Copy constructor shares values");
+
+  // Copy( f_grid, p_grid ) must only unshare f_grid.
+  Agenda copy = single_method_agenda("Copy_sg_Vector", {f_grid}, {p_grid});
+  client.unshare_outputs(copy);
+  check(client[f_grid] != base[f_grid], "Outputs are unshared");
+  check(client[p_grid] == base[p_grid], "Inputs stay shared");
+
+  client.execute(copy);
+  check(equals(*(Vector*)client[f_grid], p_ref), "Client has new value");
+  check(equals(*(Vector*)base[f_grid], f_ref), "Base keeps its value");
+
+  // Delete frees its input, which must not affect the base.
+  Agenda del = single_method_agenda("Delete_sg_Vector", {}, {p_grid});
+  client.unshare_outputs(del);
+  client.execute(del);
+  check(base.is_initialized(p_grid)
+        && equals(*(Vector*)base[p_grid], p_ref),
+        "Delete leaves base untouched");
+
+  // Methods writing arbitrary variables are rejected on shared workspaces.
+  const Index filename = client.add_variable(get_wsv_group_id("String"),
+                                             "test_snapshot_file");
+  Agenda read = single_method_agenda("ReadWorkspaceSnapshot", {},
+                                     {filename});
+  bool rejected = false;
+  try
+    {
+      client.unshare_outputs(read);
+    }
+  catch (const std::runtime_error&)
+    {
+      rejected = true;
+    }
+  check(rejected, "ReadWorkspaceSnapshot rejected on shared workspace");
+
+  bool accepted = true;
+  try
+    {
+      base.unshare_outputs(read);
+    }
+  catch (const std::runtime_error&)
+    {
+      accepted = false;
+    }
+  check(accepted, "ReadWorkspaceSnapshot accepted on base workspace");
+
+  // Exit would terminate the process serving all shared workspaces.
+  Agenda exit = single_method_agenda("Exit", {}, {});
+  rejected = false;
+  try
+    {
+      client.unshare_outputs(exit);
+    }
+  catch (const std::runtime_error&)
+    {
+      rejected = true;
+    }
+  check(rejected, "Exit rejected on shared workspace");
+
+  // File readers must not run concurrently.
+  Agenda read_xml = single_method_agenda("ReadXML_sg_Vector", {f_grid},
+                                         {filename});
+  check(!client.is_reentrant(read_xml) && client.is_reentrant(copy),
+        "File readers are not reentrant");
+
+  // Variables using memory owned by the caller.
+  InteractiveWorkspace owner(0, 0);
+  const Index scale = owner.add_variable(get_wsv_group_id("Numeric"),
+                                         "test_scale");
+  owner.set_numeric_variable(scale, 2.);
+  test_external<Vector>(owner, "Vector", {4}, scale);
+  test_external<Matrix>(owner, "Matrix", {2, 3}, scale);
+  test_external<Tensor3>(owner, "Tensor3", {2, 1, 3}, scale);
+  test_external<Tensor4>(owner, "Tensor4", {2, 1, 2, 3}, scale);
+  test_external<Tensor5>(owner, "Tensor5", {1, 2, 1, 2, 3}, scale);
+  test_external<Tensor6>(owner, "Tensor6", {2, 1, 1, 2, 1, 3}, scale);
+  test_external<Tensor7>(owner, "Tensor7", {1, 2, 1, 1, 2, 1, 3}, scale);
+
+
+  return n_failed ? 1 : 0;
+}
@@ -534,6 +534,69 @@ Numeric test_insert_row( Index ntests, bool verbose )
     return err_max;
 }
 
+//! Test inserting elements in CSR format.
+/*!
+  Creates random dense matrices, converts them to compressed row arrays
+  and inserts these into a sparse matrix using
+  Sparse::insert_elements_csr(...).
+
+  \param ntest The number of tests to perform.
+  \param verbose If true, test results for each test are printed to stdout.
+
+  \return The maximum relative error between the original and the copied
+  matrix.
+*/
+Numeric test_insert_elements_csr( Index ntests, bool verbose )
+{
+
+    Numeric err_max = 0.0;
+
+    if (verbose)
+        cout << endl << "Testing insert_elements_csr:" << endl << endl;
+
+    for ( Index i = 0; i < ntests; i++ )
+    {
+
+        Index m = (std::rand() % 100) + 1;
+        Index n = (std::rand() % 100) + 1;
+
+        Matrix A( m, n, 0.0 );
+        Sparse A_sparse( m, n );
+        random_fill_matrix( A, A_sparse, 10, false );
+
+        std::vector<int> row_starts( 1, 0 );
+        std::vector<int> column_indices;
+        std::vector<Numeric> data;
+        for ( Index r = 0; r < m; r++ )
+        {
+            for ( Index c = 0; c < n; c++ )
+                if ( A( r, c ) != 0.0 )
+                {
+                    column_indices.push_back( (int) c );
+                    data.push_back( A( r, c ) );
+                }
+            row_starts.push_back( (int) data.size() );
+        }
+
+        Sparse B_sparse( m, n );
+        B_sparse.insert_elements_csr( data.size(), row_starts.data(),
+                                      column_indices.data(), data.data() );
+        Matrix B = B_sparse;
+
+        Numeric err = get_maximum_error( A, B, true );
+        if (err > err_max)
+            err_max = err;
+
+        if (verbose)
+        {
+            cout << endl;
+            cout << "Maximum relative error: " << err << endl;
+        }
+    }
+
+    return err_max;
+}
+
 //! Test sparse identity matrix.
 /*!
 
@@ -1264,6 +1327,13 @@ int main()
     else
         cout << "FAILED (Error: " << err << ")" << endl;
 
+    cout << "Testing inserting of CSR arrays: ";
+    err = test_insert_elements_csr( 100, false );
+    if (err < 1e-11)
+        cout << "PASSED" << endl;
+    else
+        cout << "FAILED (Error: " << err << ")" << endl;
+
     cout << "Testing abs(...) and transpose(...): ";
     err = test_sparse_unary_operations( 1000, 1000, 1000, false );
     if (err < 1e-11)
@@ -87,6 +87,9 @@ public:
   /** Return Matrix. */
   operator Matrix() const;
 
+  /** Return the type of the stored value. */
+  TokValType type() const { return mtype; }
+
   /** Output operator. */
   friend std::ostream& operator<<(std::ostream& os, const TokVal& a);
 
@@ -0,0 +1,323 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   workspace_snapshot.cc
+
+  \brief  Saving and restoring the state of a workspace.
+*/
+
+#include "workspace_snapshot.h"
+#include "arts.h"
+#include "auto_md.h"
+#include "agenda_class.h"
+#include "bifstream.h"
+#include "bofstream.h"
+#include "file.h"
+#include "xml_io.h"
+#include "xml_io_private.h"
+#include "xml_io_types.h"
+#include "global_data.h"
+
+using global_data::wsv_group_names;
+
+
+//! Check if the value of a variable belongs into a snapshot
+/*!
+  Variables for literals in the controlfile are allocated by the parser
+  and only valid inside a single method call. The verbosity settings
+  belong to the current run and are never restored from a snapshot.
+
+  \param[in] i  WSV index
+
+  \return true if the variable should be stored
+*/
+static bool snapshot_stores_wsv(const Index i)
+{
+  const String& name = Workspace::wsv_data[i].Name();
+
+  if (name.substr(0, 5) == "auto_") return false;
+
+  return Workspace::wsv_data[i].Group() != get_wsv_group_id("Verbosity");
+}
+
+
+//! Writes a workspace snapshot
+/*!
+  The names and groups of all workspace variables are stored, followed by
+  the values of all initialized variables. Values of groups which have no
+  XML IO are skipped with a warning.
+
+  \param[in] filename   Name of the snapshot file
+  \param[in] ws         Workspace
+  \param[in] verbosity  Verbosity
+*/
+void write_workspace_snapshot(const String& filename,
+                              Workspace& ws,
+                              const Verbosity& verbosity)
+{
+  CREATE_OUT1;
+  CREATE_OUT2;
+
+  const String efilename = add_basedir(filename);
+  const String bfilename = efilename + ".bin";
+
+  out2 << "  Writing workspace snapshot " << efilename << '\n';
+
+  ofstream ofs;
+  xml_open_output_file(ofs, efilename);
+
+  try
+    {
+      bofstream bofs(bfilename.c_str());
+
+      ArrayOfString names(ws.nelem());
+      ArrayOfString groups(ws.nelem());
+      ArrayOfString stored;
+      ostringstream os_vars;
+      xml_set_stream_precision(os_vars);
+
+      for (Index i = 0; i < ws.nelem(); i++)
+        {
+          const WsvRecord& wsv = Workspace::wsv_data[i];
+          names[i] = wsv.Name();
+          groups[i] = wsv_group_names[wsv.Group()];
+
+          if (!ws.is_initialized(i) || !snapshot_stores_wsv(i)) continue;
+
+          const streampos bpos = bofs.pos();
+          ostringstream os_var;
+          xml_set_stream_precision(os_var);
+
+          try
+            {
+              xml_write_wsv_to_stream(os_var, wsv.Group(), ws[i], &bofs,
+                                      wsv.Name(), verbosity);
+            }
+          catch (const std::runtime_error &e)
+            {
+              // Groups without XML IO throw before they write anything.
+              // Everything else means the snapshot is broken.
+              if (bofs.pos() != bpos) throw;
+
+              out1 << "  Warning: " << wsv.Name() << " ("
+                   << wsv_group_names[wsv.Group()]
+                   << ") is not stored in the snapshot: " << e.what() << '\n';
+              continue;
+            }
+
+          stored.push_back(wsv.Name());
+          os_vars << os_var.str();
+        }
+
+      ArtsXMLTag open_tag(verbosity);
+      ArtsXMLTag close_tag(verbosity);
+
+      xml_write_header_to_stream(ofs, FILE_TYPE_BINARY, verbosity);
+
+      open_tag.set_name("WorkspaceSnapshot");
+      open_tag.add_attribute("nelem", stored.nelem());
+      open_tag.write_to_stream(ofs);
+      ofs << '\n';
+
+      xml_write_to_stream(ofs, names, NULL, "variables", verbosity);
+      xml_write_to_stream(ofs, groups, NULL, "groups", verbosity);
+      xml_write_to_stream(ofs, stored, NULL, "stored", verbosity);
+      ofs << os_vars.str();
+
+      close_tag.set_name("/WorkspaceSnapshot");
+      close_tag.write_to_stream(ofs);
+      ofs << '\n';
+
+      xml_write_footer_to_stream(ofs, verbosity);
+
+      out2 << "  Stored " << stored.nelem() << " workspace variables.\n";
+    }
+  catch (const std::runtime_error &e)
+    {
+      ostringstream os;
+      os << "Error writing workspace snapshot: " << efilename << '\n'
+         << e.what();
+      throw runtime_error(os.str());
+    }
+}
+
+
+//! Reads the variables of a workspace snapshot
+/*!
+  Reads the WorkspaceSnapshot element from the stream and stores the
+  variables in the workspace.
+
+  \param[in,out] ws         Workspace
+  \param[in]     is_xml     XML input stream
+  \param[in]     pbifs      Pointer to binary input stream, NULL for ASCII
+  \param[in]     verbosity  Verbosity
+
+  \return Number of restored variables
+*/
+static Index read_snapshot_variables(Workspace& ws,
+                                     istream& is_xml,
+                                     bifstream* pbifs,
+                                     const Verbosity& verbosity)
+{
+  ArtsXMLTag tag(verbosity);
+  Index nelem;
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("WorkspaceSnapshot");
+  tag.get_attribute_value("nelem", nelem);
+
+  ArrayOfString names;
+  ArrayOfString groups;
+  ArrayOfString stored;
+  xml_read_from_stream(is_xml, names, pbifs, verbosity);
+  xml_read_from_stream(is_xml, groups, pbifs, verbosity);
+  xml_read_from_stream(is_xml, stored, pbifs, verbosity);
+
+  if (names.nelem() != groups.nelem() || stored.nelem() != nelem)
+    xml_data_parse_error(tag, "Size of variable directory does not "
+                              "match number of variables.");
+
+  // Make all variables known before reading, agendas refer to
+  // other variables by name.
+  for (Index i = 0; i < names.nelem(); i++)
+    {
+      const Index group = get_wsv_group_id(groups[i]);
+      if (group == -1)
+        {
+          ostringstream os;
+          os << "Unknown group " << groups[i]
+             << " for variable " << names[i] << ".";
+          throw runtime_error(os.str());
+        }
+
+      map<String, Index>::const_iterator it =
+        Workspace::WsvMap.find(names[i]);
+      if (it == Workspace::WsvMap.end())
+        {
+          Workspace::add_wsv(WsvRecord(names[i].c_str(),
+                                       "Restored from workspace snapshot.",
+                                       group));
+        }
+      else if (Workspace::wsv_data[it->second].Group() != group)
+        {
+          ostringstream os;
+          os << "Variable " << names[i] << " is of group "
+             << groups[i] << " in the snapshot, but of group "
+             << wsv_group_names[Workspace::wsv_data[it->second].Group()]
+             << " in the workspace.";
+          throw runtime_error(os.str());
+        }
+    }
+
+  ws.initialize();
+
+  const Index agenda_group = get_wsv_group_id("Agenda");
+  const Index agenda_array_group = get_wsv_group_id("ArrayOfAgenda");
+  for (Index i = 0; i < nelem; i++)
+    {
+      map<String, Index>::const_iterator it = Workspace::WsvMap.find(stored[i]);
+      if (it == Workspace::WsvMap.end())
+        xml_parse_error("Stored variable is not in the variable directory: "
+                        + stored[i]);
+
+      const Index group = Workspace::wsv_data[it->second].Group();
+      void* vp = ws[it->second];
+
+      try
+        {
+          xml_read_wsv_from_stream(is_xml, group, vp, pbifs, verbosity);
+
+          if (group == agenda_group)
+            ((Agenda*)vp)->check(ws, verbosity);
+          else if (group == agenda_array_group)
+            {
+              ArrayOfAgenda& aa = *(ArrayOfAgenda*)vp;
+              for (Index j = 0; j < aa.nelem(); j++)
+                aa[j].check(ws, verbosity);
+            }
+        }
+      catch (const std::runtime_error &e)
+        {
+          ostringstream os;
+          os << "Error reading variable " << stored[i] << ":\n"
+             << e.what();
+          throw runtime_error(os.str());
+        }
+    }
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("/WorkspaceSnapshot");
+
+  return nelem;
+}
+
+
+//! Restores a workspace snapshot
+/*!
+  Variables which are not yet known are added to the workspace, so this
+  function can be called before the controlfile is parsed. Variables that
+  already exist are overwritten. Predefined agendas are checked for
+  consistency after reading.
+
+  \param[in,out] ws         Workspace
+  \param[in]     filename   Name of the snapshot file
+  \param[in]     verbosity  Verbosity
+*/
+void read_workspace_snapshot(Workspace& ws,
+                             const String& filename,
+                             const Verbosity& verbosity)
+{
+  CREATE_OUT2;
+
+  String xml_file = filename;
+  find_xml_file(xml_file, verbosity);
+  out2 << "  Reading workspace snapshot " << xml_file << '\n';
+
+  ifstream ifs;
+  xml_open_input_file(ifs, xml_file, verbosity);
+
+  try
+    {
+      FileType ftype;
+      NumericType ntype;
+      EndianType etype;
+      Index nelem;
+
+      xml_read_header_from_stream(ifs, ftype, ntype, etype, verbosity);
+      if (ftype == FILE_TYPE_ASCII)
+        {
+          nelem = read_snapshot_variables(ws, ifs, NULL, verbosity);
+        }
+      else
+        {
+          String bfilename = xml_file + ".bin";
+          bifstream bifs(bfilename.c_str());
+          nelem = read_snapshot_variables(ws, ifs, &bifs, verbosity);
+        }
+      xml_read_footer_from_stream(ifs, verbosity);
+
+      out2 << "  Restored " << nelem << " workspace variables.\n";
+    }
+  catch (const std::runtime_error &e)
+    {
+      ostringstream os;
+      os << "Error reading workspace snapshot: " << xml_file << '\n'
+         << e.what();
+      throw runtime_error(os.str());
+    }
+}
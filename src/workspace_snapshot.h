@@ -0,0 +1,57 @@
+/* Copyright (C) 2018
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   workspace_snapshot.h
+
+  \brief  Saving and restoring the state of a workspace.
+
+  A workspace snapshot contains all initialized workspace variables,
+  including agendas and variables created in the controlfile. It is
+  written as a binary XML file (plus the accompanying .bin file):
+
+  \verbatim
+  <WorkspaceSnapshot nelem="n">
+    <Array type="String" name="variables"> all variables </Array>
+    <Array type="String" name="groups">    their groups  </Array>
+    <Array type="String" name="stored">    n variables   </Array>
+    values of the n stored variables
+  </WorkspaceSnapshot>
+  \endverbatim
+
+  Restoring a snapshot before the controlfile is parsed makes the
+  variables created in the snapshot known to the parser, so a run can
+  start directly from a fully set up workspace.
+*/
+
+#ifndef workspace_snapshot_h
+#define workspace_snapshot_h
+
+#include "messages.h"
+#include "mystring.h"
+#include "workspace_ng.h"
+
+
+void write_workspace_snapshot(const String& filename,
+                              Workspace& ws,
+                              const Verbosity& verbosity);
+
+void read_workspace_snapshot(Workspace& ws,
+                             const String& filename,
+                             const Verbosity& verbosity);
+
+#endif /* workspace_snapshot_h */
@@ -28,7 +28,11 @@
 
 */
 
+#include <algorithm>
+#include <locale>
+#include <vector>
 #include "arts.h"
+#include "arts_omp.h"
 #include "xml_io.h"
 #include "xml_io_private.h"
 #include "xml_io_types.h"
@@ -838,6 +842,311 @@ void parse_xml_tag_content_as_string(std::istream& is_xml, String& content)
 }
 
 
+//! Convert a plain decimal number without going through the C library
+/*!
+  Handles numbers of the form [+-]digits[.digits][(e|E)[+-]digits] whose
+  significand fits into 53 bits and whose decimal exponent is at most 22
+  in magnitude. For these the result is exactly rounded after a single
+  multiplication or division. All other input is rejected.
+
+  \param p    Start of the token
+  \param end  End of the token
+  \param x    Parsed value
+  \return     True if the token was converted
+*/
+static bool parse_plain_numeric(const char* p, const char* end, Numeric& x)
+{
+  static const double pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                  1e18, 1e19, 1e20, 1e21, 1e22 };
+
+  bool neg = false;
+  if (p < end && (*p == '-' || *p == '+'))
+    neg = (*p++ == '-');
+
+  unsigned long long mant = 0;
+  int ndigits = 0;
+  int exp10 = 0;
+  bool have_digits = false;
+
+  for (; p < end && *p >= '0' && *p <= '9'; p++)
+    {
+      have_digits = true;
+      if (ndigits == 19) return false;
+      mant = mant * 10 + (unsigned long long)(*p - '0');
+      if (mant) ndigits++;
+    }
+
+  if (p < end && *p == '.')
+    for (p++; p < end && *p >= '0' && *p <= '9'; p++)
+      {
+        have_digits = true;
+        if (ndigits == 19) return false;
+        mant = mant * 10 + (unsigned long long)(*p - '0');
+        if (mant) ndigits++;
+        exp10--;
+      }
+
+  if (!have_digits) return false;
+
+  if (p < end && (*p == 'e' || *p == 'E'))
+    {
+      p++;
+      bool eneg = false;
+      if (p < end && (*p == '-' || *p == '+'))
+        eneg = (*p++ == '-');
+      if (p == end) return false;
+      int e = 0;
+      for (; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+          if (e > 10000) return false;
+          e = e * 10 + (*p - '0');
+        }
+      exp10 += eneg ? -e : e;
+    }
+
+  if (p != end) return false;
+
+  if (mant > (1ULL << 53)) return false;
+
+  if (mant == 0)
+    x = 0.;
+  else if (exp10 >= 0 && exp10 <= 22)
+    x = (double)mant * pow10[exp10];
+  else if (exp10 < 0 && exp10 >= -22)
+    x = (double)mant / pow10[-exp10];
+  else
+    return false;
+
+  if (neg) x = -x;
+  return true;
+}
+
+
+//! Parse whitespace separated numbers from a text block
+/*!
+  Tokens that are not handled by parse_plain_numeric (many significant
+  digits, large exponents, NaN, Inf) are converted with double_imanip,
+  from a stream using the classic locale. This gives the same result as
+  the element by element reading, independent of the global C locale.
+
+  \param begin  Start of the text
+  \param end    End of the text
+  \param data   Output buffer, must hold all tokens of the block
+  \return       Number of tokens parsed, or -(index+1) of the first
+                token that could not be converted
+*/
+static Index parse_numeric_block(const char* begin, const char* end,
+                                 Numeric* data)
+{
+  Index n = 0;
+  const char* p = begin;
+  istringstream is;
+  is.imbue(std::locale::classic());
+
+  while (true)
+    {
+      while (p < end && isspace((unsigned char)*p)) p++;
+      if (p == end) break;
+
+      const char* q = p;
+      while (q < end && !isspace((unsigned char)*q)) q++;
+
+      if (!parse_plain_numeric(p, q, data[n]))
+        {
+          char c;
+          is.clear();
+          is.str(std::string(p, q));
+          is >> double_imanip() >> data[n];
+          if (is.fail() || is >> c)
+            return -(n + 1);
+        }
+      n++;
+      p = q;
+    }
+
+  return n;
+}
+
+
+//! Count whitespace separated tokens in a text block
+static Index count_tokens(const char* p, const char* end)
+{
+  Index n = 0;
+  bool in_token = false;
+  for (; p < end; p++)
+    {
+      if (isspace((unsigned char)*p))
+        in_token = false;
+      else if (!in_token)
+        {
+          in_token = true;
+          n++;
+        }
+    }
+  return n;
+}
+
+
+//! Read numeric tag content from an ASCII XML stream
+/*!
+  Fast replacement for reading the data of matpack types element by
+  element with double_imanip. The stream content up to the next '<' is
+  read in large blocks directly from the stream buffer, bypassing the
+  formatted input machinery, and each block is split at whitespace and
+  converted in parallel.
+
+  Exactly n values are expected before the closing tag.
+
+  \param is_xml  XML input stream
+  \param data    Output buffer of n elements
+  \param n       Number of values to read
+  \param tag     Currently parsed tag, for error messages
+*/
+void xml_parse_numeric_array(istream&    is_xml,
+                             Numeric*    data,
+                             Index       n,
+                             ArtsXMLTag& tag)
+{
+  xml_parse_numeric_array(is_xml, data, n, 0, n, tag);
+}
+
+
+//! Read a contiguous part of numeric tag content from an ASCII XML stream
+/*!
+  As above, but only the values [first, first+count) of the n values in
+  the stream are stored. All values are still checked, but the memory
+  needed beyond the output is limited to one text block.
+
+  \param is_xml  XML input stream
+  \param data    Output buffer of count elements
+  \param n       Number of values in the stream
+  \param first   Index of the first value to store
+  \param count   Number of values to store
+  \param tag     Currently parsed tag, for error messages
+*/
+void xml_parse_numeric_array(istream&    is_xml,
+                             Numeric*    data,
+                             Index       n,
+                             Index       first,
+                             Index       count,
+                             ArtsXMLTag& tag)
+{
+  // Size of a text block, and smallest chunk handed to a thread
+  const size_t block_size = 1 << 24;
+  const size_t min_chunk_size = 1 << 16;
+
+  if (n <= 0) return;
+
+  streambuf* sb = is_xml.rdbuf();
+  String buf;
+  std::vector<Numeric> tmp;
+  const bool all = (first == 0 && count == n);
+  Index pos = 0;
+  bool end_of_data = false;
+
+  buf.reserve(block_size);
+
+  while (pos < n && !end_of_data)
+    {
+      buf.clear();
+      int c;
+      while (true)
+        {
+          c = sb->sgetc();
+          if (c == EOF || c == '<')
+            {
+              end_of_data = true;
+              break;
+            }
+          if (buf.length() >= block_size && isspace(c)) break;
+          buf.push_back((char)c);
+          sb->sbumpc();
+        }
+      if (c == EOF) is_xml.setstate(ios::eofbit);
+
+      // Split block into chunks at whitespace
+      const char* text = buf.data();
+      const size_t len = buf.length();
+      Index nchunks = min((Index)arts_omp_get_max_threads(),
+                          (Index)(len / min_chunk_size) + 1);
+      if (arts_omp_in_parallel()) nchunks = 1;
+
+      ArrayOfIndex chunk_start(nchunks + 1);
+      chunk_start[0] = 0;
+      for (Index i = 1; i < nchunks; i++)
+        {
+          size_t s = max((size_t)chunk_start[i-1], len / nchunks * i);
+          while (s < len && !isspace((unsigned char)text[s])) s++;
+          chunk_start[i] = (Index)s;
+        }
+      chunk_start[nchunks] = (Index)len;
+
+      ArrayOfIndex chunk_offset(nchunks + 1);
+      chunk_offset[0] = pos;
+      for (Index i = 0; i < nchunks; i++)
+        chunk_offset[i+1] = chunk_offset[i]
+          + count_tokens(text + chunk_start[i], text + chunk_start[i+1]);
+
+      if (chunk_offset[nchunks] > n)
+        {
+          ostringstream os;
+          os << " near "
+             << "\n  Element: " << n
+             << "\nFound more values than expected.";
+          xml_data_parse_error(tag, os.str());
+        }
+
+      // Values outside the stored part are parsed into a temporary buffer
+      Numeric* block_data = data;
+      Index block_offset = 0;
+      if (!all)
+        {
+          tmp.resize(chunk_offset[nchunks] - pos);
+          block_data = tmp.data();
+          block_offset = pos;
+        }
+
+      ArrayOfIndex chunk_status(nchunks);
+#pragma omp parallel for if (nchunks > 1)
+      for (Index i = 0; i < nchunks; i++)
+        chunk_status[i] = parse_numeric_block(text + chunk_start[i],
+                                              text + chunk_start[i+1],
+                                              block_data + chunk_offset[i]
+                                              - block_offset);
+
+      for (Index i = 0; i < nchunks; i++)
+        if (chunk_status[i] < 0)
+          {
+            ostringstream os;
+            os << " near "
+               << "\n  Element: " << chunk_offset[i] - chunk_status[i] - 1;
+            xml_data_parse_error(tag, os.str());
+          }
+
+      if (!all)
+        {
+          const Index b = max(pos, first);
+          const Index e = min(chunk_offset[nchunks], first + count);
+          if (b < e)
+            std::copy(tmp.begin() + (b - pos), tmp.begin() + (e - pos),
+                      data + (b - first));
+        }
+
+      pos = chunk_offset[nchunks];
+    }
+
+  if (pos < n)
+    {
+      ostringstream os;
+      os << " near "
+         << "\n  Element: " << pos;
+      xml_data_parse_error(tag, os.str());
+    }
+}
+
+
 
 ////////////////////////////////////////////////////////////////////////////
 //   Generic IO routines for XML files
@@ -921,11 +1230,22 @@ void xml_read_from_file(const String&    filename,
 }
 
 
-void xml_read_arts_catalogue_from_file(const String&      filename,
-                                       ArrayOfLineRecord& type,
-                                       const Numeric&     fmin,
-                                       const Numeric&     fmax,
-                                       const Verbosity&   verbosity)
+//! Reads data within a frequency range from XML file
+/*!
+  Same as xml_read_from_file, for types with a reader that only keeps
+  data in the frequency range [fmin, fmax].
+
+  \param filename  XML filename
+  \param type      Generic return value
+  \param fmin      Lower frequency limit
+  \param fmax      Upper frequency limit
+*/
+template<typename T>
+static void xml_read_from_file_in_f_range(const String&      filename,
+                                          T&                 type,
+                                          const Numeric&     fmin,
+                                          const Numeric&     fmax,
+                                          const Verbosity&   verbosity)
 {
   CREATE_OUT2;
   
@@ -992,6 +1312,36 @@ void xml_read_arts_catalogue_from_file(const String&      filename,
 }
 
 
+void xml_read_arts_catalogue_from_file(const String&      filename,
+                                       ArrayOfLineRecord& type,
+                                       const Numeric&     fmin,
+                                       const Numeric&     fmax,
+                                       const Verbosity&   verbosity)
+{
+  xml_read_from_file_in_f_range(filename, type, fmin, fmax, verbosity);
+}
+
+
+//! Reads SingleScatteringData from XML file, keeping only needed frequencies
+/*!
+  Frequencies of the data that are not needed to interpolate to
+  [fmin, fmax] are skipped while reading.
+
+  \param filename  XML filename
+  \param ssd       SingleScatteringData return value
+  \param fmin      Lower frequency limit
+  \param fmax      Upper frequency limit
+*/
+void xml_read_single_scattering_data_from_file(const String&         filename,
+                                               SingleScatteringData& ssd,
+                                               const Numeric&        fmin,
+                                               const Numeric&        fmax,
+                                               const Verbosity&      verbosity)
+{
+  xml_read_from_file_in_f_range(filename, ssd, fmin, fmax, verbosity);
+}
+
+
 //! Write data to XML file
 /*!
   This is a generic functions that is used to write the XML header and
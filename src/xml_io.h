@@ -35,6 +35,8 @@
 #include "mystring.h"
 #include "absorption.h"
 
+struct SingleScatteringData;
+
 enum FileType{
   FILE_TYPE_ASCII        = 0,
   FILE_TYPE_ZIPPED_ASCII = 1,
@@ -72,6 +74,12 @@ void xml_read_arts_catalogue_from_file(const String&      filename,
                                        const Numeric&     fmax,
                                        const Verbosity&   verbosity);
 
+void xml_read_single_scattering_data_from_file(const String&         filename,
+                                               SingleScatteringData& ssd,
+                                               const Numeric&        fmin,
+                                               const Numeric&        fmax,
+                                               const Verbosity&      verbosity);
+
 template<typename T>
 void xml_write_to_file(const String&    filename,
                        const T&         type,
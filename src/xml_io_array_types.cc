@@ -32,6 +32,7 @@
 #include "xml_io_private.h"
 #include "xml_io_types.h"
 #include "jacobian.h"
+#include "linecatalogue.h"
 
 
 ////////////////////////////////////////////////////////////////////////////
@@ -46,12 +47,38 @@
   \param aa       ArrayOfAgenda return value
   \param pbifs    Pointer to binary input stream. NULL in case of ASCII file.
 */
-void xml_read_from_stream(istream& is_xml   _U_,
-                          ArrayOfAgenda& aa _U_,
-                          bifstream* pbifs  _U_,
-                          const             Verbosity&)
+void xml_read_from_stream(istream&         is_xml,
+                          ArrayOfAgenda&   aa,
+                          bifstream*       pbifs,
+                          const Verbosity& verbosity)
 {
-  throw runtime_error("Not supported.");
+  ArtsXMLTag tag(verbosity);
+  Index nelem;
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("Array");
+  tag.check_attribute("type", "Agenda");
+
+  tag.get_attribute_value("nelem", nelem);
+  aa.resize(nelem);
+
+  Index n;
+  try
+    {
+      for (n = 0; n < nelem; n++)
+        xml_read_from_stream(is_xml, aa[n], pbifs, verbosity);
+    }
+  catch (const std::runtime_error &e)
+    {
+      ostringstream os;
+      os << "Error reading ArrayOfAgenda: "
+         << "\n Element: " << n
+         << "\n" << e.what();
+      throw runtime_error(os.str());
+    }
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("/Array");
 }
 
 
@@ -62,14 +89,33 @@ void xml_read_from_stream(istream& is_xml   _U_,
   \param pbofs    Pointer to binary file stream. NULL for ASCII output.
   \param name     Optional name attribute
 */
-void xml_write_to_stream(ostream& os_xml         _U_,
-                         const ArrayOfAgenda& aa _U_,
-                         bofstream* pbofs        _U_,
-                         const String&  name     _U_,
-                         const                   Verbosity&)
+void xml_write_to_stream(ostream&             os_xml,
+                         const ArrayOfAgenda& aa,
+                         bofstream*           pbofs,
+                         const String&        name,
+                         const Verbosity&     verbosity)
 
 {
-  throw runtime_error("ArrayOfAgendas can't be saved.");
+  ArtsXMLTag open_tag(verbosity);
+  ArtsXMLTag close_tag(verbosity);
+
+  open_tag.set_name("Array");
+  if (name.length())
+    open_tag.add_attribute("name", name);
+
+  open_tag.add_attribute("type", "Agenda");
+  open_tag.add_attribute("nelem", aa.nelem());
+
+  open_tag.write_to_stream(os_xml);
+  os_xml << '\n';
+
+  for (Index n = 0; n < aa.nelem(); n++)
+    xml_write_to_stream(os_xml, aa[n], pbofs, "", verbosity);
+
+  close_tag.set_name("/Array");
+  close_tag.write_to_stream(os_xml);
+
+  os_xml << '\n';
 }
 
 
@@ -2865,47 +2911,53 @@ void xml_read_from_stream(istream&           is_xml,
       throw runtime_error(os.str());
     }
 
-  alrecord.resize(0);
+  LineRecordReader read_record;
+  switch (artscat_version)
+    {
+    case 3:
+      read_record = [&verbosity](LineRecord& lr, istream& is) {
+        return lr.ReadFromArtscat3Stream(is, verbosity); };
+      break;
+    case 4:
+      read_record = [&verbosity](LineRecord& lr, istream& is) {
+        return lr.ReadFromArtscat4Stream(is, verbosity); };
+      break;
+    case 5:
+      read_record = [&verbosity](LineRecord& lr, istream& is) {
+        return lr.ReadFromArtscat5Stream(is, verbosity); };
+      break;
+    default:
+      throw runtime_error("Programmer error. This should never be reached.\n"
+                          "Fix version number check above!");
+      break;
+    }
 
-  Index n;
+  Index n = 0;
   try
     {
-      for (n = 0; n < nelem; n++)
-        {
-          LineRecord lr;
-          switch (artscat_version)
-            {
-            case 3:
-              if (lr.ReadFromArtscat3Stream(is_xml, verbosity))
-                throw runtime_error("Cannot read line from file");
-              break;
-            case 4:
-              if (lr.ReadFromArtscat4Stream(is_xml, verbosity))
-                throw runtime_error("Cannot read line from file");
-              break;
-            case 5:
-              if (lr.ReadFromArtscat5Stream(is_xml, verbosity))
-                throw runtime_error("Cannot read line from file");
-              break;
-            default:
-              throw runtime_error("Programmer error. This should never be reached.\n"
-                                  "Fix version number check above!");
-              break;
-            }
-
-          if ((isnan(fmin) || fmin <= lr.F()) && (isnan(fmax) || lr.F() <= fmax))
-            alrecord.push_back(std::move(lr));
-        }
+      read_line_records_parallel(alrecord, n, is_xml, read_record,
+                                 isnan(fmin) ? -INFINITY : fmin,
+                                 isnan(fmax) ? INFINITY : fmax,
+                                 false, true);
     }
   catch (const std::runtime_error &e)
     {
       ostringstream os;
       os << "Error reading ArrayOfLineRecord: "
-         << "\n Element: " << n
          << "\n" << e.what();
       throw runtime_error(os.str());
     }
 
+  if (n != nelem)
+    {
+      ostringstream os;
+      os << "Error reading ArrayOfLineRecord: "
+         << "\n Element: " << min(n, nelem)
+         << "\n" << (n < nelem ? "Cannot read line from file"
+                              : "More lines than given by nelem");
+      throw runtime_error(os.str());
+    }
+
   out2 << "  Read " << alrecord.nelem() << " out of " << nelem << " lines.\n";
 
   tag.read_from_stream(is_xml);
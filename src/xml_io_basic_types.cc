@@ -135,36 +135,14 @@ void xml_read_from_stream(istream&         is_xml,
   tag.get_attribute_value("ncols", ncols);
   matrix.resize(nrows, ncols);
 
-  for (Index r = 0; r < nrows; r++)
+  if (pbifs)
     {
-      for (Index c = 0; c < ncols; c++)
-        {
-          if (pbifs)
-            {
-              *pbifs >> matrix(r, c);
-              if (pbifs->fail())
-                {
-                  ostringstream os;
-                  os << " near "
-                     << "\n  Row   : " << r
-                     << "\n  Column: " << c;
-                  xml_data_parse_error(tag, os.str());
-                }
-            }
-          else
-            {
-              is_xml >> double_imanip() >> matrix(r, c);
-              if (is_xml.fail())
-                {
-                  ostringstream os;
-                  os << " near "
-                     << "\n  Row   : " << r
-                     << "\n  Column: " << c;
-                  xml_data_parse_error(tag, os.str());
-                }
-            }
-        }
+      pbifs->readDoubleArray(matrix.get_c_array(), nrows * ncols);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    xml_parse_numeric_array(is_xml, matrix.get_c_array(), nrows * ncols, tag);
 
   tag.read_from_stream(is_xml);
   tag.check_name("/Matrix");
@@ -199,23 +177,22 @@ void xml_write_to_stream(ostream&         os_xml,
   xml_set_stream_precision(os_xml);
 
   // Write the elements:
-  for (Index r = 0; r < matrix.nrows(); ++r)
+  if (pbofs)
+    pbofs->writeDoubleArray(matrix.get_c_array(),
+                            matrix.nrows() * matrix.ncols());
+  else
     {
-      if (pbofs)
-        *pbofs << matrix(r, 0);
-      else
-        os_xml << matrix(r, 0);
-
-      for (Index c = 1; c < matrix.ncols(); ++c)
+      for (Index r = 0; r < matrix.nrows(); ++r)
         {
-          if (pbofs)
-            *pbofs << matrix(r, c);
-          else
-            os_xml << " " << matrix(r, c);
-        }
+          os_xml << matrix(r, 0);
 
-      if (!pbofs)
-        os_xml << '\n';
+          for (Index c = 1; c < matrix.ncols(); ++c)
+            {
+              os_xml << " " << matrix(r, c);
+            }
+
+          os_xml << '\n';
+        }
     }
 
   close_tag.set_name("/Matrix");
@@ -403,81 +380,69 @@ void xml_read_from_stream(istream&         is_xml,
   ArrayOfIndex rowind(nnz), colind(nnz);
   Vector data(nnz);
 
-  for (Index i = 0; i < nnz; i++)
+  if (pbifs)
     {
-      if (pbifs) {
-          *pbifs >> rowind[i];
-          if (pbifs->fail()) {
-              ostringstream os;
-              os << " near "
-                 << "\n  Row index: " << i;
-              xml_data_parse_error(tag, os.str());
-            }
-        }
-      else {
-          is_xml >> rowind[i];
-          if (is_xml.fail()) {
-              ostringstream os;
-              os << " near "
-                 << "\n  Row index: " << i;
-              xml_data_parse_error(tag, os.str());
-            }
-        }
+      pbifs->readIntArray(rowind.data(), nnz);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    for (Index i = 0; i < nnz; i++)
+      {
+        is_xml >> rowind[i];
+        if (is_xml.fail()) {
+            ostringstream os;
+            os << " near "
+               << "\n  Row index: " << i;
+            xml_data_parse_error(tag, os.str());
+          }
+      }
   tag.read_from_stream(is_xml);
   tag.check_name("/RowIndex");
 
   tag.read_from_stream(is_xml);
   tag.check_name("ColIndex");
 
-  for (Index i = 0; i < nnz; i++)
+  if (pbifs)
     {
-      if (pbifs) {
-          *pbifs >> colind[i];
-          if (pbifs->fail()) {
-              ostringstream os;
-              os << " near "
-                 << "\n  Column index: " << i;
-              xml_data_parse_error(tag, os.str());
-            }
-        }
-      else {
-          is_xml >> colind[i];
-          if (is_xml.fail()) {
-              ostringstream os;
-              os << " near "
-                 << "\n  Column index: " << i;
-              xml_data_parse_error(tag, os.str());
-            }
-        }
+      pbifs->readIntArray(colind.data(), nnz);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    for (Index i = 0; i < nnz; i++)
+      {
+        is_xml >> colind[i];
+        if (is_xml.fail()) {
+            ostringstream os;
+            os << " near "
+               << "\n  Column index: " << i;
+            xml_data_parse_error(tag, os.str());
+          }
+      }
   tag.read_from_stream(is_xml);
   tag.check_name("/ColIndex");
 
   tag.read_from_stream(is_xml);
   tag.check_name("SparseData");
 
-  for (Index i = 0; i < nnz; i++)
+  if (pbifs)
     {
-      if (pbifs) {
-          *pbifs >> data[i];
-          if (pbifs->fail()) {
-              ostringstream os;
-              os << " near "
-                 << "\n  Data element: " << i;
-              xml_data_parse_error(tag, os.str());
-            }
-        }
-      else {
-          is_xml >> double_imanip() >> data[i];
-          if (is_xml.fail()) {
-              ostringstream os;
-              os << " near "
-                 << "\n  Data element: " << i;
-              xml_data_parse_error(tag, os.str());
-            }
-        }
+      pbifs->readDoubleArray(data.get_c_array(), nnz);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    for (Index i = 0; i < nnz; i++)
+      {
+        is_xml >> double_imanip() >> data[i];
+        if (is_xml.fail()) {
+            ostringstream os;
+            os << " near "
+               << "\n  Data element: " << i;
+            xml_data_parse_error(tag, os.str());
+          }
+      }
   tag.read_from_stream(is_xml);
   tag.check_name("/SparseData");
 
@@ -531,14 +496,11 @@ void xml_write_to_stream(ostream&         os_xml,
 
   // Write row indices.
 
-  for (Index i = 0; i < sparse.nnz(); i++)
-  {
-      if (pbofs)
-        //FIXME: It should be the longer lines
-          *pbofs << rowind[i];
-      else
-          os_xml << rowind[i] << '\n';
-  }
+  if (pbofs)
+    pbofs->writeIntArray(rowind.data(), sparse.nnz());
+  else
+    for (Index i = 0; i < sparse.nnz(); i++)
+      os_xml << rowind[i] << '\n';
 
   close_tag.set_name("/RowIndex");
   close_tag.write_to_stream(os_xml);
@@ -549,14 +511,11 @@ void xml_write_to_stream(ostream&         os_xml,
 
   // Write column indices.
 
-  for (Index i = 0; i < sparse.nnz(); i++)
-  {
-      if (pbofs)
-        //FIXME: It should be the longer lines
-          *pbofs << colind[i];
-      else
-          os_xml << colind[i] << '\n';
-  }
+  if (pbofs)
+    pbofs->writeIntArray(colind.data(), sparse.nnz());
+  else
+    for (Index i = 0; i < sparse.nnz(); i++)
+      os_xml << colind[i] << '\n';
 
 
   close_tag.set_name("/ColIndex");
@@ -569,13 +528,11 @@ void xml_write_to_stream(ostream&         os_xml,
 
   // Write data.
 
-  for (Index i = 0; i < sparse.nnz(); i++)
-  {
-      if (pbofs)
-          *pbofs << data[i];
-      else
-          os_xml << data[i] << ' ';
-  }
+  if (pbofs)
+    pbofs->writeDoubleArray(data.get_c_array(), sparse.nnz());
+  else
+    for (Index i = 0; i < sparse.nnz(); i++)
+      os_xml << data[i] << ' ';
   os_xml << '\n';
   close_tag.set_name("/SparseData");
   close_tag.write_to_stream(os_xml);
@@ -712,41 +669,15 @@ void xml_read_from_stream(istream&         is_xml,
   tag.get_attribute_value("ncols", ncols);
   tensor.resize(npages, nrows, ncols);
 
-  for (Index p = 0; p < npages; p++)
+  if (pbifs)
     {
-      for (Index r = 0; r < nrows; r++)
-        {
-          for (Index c = 0; c < ncols; c++)
-            {
-              if (pbifs)
-                {
-                  *pbifs >> tensor(p, r, c);
-                  if (pbifs->fail())
-                    {
-                      ostringstream os;
-                      os << " near "
-                         << "\n  Page  : " << p
-                         << "\n  Row   : " << r
-                         << "\n  Column: " << c;
-                      xml_data_parse_error(tag, os.str());
-                    }
-                }
-              else
-                {
-                  is_xml >> double_imanip() >> tensor(p, r, c);
-                  if (is_xml.fail())
-                    {
-                      ostringstream os;
-                      os << " near "
-                         << "\n  Page  : " << p
-                         << "\n  Row   : " << r
-                         << "\n  Column: " << c;
-                      xml_data_parse_error(tag, os.str());
-                    }
-                }
-            }
-        }
+      pbifs->readDoubleArray(tensor.get_c_array(), npages * nrows * ncols);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    xml_parse_numeric_array(is_xml, tensor.get_c_array(),
+                            npages * nrows * ncols, tag);
 
   tag.read_from_stream(is_xml);
   tag.check_name("/Tensor3");
@@ -782,23 +713,22 @@ void xml_write_to_stream(ostream&         os_xml,
   xml_set_stream_precision(os_xml);
 
   // Write the elements:
-  for (Index p = 0; p < tensor.npages(); ++p)
+  if (pbofs)
+    pbofs->writeDoubleArray(tensor.get_c_array(),
+                            tensor.npages() * tensor.nrows() * tensor.ncols());
+  else
     {
-      for (Index r = 0; r < tensor.nrows(); ++r)
+      for (Index p = 0; p < tensor.npages(); ++p)
         {
-          if (pbofs)
-            *pbofs << tensor(p, r, 0);
-          else
-            os_xml << tensor(p, r, 0);
-          for (Index c = 1; c < tensor.ncols(); ++c)
+          for (Index r = 0; r < tensor.nrows(); ++r)
             {
-              if (pbofs)
-                *pbofs << tensor(p, r, c);
-              else
-                os_xml << " " << tensor(p, r, c);
+              os_xml << tensor(p, r, 0);
+              for (Index c = 1; c < tensor.ncols(); ++c)
+                {
+                  os_xml << " " << tensor(p, r, c);
+                }
+              os_xml << '\n';
             }
-          if (!pbofs)
-            os_xml << '\n';
         }
     }
 
@@ -834,46 +764,16 @@ void xml_read_from_stream(istream&         is_xml,
   tag.get_attribute_value("ncols", ncols);
   tensor.resize(nbooks, npages, nrows, ncols);
 
-  for (Index b = 0; b < nbooks; b++)
+  if (pbifs)
     {
-      for (Index p = 0; p < npages; p++)
-        {
-          for (Index r = 0; r < nrows; r++)
-            {
-              for (Index c = 0; c < ncols; c++)
-                {
-                  if (pbifs)
-                    {
-                      *pbifs >> tensor(b, p, r, c);
-                      if (pbifs->fail())
-                        {
-                          ostringstream os;
-                          os << " near "
-                             << "\n  Book  : " << b
-                             << "\n  Page  : " << p
-                             << "\n  Row   : " << r
-                             << "\n  Column: " << c;
-                          xml_data_parse_error(tag, os.str());
-                        }
-                    }
-                  else
-                    {
-                      is_xml >> double_imanip() >> tensor(b, p, r, c);
-                      if (is_xml.fail())
-                        {
-                          ostringstream os;
-                          os << " near "
-                             << "\n  Book  : " << b
-                             << "\n  Page  : " << p
-                             << "\n  Row   : " << r
-                             << "\n  Column: " << c;
-                          xml_data_parse_error(tag, os.str());
-                        }
-                    }
-                }
-            }
-        }
+      pbifs->readDoubleArray(tensor.get_c_array(),
+                             nbooks * npages * nrows * ncols);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    xml_parse_numeric_array(is_xml, tensor.get_c_array(),
+                            nbooks * npages * nrows * ncols, tag);
 
   tag.read_from_stream(is_xml);
   tag.check_name("/Tensor4");
@@ -910,25 +810,25 @@ void xml_write_to_stream(ostream&         os_xml,
   xml_set_stream_precision(os_xml);
 
   // Write the elements:
-  for (Index b = 0; b < tensor.nbooks(); ++b)
+  if (pbofs)
+    pbofs->writeDoubleArray(tensor.get_c_array(),
+                            tensor.nbooks() * tensor.npages() *
+                            tensor.nrows() * tensor.ncols());
+  else
     {
-      for (Index p = 0; p < tensor.npages(); ++p)
+      for (Index b = 0; b < tensor.nbooks(); ++b)
         {
-          for (Index r = 0; r < tensor.nrows(); ++r)
+          for (Index p = 0; p < tensor.npages(); ++p)
             {
-              if (pbofs)
-                *pbofs << tensor(b, p, r, 0);
-              else
-                os_xml << tensor(b, p, r, 0);
-              for (Index c = 1; c < tensor.ncols(); ++c)
+              for (Index r = 0; r < tensor.nrows(); ++r)
                 {
-                  if (pbofs)
-                    *pbofs << tensor(b, p, r, c);
-                  else
-                    os_xml << " " << tensor(b, p, r, c);
+                  os_xml << tensor(b, p, r, 0);
+                  for (Index c = 1; c < tensor.ncols(); ++c)
+                    {
+                      os_xml << " " << tensor(b, p, r, c);
+                    }
+                  os_xml << '\n';
                 }
-              if (!pbofs)
-                os_xml << '\n';
             }
         }
     }
@@ -966,51 +866,101 @@ void xml_read_from_stream(istream&         is_xml,
   tag.get_attribute_value("ncols", ncols);
   tensor.resize(nshelves, nbooks, npages, nrows, ncols);
 
-  for (Index s = 0; s < nshelves; s++)
+  if (pbifs)
     {
-      for (Index b = 0; b < nbooks; b++)
-        {
-          for (Index p = 0; p < npages; p++)
-            {
-              for (Index r = 0; r < nrows; r++)
-                {
-                  for (Index c = 0; c < ncols; c++)
-                    {
-                      if (pbifs)
-                        {
-                          *pbifs >> tensor(s, b, p, r, c);
-                          if (pbifs->fail())
-                            {
-                              ostringstream os;
-                              os << " near "
-                                 << "\n  Shelf : " << s
-                                 << "\n  Book  : " << b
-                                 << "\n  Page  : " << p
-                                 << "\n  Row   : " << r
-                                 << "\n  Column: " << c;
-                              xml_data_parse_error(tag, os.str());
-                            }
-                        }
-                      else
-                        {
-                          is_xml >> double_imanip() >> tensor(s, b, p, r, c);
-                          if (is_xml.fail())
-                            {
-                              ostringstream os;
-                              os << " near "
-                                 << "\n  Shelf : " << s
-                                 << "\n  Book  : " << b
-                                 << "\n  Page  : " << p
-                                 << "\n  Row   : " << r
-                                 << "\n  Column: " << c;
-                              xml_data_parse_error(tag, os.str());
-                            }
-                        }
-                    }
-                }
-            }
-        }
+      pbifs->readDoubleArray(tensor.get_c_array(),
+                             nshelves * nbooks * npages * nrows * ncols);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
+    }
+  else
+    xml_parse_numeric_array(is_xml, tensor.get_c_array(),
+                            nshelves * nbooks * npages * nrows * ncols, tag);
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("/Tensor5");
+}
+
+
+//! Reads a range of the outermost dimension of a tensor
+/*!
+  Values outside the range are skipped in binary files, and parsed but not
+  stored in ASCII files.
+
+  \param is_xml  XML input stream
+  \param data    Output buffer of extent * slice values
+  \param ntotal  Size of the outermost dimension in the stream
+  \param slice   Number of values per index of the outermost dimension
+  \param offset  First index to read
+  \param extent  Number of indices to read
+  \param pbifs   Pointer to binary input stream. NULL in case of ASCII file.
+  \param tag     Currently parsed tag, for error messages
+*/
+static void xml_parse_leading_range(istream&    is_xml,
+                                    Numeric*    data,
+                                    Index       ntotal,
+                                    Index       slice,
+                                    Index       offset,
+                                    Index       extent,
+                                    bifstream*  pbifs,
+                                    ArtsXMLTag& tag)
+{
+  if (offset < 0 || extent < 0 || offset + extent > ntotal)
+    {
+      ostringstream os;
+      os << " (requested range " << offset << " to " << offset + extent
+         << " of " << ntotal << " elements of the outermost dimension)";
+      xml_data_parse_error(tag, os.str());
+    }
+
+  if (pbifs)
+    {
+      // Binary data are always stored as 8 byte IEEE doubles
+      pbifs->seek((long)(offset * slice * 8), binio::Add);
+      pbifs->readDoubleArray(data, extent * slice);
+      pbifs->seek((long)((ntotal - offset - extent) * slice * 8), binio::Add);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    xml_parse_numeric_array(is_xml, data, ntotal * slice, offset * slice,
+                            extent * slice, tag);
+}
+
+
+//! Reads a range of shelves of a Tensor5 from XML input stream
+/*!
+  \param is_xml    XML Input stream
+  \param tensor    Tensor return value, with extent shelves
+  \param nshelves  Number of shelves in the stream
+  \param offset    First shelf to read
+  \param extent    Number of shelves to read
+  \param pbifs     Pointer to binary input stream. NULL in case of ASCII file.
+*/
+void xml_read_leading_range_from_stream(istream&         is_xml,
+                                        Tensor5&         tensor,
+                                        Index&           nshelves,
+                                        const Index      offset,
+                                        const Index      extent,
+                                        bifstream*       pbifs,
+                                        const Verbosity& verbosity)
+{
+  ArtsXMLTag tag(verbosity);
+  Index nbooks, npages, nrows, ncols;
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("Tensor5");
+
+  tag.get_attribute_value("nshelves", nshelves);
+  tag.get_attribute_value("nbooks", nbooks);
+  tag.get_attribute_value("npages", npages);
+  tag.get_attribute_value("nrows", nrows);
+  tag.get_attribute_value("ncols", ncols);
+  tensor.resize(extent, nbooks, npages, nrows, ncols);
+
+  xml_parse_leading_range(is_xml, tensor.get_c_array(), nshelves,
+                          nbooks * npages * nrows * ncols, offset, extent,
+                          pbifs, tag);
 
   tag.read_from_stream(is_xml);
   tag.check_name("/Tensor5");
@@ -1048,27 +998,27 @@ void xml_write_to_stream(ostream&         os_xml,
   xml_set_stream_precision(os_xml);
 
   // Write the elements:
-  for (Index s = 0; s < tensor.nshelves(); ++s)
+  if (pbofs)
+    pbofs->writeDoubleArray(tensor.get_c_array(),
+                            tensor.nshelves() * tensor.nbooks() *
+                            tensor.npages() * tensor.nrows() * tensor.ncols());
+  else
     {
-      for (Index b = 0; b < tensor.nbooks(); ++b)
+      for (Index s = 0; s < tensor.nshelves(); ++s)
         {
-          for (Index p = 0; p < tensor.npages(); ++p)
+          for (Index b = 0; b < tensor.nbooks(); ++b)
             {
-              for (Index r = 0; r < tensor.nrows(); ++r)
+              for (Index p = 0; p < tensor.npages(); ++p)
                 {
-                  if (pbofs)
-                    *pbofs << tensor(s, b, p, r, 0);
-                  else
-                    os_xml << tensor(s, b, p, r, 0);
-                  for (Index c = 1; c < tensor.ncols(); ++c)
+                  for (Index r = 0; r < tensor.nrows(); ++r)
                     {
-                      if (pbofs)
-                        *pbofs << tensor(s, b, p, r, c);
-                      else
-                        os_xml << " " << tensor(s, b, p, r, c);
+                      os_xml << tensor(s, b, p, r, 0);
+                      for (Index c = 1; c < tensor.ncols(); ++c)
+                        {
+                          os_xml << " " << tensor(s, b, p, r, c);
+                        }
+                      os_xml << '\n';
                     }
-                  if (!pbofs)
-                    os_xml << '\n';
                 }
             }
         }
@@ -1108,56 +1058,18 @@ void xml_read_from_stream(istream&         is_xml,
   tag.get_attribute_value("ncols", ncols);
   tensor.resize(nvitrines, nshelves, nbooks, npages, nrows, ncols);
 
-  for (Index v = 0; v < nvitrines; v++)
+  if (pbifs)
     {
-      for (Index s = 0; s < nshelves; s++)
-        {
-          for (Index b = 0; b < nbooks; b++)
-            {
-              for (Index p = 0; p < npages; p++)
-                {
-                  for (Index r = 0; r < nrows; r++)
-                    {
-                      for (Index c = 0; c < ncols; c++)
-                        {
-                          if (pbifs)
-                            {
-                              *pbifs >> tensor(v, s, b, p, r, c);
-                              if (pbifs->fail())
-                                {
-                                  ostringstream os;
-                                  os << " near "
-                                     << "\n  Vitrine: " << v
-                                     << "\n  Shelf  : " << s
-                                     << "\n  Book   : " << b
-                                     << "\n  Page   : " << p
-                                     << "\n  Row    : " << r
-                                     << "\n  Column : " << c;
-                                  xml_data_parse_error(tag, os.str());
-                                }
-                            }
-                          else
-                            {
-                              is_xml >> double_imanip() >> tensor(v, s, b, p, r, c);
-                              if (is_xml.fail())
-                                {
-                                  ostringstream os;
-                                  os << " near "
-                                     << "\n  Vitrine: " << v
-                                     << "\n  Shelf  : " << s
-                                     << "\n  Book   : " << b
-                                     << "\n  Page   : " << p
-                                     << "\n  Row    : " << r
-                                     << "\n  Column : " << c;
-                                  xml_data_parse_error(tag, os.str());
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+      pbifs->readDoubleArray(tensor.get_c_array(),
+                             nvitrines * nshelves * nbooks * npages * nrows *
+                             ncols);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    xml_parse_numeric_array(is_xml, tensor.get_c_array(),
+                            nvitrines * nshelves * nbooks * npages * nrows *
+                            ncols, tag);
 
   tag.read_from_stream(is_xml);
   tag.check_name("/Tensor6");
@@ -1196,29 +1108,30 @@ void xml_write_to_stream(ostream&         os_xml,
   xml_set_stream_precision(os_xml);
 
   // Write the elements:
-  for (Index v = 0; v < tensor.nvitrines(); ++v)
+  if (pbofs)
+    pbofs->writeDoubleArray(tensor.get_c_array(),
+                            tensor.nvitrines() * tensor.nshelves() *
+                            tensor.nbooks() * tensor.npages() *
+                            tensor.nrows() * tensor.ncols());
+  else
     {
-      for (Index s = 0; s < tensor.nshelves(); ++s)
+      for (Index v = 0; v < tensor.nvitrines(); ++v)
         {
-          for (Index b = 0; b < tensor.nbooks(); ++b)
+          for (Index s = 0; s < tensor.nshelves(); ++s)
             {
-              for (Index p = 0; p < tensor.npages(); ++p)
+              for (Index b = 0; b < tensor.nbooks(); ++b)
                 {
-                  for (Index r = 0; r < tensor.nrows(); ++r)
+                  for (Index p = 0; p < tensor.npages(); ++p)
                     {
-                      if (pbofs)
-                        *pbofs << tensor(v, s, b, p, r, 0);
-                      else
-                        os_xml << tensor(v, s, b, p, r, 0);
-                      for (Index c = 1; c < tensor.ncols(); ++c)
+                      for (Index r = 0; r < tensor.nrows(); ++r)
                         {
-                          if (pbofs)
-                            *pbofs << tensor(v, s, b, p, r, c);
-                          else
-                            os_xml << " " << tensor(v, s, b, p, r, c);
+                          os_xml << tensor(v, s, b, p, r, 0);
+                          for (Index c = 1; c < tensor.ncols(); ++c)
+                            {
+                              os_xml << " " << tensor(v, s, b, p, r, c);
+                            }
+                          os_xml << '\n';
                         }
-                      if (!pbofs)
-                        os_xml << '\n';
                     }
                 }
             }
@@ -1260,61 +1173,59 @@ void xml_read_from_stream(istream&         is_xml,
   tag.get_attribute_value("ncols", ncols);
   tensor.resize(nlibraries, nvitrines, nshelves, nbooks, npages, nrows, ncols);
 
-  for (Index l = 0; l < nlibraries; l++)
+  if (pbifs)
     {
-      for (Index v = 0; v < nvitrines; v++)
-        {
-          for (Index s = 0; s < nshelves; s++)
-            {
-              for (Index b = 0; b < nbooks; b++)
-                {
-                  for (Index p = 0; p < npages; p++)
-                    {
-                      for (Index r = 0; r < nrows; r++)
-                        {
-                          for (Index c = 0; c < ncols; c++)
-                            {
-                              if (pbifs)
-                                {
-                                  *pbifs >> tensor(l, v, s, b, p, r, c);
-                                  if (pbifs->fail())
-                                    {
-                                      ostringstream os;
-                                      os << " near "
-                                         << "\n  Library: " << l
-                                         << "\n  Vitrine: " << v
-                                         << "\n  Shelf  : " << s
-                                         << "\n  Book   : " << b
-                                         << "\n  Page   : " << p
-                                         << "\n  Row    : " << r
-                                         << "\n  Column : " << c;
-                                      xml_data_parse_error(tag, os.str());
-                                    }
-                                }
-                              else
-                                {
-                                  is_xml >> double_imanip() >> tensor(l, v, s, b, p, r, c);
-                                  if (is_xml.fail())
-                                    {
-                                      ostringstream os;
-                                      os << " near "
-                                         << "\n  Library: " << l
-                                         << "\n  Vitrine: " << v
-                                         << "\n  Shelf  : " << s
-                                         << "\n  Book   : " << b
-                                         << "\n  Page   : " << p
-                                         << "\n  Row    : " << r
-                                         << "\n  Column : " << c;
-                                      xml_data_parse_error(tag, os.str());
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+      pbifs->readDoubleArray(tensor.get_c_array(),
+                             nlibraries * nvitrines * nshelves * nbooks *
+                             npages * nrows * ncols);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    xml_parse_numeric_array(is_xml, tensor.get_c_array(),
+                            nlibraries * nvitrines * nshelves * nbooks *
+                            npages * nrows * ncols, tag);
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("/Tensor7");
+}
+
+
+//! Reads a range of libraries of a Tensor7 from XML input stream
+/*!
+  \param is_xml      XML Input stream
+  \param tensor      Tensor return value, with extent libraries
+  \param nlibraries  Number of libraries in the stream
+  \param offset      First library to read
+  \param extent      Number of libraries to read
+  \param pbifs       Pointer to binary input stream. NULL in case of ASCII file.
+*/
+void xml_read_leading_range_from_stream(istream&         is_xml,
+                                        Tensor7&         tensor,
+                                        Index&           nlibraries,
+                                        const Index      offset,
+                                        const Index      extent,
+                                        bifstream*       pbifs,
+                                        const Verbosity& verbosity)
+{
+  ArtsXMLTag tag(verbosity);
+  Index nvitrines, nshelves, nbooks, npages, nrows, ncols;
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("Tensor7");
+
+  tag.get_attribute_value("nlibraries", nlibraries);
+  tag.get_attribute_value("nvitrines", nvitrines);
+  tag.get_attribute_value("nshelves", nshelves);
+  tag.get_attribute_value("nbooks", nbooks);
+  tag.get_attribute_value("npages", npages);
+  tag.get_attribute_value("nrows", nrows);
+  tag.get_attribute_value("ncols", ncols);
+  tensor.resize(extent, nvitrines, nshelves, nbooks, npages, nrows, ncols);
+
+  xml_parse_leading_range(is_xml, tensor.get_c_array(), nlibraries,
+                          nvitrines * nshelves * nbooks * npages * nrows
+                          * ncols, offset, extent, pbifs, tag);
 
   tag.read_from_stream(is_xml);
   tag.check_name("/Tensor7");
@@ -1354,31 +1265,32 @@ void xml_write_to_stream(ostream&         os_xml,
   xml_set_stream_precision(os_xml);
 
   // Write the elements:
-  for (Index l = 0; l < tensor.nlibraries(); ++l)
+  if (pbofs)
+    pbofs->writeDoubleArray(tensor.get_c_array(),
+                            tensor.nlibraries() * tensor.nvitrines() *
+                            tensor.nshelves() * tensor.nbooks() *
+                            tensor.npages() * tensor.nrows() * tensor.ncols());
+  else
     {
-      for (Index v = 0; v < tensor.nvitrines(); ++v)
+      for (Index l = 0; l < tensor.nlibraries(); ++l)
         {
-          for (Index s = 0; s < tensor.nshelves(); ++s)
+          for (Index v = 0; v < tensor.nvitrines(); ++v)
             {
-              for (Index b = 0; b < tensor.nbooks(); ++b)
+              for (Index s = 0; s < tensor.nshelves(); ++s)
                 {
-                  for (Index p = 0; p < tensor.npages(); ++p)
+                  for (Index b = 0; b < tensor.nbooks(); ++b)
                     {
-                      for (Index r = 0; r < tensor.nrows(); ++r)
+                      for (Index p = 0; p < tensor.npages(); ++p)
                         {
-                          if (pbofs)
-                            *pbofs << tensor(l, v, s, b, p, r, 0);
-                          else
-                            os_xml << tensor(l, v, s, b, p, r, 0);
-                          for (Index c = 1; c < tensor.ncols(); ++c)
+                          for (Index r = 0; r < tensor.nrows(); ++r)
                             {
-                              if (pbofs)
-                                *pbofs << tensor(l, v, s, b, p, r, c);
-                              else
-                                os_xml << " " << tensor(l, v, s, b, p, r, c);
+                              os_xml << tensor(l, v, s, b, p, r, 0);
+                              for (Index c = 1; c < tensor.ncols(); ++c)
+                                {
+                                  os_xml << " " << tensor(l, v, s, b, p, r, c);
+                                }
+                              os_xml << '\n';
                             }
-                          if (!pbofs)
-                            os_xml << '\n';
                         }
                     }
                 }
@@ -1413,31 +1325,15 @@ void xml_parse_from_stream(istream&    is_xml,
   tag.get_attribute_value("nelem", nelem);
   vector.resize(nelem);
 
-  for (Index n = 0; n < nelem; n++)
+  if (pbifs)
     {
-      if (pbifs)
-        {
-          *pbifs >> vector[n];
-          if (pbifs->fail())
-            {
-              ostringstream os;
-              os << " near "
-                 << "\n  Element: " << n;
-              xml_data_parse_error(tag, os.str());
-            }
-        }
-      else
-        {
-          is_xml >> double_imanip() >> vector[n];
-          if (is_xml.fail())
-            {
-              ostringstream os;
-              os << " near "
-                 << "\n  Element: " << n;
-              xml_data_parse_error(tag, os.str());
-            }
-        }
+      pbifs->readDoubleArray(vector.get_c_array(), nelem);
+      if (pbifs->fail())
+        xml_data_parse_error(tag, " while reading binary data");
     }
+  else
+    xml_parse_numeric_array(is_xml, vector.get_c_array(), nelem, tag);
+
 }
 
 
@@ -1495,10 +1391,10 @@ void xml_write_to_stream(ostream&         os_xml,
 
   xml_set_stream_precision(os_xml);
 
-  for (Index i = 0; i < n; ++i)
-    if (pbofs)
-      *pbofs << vector[i];
-    else
+  if (pbofs)
+    pbofs->writeDoubleArray(vector.get_c_array(), n);
+  else
+    for (Index i = 0; i < n; ++i)
       os_xml << vector[i] << '\n';
 
   close_tag.set_name("/Vector");
@@ -41,6 +41,7 @@
 #include "jacobian.h"
 #include "global_data.h"
 #include "cloudbox.h"
+#include "workspace_ng.h"
 
 
 ////////////////////////////////////////////////////////////////////////////
@@ -48,6 +49,335 @@
 ////////////////////////////////////////////////////////////////////////////
 
 
+//=== Agenda ================================================================
+
+//! Reads a keyword value of a method call from XML input stream
+/*!
+  \param is_xml     XML Input stream
+  \param tv         TokVal return value
+  \param pbifs      Pointer to binary input stream. NULL in case of ASCII file.
+*/
+static void xml_read_from_stream(istream& is_xml,
+                                 TokVal& tv,
+                                 bifstream* pbifs,
+                                 const Verbosity& verbosity)
+{
+  ArtsXMLTag tag(verbosity);
+  String type;
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("TokVal");
+  tag.get_attribute_value("type", type);
+
+  if (type == "String")
+    {
+      String v;
+      xml_read_from_stream(is_xml, v, pbifs, verbosity);
+      tv = TokVal(v);
+    }
+  else if (type == "Index")
+    {
+      Index v;
+      xml_read_from_stream(is_xml, v, pbifs, verbosity);
+      tv = TokVal(v);
+    }
+  else if (type == "Numeric")
+    {
+      Numeric v;
+      xml_read_from_stream(is_xml, v, pbifs, verbosity);
+      tv = TokVal(v);
+    }
+  else if (type == "ArrayOfString")
+    {
+      ArrayOfString v;
+      xml_read_from_stream(is_xml, v, pbifs, verbosity);
+      tv = TokVal(v);
+    }
+  else if (type == "ArrayOfIndex")
+    {
+      ArrayOfIndex v;
+      xml_read_from_stream(is_xml, v, pbifs, verbosity);
+      tv = TokVal(v);
+    }
+  else if (type == "Vector")
+    {
+      Vector v;
+      xml_read_from_stream(is_xml, v, pbifs, verbosity);
+      tv = TokVal(v);
+    }
+  else if (type == "Matrix")
+    {
+      Matrix v;
+      xml_read_from_stream(is_xml, v, pbifs, verbosity);
+      tv = TokVal(v);
+    }
+  else if (type == "undefined")
+    {
+      tv = TokVal();
+    }
+  else
+    {
+      xml_parse_error("Unknown keyword value type: " + type);
+    }
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("/TokVal");
+}
+
+
+//! Writes a keyword value of a method call to XML output stream
+/*!
+  \param os_xml     XML Output stream
+  \param tv         TokVal
+  \param pbofs      Pointer to binary file stream. NULL for ASCII output.
+*/
+static void xml_write_to_stream(ostream& os_xml,
+                                const TokVal& tv,
+                                bofstream* pbofs,
+                                const Verbosity& verbosity)
+{
+  ArtsXMLTag open_tag(verbosity);
+  ArtsXMLTag close_tag(verbosity);
+
+  open_tag.set_name("TokVal");
+
+  switch (tv.type())
+    {
+    case String_t:
+      {
+        open_tag.add_attribute("type", "String");
+        open_tag.write_to_stream(os_xml);
+        os_xml << '\n';
+        const String v = tv;
+        xml_write_to_stream(os_xml, v, pbofs, "", verbosity);
+        break;
+      }
+    case Index_t:
+      {
+        open_tag.add_attribute("type", "Index");
+        open_tag.write_to_stream(os_xml);
+        os_xml << '\n';
+        const Index v = tv;
+        xml_write_to_stream(os_xml, v, pbofs, "", verbosity);
+        break;
+      }
+    case Numeric_t:
+      {
+        open_tag.add_attribute("type", "Numeric");
+        open_tag.write_to_stream(os_xml);
+        os_xml << '\n';
+        const Numeric v = tv;
+        xml_write_to_stream(os_xml, v, pbofs, "", verbosity);
+        break;
+      }
+    case Array_String_t:
+      {
+        open_tag.add_attribute("type", "ArrayOfString");
+        open_tag.write_to_stream(os_xml);
+        os_xml << '\n';
+        const ArrayOfString v = tv;
+        xml_write_to_stream(os_xml, v, pbofs, "", verbosity);
+        break;
+      }
+    case Array_Index_t:
+      {
+        open_tag.add_attribute("type", "ArrayOfIndex");
+        open_tag.write_to_stream(os_xml);
+        os_xml << '\n';
+        const ArrayOfIndex v = tv;
+        xml_write_to_stream(os_xml, v, pbofs, "", verbosity);
+        break;
+      }
+    case Vector_t:
+      {
+        open_tag.add_attribute("type", "Vector");
+        open_tag.write_to_stream(os_xml);
+        os_xml << '\n';
+        const Vector v = tv;
+        xml_write_to_stream(os_xml, v, pbofs, "", verbosity);
+        break;
+      }
+    case Matrix_t:
+      {
+        open_tag.add_attribute("type", "Matrix");
+        open_tag.write_to_stream(os_xml);
+        os_xml << '\n';
+        const Matrix v = tv;
+        xml_write_to_stream(os_xml, v, pbofs, "", verbosity);
+        break;
+      }
+    default:
+      open_tag.add_attribute("type", "undefined");
+      open_tag.write_to_stream(os_xml);
+      os_xml << '\n';
+    }
+
+  close_tag.set_name("/TokVal");
+  close_tag.write_to_stream(os_xml);
+  os_xml << '\n';
+}
+
+
+//! Reads a list of workspace variable names and converts them to indices
+/*!
+  \param is_xml     XML Input stream
+  \param wsvs       WSV indices
+  \param pbifs      Pointer to binary input stream. NULL in case of ASCII file.
+*/
+static void xml_read_wsv_names_from_stream(istream& is_xml,
+                                           ArrayOfIndex& wsvs,
+                                           bifstream* pbifs,
+                                           const Verbosity& verbosity)
+{
+  ArrayOfString names;
+  xml_read_from_stream(is_xml, names, pbifs, verbosity);
+
+  wsvs.resize(names.nelem());
+  for (Index i = 0; i < names.nelem(); i++)
+    {
+      map<String, Index>::const_iterator it = Workspace::WsvMap.find(names[i]);
+      if (it == Workspace::WsvMap.end())
+        xml_parse_error("Unknown workspace variable: " + names[i]);
+      wsvs[i] = it->second;
+    }
+}
+
+
+//! Reads Agenda from XML input stream
+/*!
+  Methods and variables are stored by name and looked up in the current
+  method and workspace variable tables. All variables used by the agenda
+  must therefore exist before the agenda is read.
+
+  The agenda is not checked for consistency, this needs access to the
+  workspace and has to be done by the caller.
+
+  \param is_xml     XML Input stream
+  \param a          Agenda return value
+  \param pbifs      Pointer to binary input stream. NULL in case of ASCII file.
+*/
+void xml_read_from_stream(istream& is_xml,
+                          Agenda& a,
+                          bifstream* pbifs,
+                          const Verbosity& verbosity)
+{
+  using global_data::MdMap;
+
+  ArtsXMLTag tag(verbosity);
+  String name;
+  Index nelem;
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("Agenda");
+  tag.get_attribute_value("name", name);
+  tag.get_attribute_value("nelem", nelem);
+
+  a.resize(0);
+  a.set_name(name);
+  for (Index n = 0; n < nelem; n++)
+    {
+      String method;
+      Index internal;
+      ArrayOfIndex output;
+      ArrayOfIndex input;
+      TokVal setvalue;
+      Agenda tasks;
+
+      tag.read_from_stream(is_xml);
+      tag.check_name("MRecord");
+      tag.get_attribute_value("method", method);
+      tag.get_attribute_value("internal", internal);
+
+      map<String, Index>::const_iterator it = MdMap.find(method);
+      if (it == MdMap.end())
+        xml_parse_error("Unknown workspace method: " + method);
+
+      xml_read_wsv_names_from_stream(is_xml, output, pbifs, verbosity);
+      xml_read_wsv_names_from_stream(is_xml, input, pbifs, verbosity);
+      xml_read_from_stream(is_xml, setvalue, pbifs, verbosity);
+      xml_read_from_stream(is_xml, tasks, pbifs, verbosity);
+
+      tag.read_from_stream(is_xml);
+      tag.check_name("/MRecord");
+
+      a.push_back(MRecord(it->second, output, input, setvalue, tasks,
+                          internal != 0));
+    }
+
+  tag.read_from_stream(is_xml);
+  tag.check_name("/Agenda");
+}
+
+
+//! Writes Agenda to XML output stream
+/*!
+  \param os_xml     XML Output stream
+  \param a          Agenda
+  \param pbofs      Pointer to binary file stream. NULL for ASCII output.
+  \param name       Optional name attribute (unused, the agenda name is
+                    always written)
+*/
+void xml_write_to_stream(ostream& os_xml,
+                         const Agenda& a,
+                         bofstream* pbofs,
+                         const String& /* name */,
+                         const Verbosity& verbosity)
+{
+  using global_data::md_data;
+
+  ArtsXMLTag open_tag(verbosity);
+  ArtsXMLTag close_tag(verbosity);
+
+  open_tag.set_name("Agenda");
+  open_tag.add_attribute("name", a.name());
+  open_tag.add_attribute("nelem", a.nelem());
+  open_tag.write_to_stream(os_xml);
+  os_xml << '\n';
+
+  for (Index n = 0; n < a.nelem(); n++)
+    {
+      const MRecord& mr = a.Methods()[n];
+      const MdRecord& mdd = md_data[mr.Id()];
+
+      // Supergeneric methods are stored under the name of the expanded
+      // method, as in MdMap
+      ostringstream method;
+      method << mdd.Name();
+      if (mdd.Supergeneric())
+        method << "_sg_" << mdd.ActualGroups();
+
+      ArrayOfString output(mr.Out().nelem());
+      for (Index i = 0; i < mr.Out().nelem(); i++)
+        output[i] = Workspace::wsv_data[mr.Out()[i]].Name();
+
+      ArrayOfString input(mr.In().nelem());
+      for (Index i = 0; i < mr.In().nelem(); i++)
+        input[i] = Workspace::wsv_data[mr.In()[i]].Name();
+
+      ArtsXMLTag mr_open_tag(verbosity);
+      mr_open_tag.set_name("MRecord");
+      mr_open_tag.add_attribute("method", method.str());
+      mr_open_tag.add_attribute("internal", Index(mr.isInternal()));
+      mr_open_tag.write_to_stream(os_xml);
+      os_xml << '\n';
+
+      xml_write_to_stream(os_xml, output, pbofs, "output", verbosity);
+      xml_write_to_stream(os_xml, input, pbofs, "input", verbosity);
+      xml_write_to_stream(os_xml, mr.SetValue(), pbofs, verbosity);
+      xml_write_to_stream(os_xml, mr.Tasks(), pbofs, "", verbosity);
+
+      ArtsXMLTag mr_close_tag(verbosity);
+      mr_close_tag.set_name("/MRecord");
+      mr_close_tag.write_to_stream(os_xml);
+      os_xml << '\n';
+    }
+
+  close_tag.set_name("/Agenda");
+  close_tag.write_to_stream(os_xml);
+  os_xml << '\n';
+}
+
+
 //=== CIARecord ================================================
 
 //! Reads CIARecord from XML input stream
@@ -1515,6 +1845,29 @@ void xml_write_to_stream(ostream& os_xml,
 void xml_read_from_stream(istream& is_xml,
                           SingleScatteringData& ssdata,
                           bifstream* pbifs, const Verbosity& verbosity)
+{
+  xml_read_from_stream(is_xml, ssdata, -DBL_MAX, DBL_MAX, pbifs, verbosity);
+}
+
+
+//! Reads SingleScatteringData within a frequency range from XML input stream
+/*!
+  Only the data frequencies needed to interpolate to [fmin, fmax] are
+  read (see SingleScatteringDataFrequencyRange). The other frequencies
+  are skipped while reading, so the complete data are never held in
+  memory.
+
+  \param is_xml  XML Input stream
+  \param ssdata  SingleScatteringData return value
+  \param fmin    Lower limit of frequency range
+  \param fmax    Upper limit of frequency range
+  \param pbifs   Pointer to binary input stream. NULL in case of ASCII file.
+*/
+void xml_read_from_stream(istream& is_xml,
+                          SingleScatteringData& ssdata,
+                          const Numeric fmin,
+                          const Numeric fmax,
+                          bifstream* pbifs, const Verbosity& verbosity)
 {
   ArtsXMLTag tag(verbosity);
   String version;
@@ -1570,15 +1923,40 @@ void xml_read_from_stream(istream& is_xml,
     }
   xml_read_from_stream(is_xml, ssdata.aa_grid, pbifs, verbosity);
 
-  xml_read_from_stream(is_xml, ssdata.pha_mat_data, pbifs, verbosity);
-  if (ssdata.pha_mat_data.nlibraries() != ssdata.f_grid.nelem())
+  const Index nf = ssdata.f_grid.nelem();
+  Index first, extent;
+  SingleScatteringDataFrequencyRange(first, extent, ssdata.f_grid,
+                                     fmin, fmax);
+  if (extent < nf)
+    {
+      Vector f_grid = ssdata.f_grid[Range(first, extent)];
+      ssdata.f_grid = std::move(f_grid);
+    }
+
+  Index nf_data;
+  xml_read_leading_range_from_stream(is_xml, ssdata.pha_mat_data, nf_data,
+                                     first, extent, pbifs, verbosity);
+  if (nf_data != nf)
     {
       throw runtime_error("Number of frequencies in f_grid and pha_mat_data "
                           "not matching!!!");
     }
 
-  xml_read_from_stream(is_xml, ssdata.ext_mat_data, pbifs, verbosity);
-  xml_read_from_stream(is_xml, ssdata.abs_vec_data, pbifs, verbosity);
+  xml_read_leading_range_from_stream(is_xml, ssdata.ext_mat_data, nf_data,
+                                     first, extent, pbifs, verbosity);
+  if (nf_data != nf)
+    {
+      throw runtime_error("Number of frequencies in f_grid and ext_mat_data "
+                          "not matching!!!");
+    }
+
+  xml_read_leading_range_from_stream(is_xml, ssdata.abs_vec_data, nf_data,
+                                     first, extent, pbifs, verbosity);
+  if (nf_data != nf)
+    {
+      throw runtime_error("Number of frequencies in f_grid and abs_vec_data "
+                          "not matching!!!");
+    }
 
   tag.read_from_stream(is_xml);
   tag.check_name("/SingleScatteringData");
@@ -2323,23 +2701,6 @@ void xml_write_to_stream(ostream& os_xml,
 
 // FIXME: These should be implemented, sooner or later...
 
-void xml_read_from_stream(istream&,
-                          Agenda&,
-                          bifstream* /* pbifs */, const Verbosity&)
-{
-  throw runtime_error("Method not implemented!");
-}
-
-
-void xml_write_to_stream(ostream&,
-                         const Agenda&,
-                         bofstream* /* pbofs */,
-                         const String& /* name */, const Verbosity&)
-{
-  throw runtime_error("Method not implemented!");
-}
-
-
 //=== MCAntenna ================================================
 
 void xml_read_from_stream(istream&,
@@ -51,7 +51,7 @@
 //   Functions to open and read XML files
 ////////////////////////////////////////////////////////////////////////////
 
-void xml_open_output_file(ostream& file, const String& name);
+void xml_open_output_file(ofstream& file, const String& name);
 
 void xml_open_input_file(ifstream& file, const String& name, const Verbosity& verbosity);
 
@@ -129,4 +129,10 @@ void xml_set_stream_precision(ostream& os);
 
 void parse_xml_tag_content_as_string(std::istream& is_xml, String& content);
 
+void xml_parse_numeric_array(istream& is_xml, Numeric* data, Index n,
+                             ArtsXMLTag& tag);
+
+void xml_parse_numeric_array(istream& is_xml, Numeric* data, Index n,
+                             Index first, Index count, ArtsXMLTag& tag);
+
 #endif  /* xml_io_private_h */
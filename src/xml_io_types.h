@@ -181,6 +181,15 @@ void xml_parse_from_stream(istream&, Vector&, bifstream*, ArtsXMLTag&, const Ver
 void xml_read_from_stream(istream&, ArrayOfLineRecord&, const Numeric, const Numeric, bifstream*,
                           const Verbosity&);
 
+void xml_read_from_stream(istream&, SingleScatteringData&, const Numeric, const Numeric,
+                          bifstream*, const Verbosity&);
+
+void xml_read_leading_range_from_stream(istream&, Tensor5&, Index&, const Index, const Index,
+                                        bifstream*, const Verbosity&);
+
+void xml_read_leading_range_from_stream(istream&, Tensor7&, Index&, const Index, const Index,
+                                        bifstream*, const Verbosity&);
+
 void xml_parse_from_stream(istream&, ArrayOfString&, bifstream*, ArtsXMLTag&, const Verbosity&);
 
 #endif  /* xml_io_types_h */